@@ -113,6 +113,8 @@ struct ExportSettings {
 
   gboolean color;
   gchar *font; /* UTF-8 */
+
+  gboolean cache_stats;
 };
 
 static struct ExportFormat formats[] =
@@ -145,6 +147,8 @@ static struct ExportSettings settings = {
 
   FALSE,
   NULL,
+
+  FALSE,
 };
 
 #define bad_arg_msg _("ERROR: Bad argument '%s' to %s option.\n")
@@ -160,6 +164,8 @@ cmd_export_impl (void *data, int argc, char **argv)
   struct ExportFormat *exporter = NULL;
   GArray *render_color_map = NULL;
   gchar *original_cwd = g_get_current_dir ();
+  GList *pages = NULL;
+  PAGE *failed_page;
 
   gtk_init_check (&argc, &argv);
   scm_init_guile ();
@@ -226,24 +232,38 @@ cmd_export_impl (void *data, int argc, char **argv)
     exit (1);
   }
 
-  /* Load schematic files */
-  while (optind < argc) {
-    PAGE *page;
-    tmp = argv[optind++];
+  /* Load schematic files.  The files are read at the same time, but
+   * the pages are still created in command-line order. */
+  for (i = 0; i < settings.infilec; i++) {
+    pages = g_list_append (pages,
+                           s_page_new (toplevel, settings.infilev[i]));
+  }
+  if (!f_open_pages (toplevel, pages, F_OPEN_RC | F_OPEN_CHECK_BACKUP,
+                     &failed_page, &err)) {
+    fprintf (stderr,
+             _("ERROR: Failed to load '%s': %s\n"),
+             settings.infilev[g_list_index (pages, failed_page)],
+             err->message);
+    exit (1);
+  }
+  if (g_chdir (original_cwd) != 0) {
+    fprintf (stderr,
+             _("ERROR: Failed to change directory to '%s': %s\n"),
+             original_cwd, g_strerror (errno));
+    exit (1);
+  }
+  g_list_free (pages);
+
+  if (settings.cache_stats) {
+    CLibCacheStats stats;
 
-    page = s_page_new (toplevel, tmp);
-    if (!f_open (toplevel, page, tmp, &err)) {
-      fprintf (stderr,
-               _("ERROR: Failed to load '%s': %s\n"), tmp,
-               err->message);
-      exit (1);
-    }
-    if (g_chdir (original_cwd) != 0) {
-      fprintf (stderr,
-               _("ERROR: Failed to change directory to '%s': %s\n"),
-               original_cwd, g_strerror (errno));
-      exit (1);
-    }
+    s_clib_get_symbol_cache_stats (&stats);
+    fprintf (stderr,
+             _("Symbol cache: %lu hits, %lu misses, %lu evictions, "
+               "%u entries, %lu of %lu bytes\n"),
+             (unsigned long) stats.hits, (unsigned long) stats.misses,
+             (unsigned long) stats.evictions, stats.entries,
+             (unsigned long) stats.size, (unsigned long) stats.budget);
   }
 
   /* Create renderer */
@@ -890,6 +910,7 @@ export_config (void)
 
 static struct option export_long_options[] = {
   {"no-color", 0, NULL, 2},
+  {"cache-stats", 0, NULL, 3},
   {"align", 1, NULL, 'a'},
   {"color", 0, NULL, 'c'},
   {"dpi", 1, NULL, 'd'},
@@ -926,6 +947,7 @@ export_usage (void)
 "  -c, --color            enable color output\n"
 "  --no-color             disable color output\n"
 "  -F, --font=NAME        set font family for printing text\n"
+"  --cache-stats          print symbol cache statistics after loading\n"
 "  -h, --help     display usage information and exit\n"
 "\n"
 "Please report bugs to %s.\n"),
@@ -971,6 +993,10 @@ export_command_line (int argc, char * const *argv)
       settings.color = FALSE;
       break;
 
+    case 3: /* --cache-stats */
+      settings.cache_stats = TRUE;
+      break;
+
     case 'a':
       str = export_command_line__utf8_check (optarg, "-a,--align");
       if (!export_parse_align (str)) {
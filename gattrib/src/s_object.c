@@ -193,8 +193,7 @@ void s_object_replace_attrib_in_object(TOPLEVEL *toplevel,
       if (strcmp(old_attrib_name, new_attrib_name) == 0) {
 	/* create attrib=value text string & stuff it back into toplevel */
 	new_attrib_text = g_strconcat(new_attrib_name, "=", new_attrib_value, NULL);
-	g_free(a_current->text->string);   /* remove old attrib string */
-	a_current->text->string = g_strdup(new_attrib_text);   /* insert new attrib string */
+	o_text_set_string (toplevel, a_current, new_attrib_text);
 	if (visibility != LEAVE_VISIBILITY_ALONE)
 	  o_set_visibility (toplevel, a_current, visibility);
 	if (show_name_value != LEAVE_NAME_VALUE_ALONE)
@@ -123,7 +123,7 @@ void s_sheet_data_add_master_comp_list_items (const GList *obj_list) {
     OBJECT *o_current = iter->data;
 
 #ifdef DEBUG
-      printf("In s_sheet_data_add_master_comp_list_items, examining o_current->name = %s\n", o_current->name);
+      printf("In s_sheet_data_add_master_comp_list_items, examining o_current->sid = %d\n", o_current->sid);
 #endif
 
       /*-----  only process if this is a component with attributes ----*/
@@ -189,7 +189,7 @@ void s_sheet_data_add_master_comp_attrib_list_items (const GList *obj_list) {
     OBJECT *o_current = o_iter->data;
 
 #ifdef DEBUG
-      printf("In s_sheet_data_add_master_comp_attrib_list_items, examining o_current->name = %s\n", o_current->name);
+      printf("In s_sheet_data_add_master_comp_attrib_list_items, examining o_current->sid = %d\n", o_current->sid);
 #endif
 
       /*-----  only process if this is a component with attributes ----*/
@@ -302,7 +302,7 @@ void s_sheet_data_add_master_pin_list_items (const GList *obj_list) {
     OBJECT *o_current = o_iter->data;
 
 #ifdef DEBUG
-    printf ("In s_sheet_data_add_master_pin_list_items, examining o_current->name = %s\n", o_current->name);
+    printf ("In s_sheet_data_add_master_pin_list_items, examining o_current->sid = %d\n", o_current->sid);
 #endif
 
     if (o_current->type == OBJ_COMPLEX) {
@@ -315,7 +315,7 @@ void s_sheet_data_add_master_pin_list_items (const GList *obj_list) {
              o_lower_iter = g_list_next (o_lower_iter)) {
           OBJECT *o_lower_current = o_lower_iter->data;
 #if DEBUG
-          printf ("In s_sheet_data_add_master_pin_list_items, examining object name %s\n", o_lower_current->name);
+          printf ("In s_sheet_data_add_master_pin_list_items, examining object sid %d\n", o_lower_current->sid);
 #endif
           if (o_lower_current->type == OBJ_PIN) {
             temp_pinnumber = o_attrib_search_object_attribs_by_name (o_lower_current, "pinnumber", 0);
@@ -394,7 +394,7 @@ void s_sheet_data_add_master_pin_attrib_list_items (const GList *obj_list) {
     OBJECT *o_current = o_iter->data;
 
 #ifdef DEBUG
-      printf("In s_sheet_data_add_master_pin_attrib_list_items, examining o_current->name = %s\n", o_current->name);
+      printf("In s_sheet_data_add_master_pin_attrib_list_items, examining o_current->sid = %d\n", o_current->sid);
 #endif
 
       if (o_current->type == OBJ_COMPLEX) {
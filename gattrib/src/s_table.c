@@ -296,7 +296,7 @@ void s_table_add_toplevel_comp_items_to_comp_table (const GList *obj_list) {
     OBJECT *o_current = o_iter->data;
 
 #ifdef DEBUG
-      printf("   ---> In s_table_add_toplevel_comp_items_to_comp_table, examining o_current->name = %s\n", o_current->name);
+      printf("   ---> In s_table_add_toplevel_comp_items_to_comp_table, examining o_current->sid = %d\n", o_current->sid);
 #endif
 
     /* -----  Now process objects found on page  ----- */
@@ -502,7 +502,7 @@ void s_table_add_toplevel_pin_items_to_pin_table (const GList *obj_list) {
     OBJECT *o_current = o_iter->data;
 
 #ifdef DEBUG
-      printf("   ---> In s_table_add_toplevel_pin_items_to_pin_table, examining o_current->name = %s\n", o_current->name);
+      printf("   ---> In s_table_add_toplevel_pin_items_to_pin_table, examining o_current->sid = %d\n", o_current->sid);
 #endif
 
     /* -----  Now process objects found on page  ----- */
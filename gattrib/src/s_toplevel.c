@@ -445,8 +445,8 @@ s_toplevel_sheetdata_to_toplevel (TOPLEVEL *toplevel, PAGE *page)
 	g_free(temp_uref);
       } else {
 #ifdef DEBUG
-	printf("In s_toplevel_sheetdata_to_toplevel, found complex with no refdes. name = %s\n", 
-	       o_current->name);
+	printf("In s_toplevel_sheetdata_to_toplevel, found complex with no refdes. sid = %d\n", 
+	       o_current->sid);
 #endif
       }
     }  /* if (o_current->type == OBJ_COMPLEX) */
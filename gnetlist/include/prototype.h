@@ -52,7 +52,7 @@ CPINLIST *s_cpinlist_search_pin(CPINLIST *ptr, char *pin_number);
 /* s_hierarchy.c */
 void s_hierarchy_traverse(TOPLEVEL *pr_current, OBJECT *o_current, NETLIST *netlist);
 void s_hierarchy_post_process(TOPLEVEL *pr_current, NETLIST *head);
-int s_hierarchy_setup_rename(TOPLEVEL *pr_current, NETLIST *head, char *uref, char *label, char *new_name);
+int s_hierarchy_setup_rename(TOPLEVEL *pr_current, NETLIST *head, char *uref, char *label, const char *new_name);
 void s_hierarchy_remove_urefconn(NETLIST *head, char *uref_disable);
 void s_hierarchy_remove_compsite_all(NETLIST *head);
 char *s_hierarchy_create_uref(TOPLEVEL *pr_current, char *basename, char *hierarchy_tag);
@@ -69,20 +69,25 @@ void verbose_reset_index(void);
 NET *s_net_return_tail(NET *head);
 NET *s_net_return_head(NET *tail);
 NET *s_net_add(NET *ptr);
+NET *s_net_copy(NET *ptr, const NET *node);
+void s_net_free(NET *node);
+void s_net_set_name(NET *node, const char *name);
+void s_net_set_connected(NET *node, const char *uref, const char *pin);
+const char *s_net_connected_to(NET *node);
 void s_net_print(NET *ptr);
-char *s_net_return_connected_string(TOPLEVEL *pr_current, OBJECT *object, char *hierarchy_tag);
+void s_net_connect_pin(TOPLEVEL *pr_current, NET *node, OBJECT *object, char *hierarchy_tag);
 int s_net_find(NET *net_head, NET *node);
-char *s_net_name_search(TOPLEVEL *pr_current, NET *net_head);
+const char *s_net_name_search(TOPLEVEL *pr_current, NET *net_head);
 char *s_net_name(TOPLEVEL *pr_current, NETLIST *netlist_head, NET *net_head, char *hierarchy_tag, int type);
 /* s_netattrib.c */
-gchar *s_netattrib_pinnum_get_connected_string (const gchar *pinnum) G_GNUC_WARN_UNUSED_RESULT;
-const gchar *s_netattrib_connected_string_get_pinnum (const gchar *str);
-void s_netattrib_check_connected_string (const gchar *str);
+void s_netattrib_net_set_pinnum (NET *node, const gchar *pinnum);
+const gchar *s_netattrib_net_get_pinnum (const NET *node);
+void s_netattrib_check_uref (const gchar *uref);
 char *s_netattrib_extract_netname(char *value);
 void s_netattrib_create_pins(TOPLEVEL *pr_current, OBJECT *o_current, NETLIST *netlist, char *value, char *hierarchy_tag);
 void s_netattrib_handle(TOPLEVEL *pr_current, OBJECT *o_current, NETLIST *netlist, char *hierarchy_tag);
 char *s_netattrib_net_search(OBJECT *o_current, const gchar *wanted_pin);
-char *s_netattrib_return_netname(TOPLEVEL *pr_current, OBJECT *o_current, char *pinnumber, char *hierarchy_tag);
+char *s_netattrib_return_netname(TOPLEVEL *pr_current, OBJECT *o_current, const gchar *pinnumber, char *hierarchy_tag);
 /* s_netlist.c */
 NETLIST *s_netlist_return_tail(NETLIST *head);
 NETLIST *s_netlist_return_head(NETLIST *tail);
@@ -95,13 +100,18 @@ void s_netlist_name_named_nets (TOPLEVEL *pr_current,
 char *s_netlist_netname_of_netid (TOPLEVEL *pr_current,
 				  NETLIST *netlist_head,
 				  int net_id);
+void s_netlist_index(NETLIST *head);
+GPtrArray *s_netlist_find_packages(const char *uref);
+GPtrArray *s_netlist_find_pins(const char *uref, const char *pin_number);
+GPtrArray *s_netlist_find_connections(const char *net_name);
+GPtrArray *s_netlist_unique_nets(void);
 /* s_rename.c */
 void s_rename_init(void);
 void s_rename_destroy_all(void);
 void s_rename_next_set(void);
 void s_rename_print(void);
-int s_rename_search(char *src, char *dest, int quiet_flag);
-void s_rename_add(char *src, char *dest);
+int s_rename_search(const char *src, const char *dest, int quiet_flag);
+void s_rename_add(const char *src, const char *dest);
 void s_rename_all_lowlevel(NETLIST *netlist_head, char *src, char *dest);
 void s_rename_all(TOPLEVEL *pr_current, NETLIST *netlist_head);
 SCM g_get_renamed_nets(SCM scm_level);
@@ -110,7 +120,7 @@ void s_traverse_init(void);
 void s_traverse_start(TOPLEVEL *pr_current);
 void s_traverse_sheet(TOPLEVEL *pr_current, const GList *obj_list, char *hierarchy_tag);
 CPINLIST *s_traverse_component(TOPLEVEL *pr_current, OBJECT *component, char *hierarchy_tag);
-NET *s_traverse_net(TOPLEVEL *pr_current, NET *nets, int starting, OBJECT *object, char *hierarchy_tag, int type);
+NET *s_traverse_net(TOPLEVEL *pr_current, NET *nets, OBJECT *pin, char *hierarchy_tag, int type);
 /* vams_misc.c */
 SCM vams_get_attribs_list(OBJECT *object);
 SCM vams_get_package_attributes(SCM scm_uref);
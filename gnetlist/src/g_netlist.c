@@ -100,34 +100,29 @@ SCM g_get_pins(SCM scm_uref)
 {
     char *uref;
     SCM list = SCM_EOL;
+    GPtrArray *packages;
     NETLIST *nl_current;
     CPINLIST *pl_current;
+    guint i;
 
     SCM_ASSERT(scm_is_string (scm_uref), scm_uref, SCM_ARG1, "gnetlist:get-pins");
 
     uref = scm_to_utf8_string (scm_uref);
 
-    /* here is where you make it multi page aware */
-    nl_current = netlist_head;
-
-    /* search for the first instance */
-    /* through the entire list */
-    while (nl_current != NULL) {
+    /* all the instances, for slotted parts */
+    packages = s_netlist_find_packages (uref);
 
-	if (nl_current->component_uref) {
-	    if (strcmp(nl_current->component_uref, uref) == 0) {
+    for (i = 0; packages != NULL && i < packages->len; i++) {
+	nl_current = g_ptr_array_index (packages, i);
 
-		pl_current = nl_current->cpins;
-		while (pl_current != NULL) {
-		    if (pl_current->pin_number) {
-              list = scm_cons (scm_from_utf8_string (pl_current->pin_number),
-                               list);
-		    }
-		    pl_current = pl_current->next;
-		}
+	pl_current = nl_current->cpins;
+	while (pl_current != NULL) {
+	    if (pl_current->pin_number) {
+		list = scm_cons (scm_from_utf8_string (pl_current->pin_number),
+				 list);
 	    }
+	    pl_current = pl_current->next;
 	}
-	nl_current = nl_current->next;
     }
 
     free (uref);
@@ -182,40 +177,18 @@ SCM g_get_all_unique_nets(SCM scm_level)
 {
 
     SCM list = SCM_EOL;
-    SCM x = SCM_EOL;
-    NETLIST *nl_current;
-    CPINLIST *pl_current;
-    char *net_name;
+    GPtrArray *nets;
+    guint i;
 
     SCM_ASSERT(scm_is_string (scm_level), scm_level, SCM_ARG1,
 	       "gnetlist:get-all-unique-nets");
 
-    nl_current = netlist_head;
-
-    /* walk through the list of components, and through the list
-     * of individual pins on each, adding net names to the list
-     * being careful to ignore duplicates, and unconnected pins
-     */
-    while (nl_current != NULL) {
-	pl_current = nl_current->cpins;
-	while (pl_current != NULL) {
-	    if (pl_current->net_name) {
+    /* the connected nets, without duplicates, in netlist order */
+    nets = s_netlist_unique_nets ();
 
-		net_name = pl_current->net_name;
-		/* filter off unconnected pins */
-		if (strncmp(net_name, "unconnected_pin", 15) != 0) {
-		    /* add the net name to the list */
-		    /*printf("Got net: `%s'\n",net_name); */
-
-		    x = scm_from_utf8_string (net_name);
-		    if (scm_is_false (scm_member (x, list))) {
-              list = scm_cons (x, list);
-		    }
-		}
-	    }
-	    pl_current = pl_current->next;
-	}
-	nl_current = nl_current->next;
+    for (i = 0; nets != NULL && i < nets->len; i++) {
+	list = scm_cons (scm_from_utf8_string (g_ptr_array_index (nets, i)),
+			 list);
     }
 
     return list;
@@ -225,18 +198,11 @@ SCM g_get_all_unique_nets(SCM scm_level)
 SCM g_get_all_connections(SCM scm_netname)
 {
 
-    SCM list = SCM_EOL;
-    SCM x = SCM_EOL;
-    SCM is_member = SCM_EOL;
     SCM connlist = SCM_EOL;
-    SCM pairlist = SCM_EOL;
-    NETLIST *nl_current;
-    CPINLIST *pl_current;
-    NET *n_current;
+    GPtrArray *connections;
+    NET *connection;
     char *wanted_net_name;
-    char *net_name;
-    char *pin;
-    char *uref;
+    guint i;
 
     SCM_ASSERT(scm_is_string(scm_netname), scm_netname, SCM_ARG1,
 	       "gnetlist:get-all-connections");
@@ -244,67 +210,19 @@ SCM g_get_all_connections(SCM scm_netname)
     wanted_net_name = scm_to_utf8_string (scm_netname);
 
     if (wanted_net_name == NULL) {
-	return list;
+	return connlist;
     }
 
+    /* the unique (uref pin) pairs on the net, in netlist order */
+    connections = s_netlist_find_connections (wanted_net_name);
 
-    nl_current = netlist_head;
+    for (i = 0; connections != NULL && i < connections->len; i++) {
+	connection = g_ptr_array_index (connections, i);
 
-    /* walk through the list of components, and through the list
-     * of individual pins on each, adding net names to the list
-     * being careful to ignore duplicates, and unconnected pins
-     */
-    while (nl_current != NULL) {
-	pl_current = nl_current->cpins;
-	while (pl_current != NULL) {
-	    if (pl_current->net_name) {
-
-		net_name = pl_current->net_name;
-		/* filter off unconnected pins */
-		if (strcmp(net_name, wanted_net_name) == 0) {
-		    /* add the net name to the list */
-
-#if DEBUG
-		    printf("found net: `%s'\n", net_name);
-#endif
-
-		    n_current = pl_current->nets;
-		    while (n_current != NULL) {
-
-			if (n_current->connected_to) {
-
-			    pin = (char *) g_malloc(sizeof(char) *
-						  strlen(n_current->
-							 connected_to));
-			    uref =
-				(char *) g_malloc(sizeof(char) *
-						strlen(n_current->
-						       connected_to));
-
-			    sscanf(n_current->connected_to,
-				   "%s %s", uref, pin);
-
-			    pairlist = scm_list_n (scm_from_utf8_string (uref),
-                                       scm_from_utf8_string (pin),
-                                       SCM_UNDEFINED);
-
-			    x = pairlist;
-			    is_member = scm_member(x, connlist);
-
-			    if (scm_is_false (is_member)) {
-				connlist = scm_cons (pairlist, connlist);
-			    }
-
-			    g_free(uref);
-			    g_free(pin);
-			}
-			n_current = n_current->next;
-		    }
-		}
-	    }
-	    pl_current = pl_current->next;
-	}
-	nl_current = nl_current->next;
+	connlist = scm_cons (scm_list_n (scm_from_utf8_string (connection->connected_uref),
+					 scm_from_utf8_string (connection->connected_pin),
+					 SCM_UNDEFINED),
+			     connlist);
     }
 
     free (wanted_net_name);
@@ -318,16 +236,14 @@ SCM g_get_nets(SCM scm_uref, SCM scm_pin)
   SCM outerlist = SCM_EOL;
   SCM pinslist = SCM_EOL;
   SCM pairlist = SCM_EOL;
-  NETLIST *nl_current = NULL;
+  GPtrArray *pins;
   CPINLIST *pl_current = NULL;
   NET *n_current;
+  guint i;
   char *wanted_uref = NULL;
   char *wanted_pin = NULL;
   char *net_name = NULL;
 
-  char *pin;
-  char *uref;
-
   SCM_ASSERT(scm_is_string (scm_uref), scm_uref, SCM_ARG1,
              "gnetlist:get-nets");
 
@@ -342,53 +258,27 @@ SCM g_get_nets(SCM scm_uref, SCM scm_pin)
   wanted_pin = scm_to_utf8_string (scm_pin);
   scm_dynwind_free (wanted_pin);
 
-  /* search for the first instance */
-  /* through the entire list */
-  for (nl_current = netlist_head;
-       nl_current != NULL;
-       nl_current = nl_current->next) {
-
-    if (!nl_current->component_uref) continue;
-    if (strcmp (nl_current->component_uref, wanted_uref) != 0) continue;
-
-    for (pl_current = nl_current->cpins;
-         pl_current != NULL;
-         pl_current = pl_current->next) {
-
-      if (!pl_current->pin_number) continue;
-      if (strcmp(pl_current->pin_number, wanted_pin) != 0) continue;
-
-      if (pl_current->net_name) {
-        net_name = pl_current->net_name;
-      }
-
-      for (n_current = pl_current->nets;
-           n_current != NULL;
-           n_current = n_current->next) {
+  /* the pin of every instance */
+  pins = s_netlist_find_pins (wanted_uref, wanted_pin);
 
-        if (!n_current->connected_to) continue;
+  for (i = 0; pins != NULL && i < pins->len; i++) {
+    pl_current = g_ptr_array_index (pins, i);
 
-        pin = (char *) g_malloc(sizeof(char) *
-                                strlen
-                                (n_current->
-                                 connected_to));
-        uref =
-          (char *) g_malloc(sizeof(char) *
-                            strlen(n_current->
-                                   connected_to));
+    if (pl_current->net_name) {
+      net_name = pl_current->net_name;
+    }
 
-        sscanf(n_current->connected_to,
-               "%s %s", uref, pin);
+    for (n_current = pl_current->nets;
+         n_current != NULL;
+         n_current = n_current->next) {
 
-        pairlist = scm_list_n (scm_from_utf8_string (uref),
-                               scm_from_utf8_string (pin),
-                               SCM_UNDEFINED);
+      if (!n_current->connected_uref) continue;
 
-        pinslist = scm_cons (pairlist, pinslist);
+      pairlist = scm_list_n (scm_from_utf8_string (n_current->connected_uref),
+                             scm_from_utf8_string (n_current->connected_pin),
+                             SCM_UNDEFINED);
 
-        g_free(uref);
-        g_free(pin);
-      }
+      pinslist = scm_cons (pairlist, pinslist);
     }
   }
 
@@ -414,8 +304,10 @@ SCM g_get_pins_nets(SCM scm_uref)
 {
     SCM pinslist = SCM_EOL;
     SCM pairlist = SCM_EOL;
+    GPtrArray *packages;
     NETLIST *nl_current = NULL;
     CPINLIST *pl_current = NULL;
+    guint i;
 
     char *wanted_uref = NULL;
     char *net_name = NULL;
@@ -427,31 +319,25 @@ SCM g_get_pins_nets(SCM scm_uref)
     wanted_uref = scm_to_utf8_string (scm_uref);
 
     /* search for the any instances */
-    /* through the entire list */
-    for (nl_current = netlist_head; nl_current != NULL;
-	 nl_current = nl_current->next) {
-
-	/* is there a uref? */
-	if (nl_current->component_uref) {
-	    /* is it the one we want ? */
-	    if (strcmp(nl_current->component_uref, wanted_uref) == 0) {
-
-		for (pl_current = nl_current->cpins; pl_current != NULL;
-		     pl_current = pl_current->next) {
-		    /* is there a valid pin number and a valid name ? */
-		    if (pl_current->pin_number) {
-			if (pl_current->net_name) {
-			    /* yes, add it to the list */
-			    pin = pl_current->pin_number;
-			    net_name = pl_current->net_name;
-
-			    pairlist = scm_cons (scm_from_utf8_string (pin),
-                                                 scm_from_utf8_string (net_name));
-			    pinslist = scm_cons (pairlist, pinslist);
-			}
-
-		    }
+    packages = s_netlist_find_packages (wanted_uref);
+
+    for (i = 0; packages != NULL && i < packages->len; i++) {
+	nl_current = g_ptr_array_index (packages, i);
+
+	for (pl_current = nl_current->cpins; pl_current != NULL;
+	     pl_current = pl_current->next) {
+	    /* is there a valid pin number and a valid name ? */
+	    if (pl_current->pin_number) {
+		if (pl_current->net_name) {
+		    /* yes, add it to the list */
+		    pin = pl_current->pin_number;
+		    net_name = pl_current->net_name;
+
+		    pairlist = scm_cons (scm_from_utf8_string (pin),
+                                         scm_from_utf8_string (net_name));
+		    pinslist = scm_cons (pairlist, pinslist);
 		}
+
 	    }
 	}
     }
@@ -484,9 +370,11 @@ SCM g_get_pins_nets(SCM scm_uref)
 SCM g_get_all_package_attributes(SCM scm_uref, SCM scm_wanted_attrib)
 {
     SCM ret = SCM_EOL;
+    GPtrArray *packages;
     NETLIST *nl_current;
     char *uref;
     char *wanted_attrib;
+    guint i;
 
     SCM_ASSERT(scm_is_string (scm_uref),
 	       scm_uref, SCM_ARG1, "gnetlist:get-all-package-attributes");
@@ -497,24 +385,19 @@ SCM g_get_all_package_attributes(SCM scm_uref, SCM scm_wanted_attrib)
     uref          = scm_to_utf8_string (scm_uref);
     wanted_attrib = scm_to_utf8_string (scm_wanted_attrib);
 
-    /* here is where you make it multi page aware */
-    nl_current = netlist_head;
+    /* search for uref instances */
+    packages = s_netlist_find_packages (uref);
 
-    /* search for uref instances and through the entire list */
-    while (nl_current != NULL) {
+    for (i = 0; packages != NULL && i < packages->len; i++) {
+	char *value;
 
-	if (nl_current->component_uref) {
-	    if (strcmp(nl_current->component_uref, uref) == 0) {
-		char *value =
-		    o_attrib_search_object_attribs_by_name (nl_current->object_ptr,
-		                                            wanted_attrib, 0);
+	nl_current = g_ptr_array_index (packages, i);
+	value = o_attrib_search_object_attribs_by_name (nl_current->object_ptr,
+	                                                wanted_attrib, 0);
 
-		ret = scm_cons (value ? scm_from_utf8_string (value) : SCM_BOOL_F, ret);
+	ret = scm_cons (value ? scm_from_utf8_string (value) : SCM_BOOL_F, ret);
 
-		g_free (value);
-	    }
-	}
-	nl_current = nl_current->next;
+	g_free (value);
     }
 
     free (uref);
@@ -529,7 +412,9 @@ SCM g_get_attribute_by_pinseq(SCM scm_uref, SCM scm_pinseq,
                               SCM scm_wanted_attrib)
 {
   SCM scm_return_value;
+  GPtrArray *packages;
   NETLIST *nl_current;
+  guint i;
   char *uref;
   char *pinseq;
   char *wanted_attrib;
@@ -564,33 +449,26 @@ SCM g_get_attribute_by_pinseq(SCM scm_uref, SCM scm_pinseq,
   printf("  wanted_attrib = %s\n", wanted_attrib);
 #endif
 
-  /* here is where you make it multi page aware */
-  nl_current = netlist_head;
-
   /* search for the first instance */
-  /* through the entire list */
-  while (nl_current != NULL) {
-
-    if (nl_current->component_uref) {
-      if (strcmp(nl_current->component_uref, uref) == 0) {
-
-        o_pin_object = o_complex_find_pin_by_attribute (nl_current->object_ptr,
-                                                        "pinseq", pinseq);
-
-        if (o_pin_object) {
-          return_value =
-            o_attrib_search_object_attribs_by_name (o_pin_object,
-                                                    wanted_attrib, 0);
-          if (return_value) {
-            break;
-          }
-        }
+  packages = s_netlist_find_packages (uref);
 
-        /* Don't break until we search the whole netlist to handle slotted */
-        /* parts.   4.28.2007 -- SDB. */
+  for (i = 0; packages != NULL && i < packages->len; i++) {
+    nl_current = g_ptr_array_index (packages, i);
+
+    o_pin_object = o_complex_find_pin_by_attribute (nl_current->object_ptr,
+                                                    "pinseq", pinseq);
+
+    if (o_pin_object) {
+      return_value =
+        o_attrib_search_object_attribs_by_name (o_pin_object,
+                                                wanted_attrib, 0);
+      if (return_value) {
+        break;
       }
     }
-    nl_current = nl_current->next;
+
+    /* Don't break until we search the whole netlist to handle slotted */
+    /* parts.   4.28.2007 -- SDB. */
   }
 
   scm_dynwind_end ();
@@ -615,13 +493,14 @@ SCM g_get_attribute_by_pinnumber(SCM scm_uref, SCM scm_pin, SCM
                                scm_wanted_attrib)
 {
     SCM scm_return_value;
+    GPtrArray *packages;
     NETLIST *nl_current;
     OBJECT *pin_object;
+    guint i;
     char *uref;
     char *pin;
     char *wanted_attrib;
     char *return_value = NULL;
-    int done = FALSE;
 
     SCM_ASSERT(scm_is_string (scm_uref),
 	       scm_uref, SCM_ARG1, "gnetlist:get-attribute-by-pinnumber");
@@ -643,48 +522,42 @@ SCM g_get_attribute_by_pinnumber(SCM scm_uref, SCM scm_pin, SCM
     wanted_attrib = scm_to_utf8_string (scm_wanted_attrib);
     scm_dynwind_free (wanted_attrib);
 
-    /* here is where you make it multi page aware */
-    nl_current = netlist_head;
-
     /* search for the first instance */
-    /* through the entire list */
-    while (nl_current != NULL && !done) {
-	if (nl_current->component_uref) {
-	    if (strcmp(nl_current->component_uref, uref) == 0) {
+    packages = s_netlist_find_packages (uref);
+
+    for (i = 0; packages != NULL && i < packages->len; i++) {
+	nl_current = g_ptr_array_index (packages, i);
 
-		pin_object =
-		    o_complex_find_pin_by_attribute (nl_current->object_ptr,
-		                                     "pinnumber", pin);
+	pin_object =
+	    o_complex_find_pin_by_attribute (nl_current->object_ptr,
+	                                     "pinnumber", pin);
 
-		if (pin_object) {
+	if (pin_object) {
 
-		    /* only look for the first occurance of wanted_attrib */
-		    return_value =
-		      o_attrib_search_object_attribs_by_name (pin_object,
-		                                              wanted_attrib, 0);
+	    /* only look for the first occurance of wanted_attrib */
+	    return_value =
+	      o_attrib_search_object_attribs_by_name (pin_object,
+	                                              wanted_attrib, 0);
 #if DEBUG
-		    if (return_value) {
-			printf("GOT IT: %s\n", return_value);
-		    }
+	    if (return_value) {
+		printf("GOT IT: %s\n", return_value);
+	    }
 #endif
-		} else if (strcmp("pintype",
-				  wanted_attrib) == 0) {
-		  if (nl_current->cpins) {
-		    CPINLIST *pinobject =
-		      s_cpinlist_search_pin(nl_current->cpins, pin);
-		    if (pinobject) {
-		      return_value="pwr";
+	} else if (strcmp("pintype",
+			  wanted_attrib) == 0) {
+	  if (nl_current->cpins) {
+	    CPINLIST *pinobject =
+	      s_cpinlist_search_pin(nl_current->cpins, pin);
+	    if (pinobject) {
+	      return_value="pwr";
 #if DEBUG
 
-		      printf("Supplied pintype 'pwr' for artificial pin '%s' of '%s'\n",
-			     pin, uref);
+	      printf("Supplied pintype 'pwr' for artificial pin '%s' of '%s'\n",
+		     pin, uref);
 #endif
-		    }
-		  }
-		}
 	    }
+	  }
 	}
-	nl_current = nl_current->next;
     }
 
     scm_dynwind_end ();
@@ -140,6 +140,9 @@ void main_prog(void *closure, int argc, char *argv[])
     char *cwd;
     gchar *str;
     gchar *filename;
+    GList *pages = NULL;
+    PAGE *failed_page;
+    GError *err = NULL;
 
     TOPLEVEL *pr_current;
 
@@ -208,8 +211,6 @@ void main_prog(void *closure, int argc, char *argv[])
 
     i = argv_index;
     while (argv[i] != NULL) {
-      GError *err = NULL;
-
       if (g_path_is_absolute(argv[i])) {
         /* Path is already absolute so no need to do any concat of cwd */
         filename = g_strdup (argv[i]);
@@ -223,14 +224,7 @@ void main_prog(void *closure, int argc, char *argv[])
       }
 
       s_page_goto (pr_current, s_page_new (pr_current, filename));
-
-      if (!f_open (pr_current, pr_current->page_current, filename, &err)) {
-        g_warning ("%s\n", err->message);
-        fprintf (stderr, _("ERROR: Failed to load '%s': %s\n"),
-                 filename, err->message);
-        g_error_free (err);
-	exit(2);
-      }
+      pages = g_list_append (pages, pr_current->page_current);
 
       /* collect input filenames for backend use */
       input_files = g_slist_append(input_files, argv[i]);
@@ -239,6 +233,17 @@ void main_prog(void *closure, int argc, char *argv[])
       g_free (filename);
     }
 
+    /* Read all the schematics at once */
+    if (!f_open_pages (pr_current, pages, F_OPEN_RC | F_OPEN_CHECK_BACKUP,
+                       &failed_page, &err)) {
+      g_warning ("%s\n", err->message);
+      fprintf (stderr, _("ERROR: Failed to load '%s': %s\n"),
+               failed_page->page_filename, err->message);
+      g_error_free (err);
+      exit(2);
+    }
+    g_list_free (pages);
+
     /* Change back to the directory where we started.  This is done */
     /* since gnetlist is a command line utility and will deposit its output */
     /* in the current directory.  Having the output go to a different */
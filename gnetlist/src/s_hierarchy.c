@@ -183,7 +183,7 @@ void s_hierarchy_post_process(TOPLEVEL * pr_current, NETLIST * head)
 {
     NETLIST *nl_current;
     CPINLIST *pl_current;
-    char *source_net_name = NULL;
+    const char *source_net_name = NULL;
     int did_work = FALSE;
 
     s_rename_next_set();
@@ -253,7 +253,7 @@ void s_hierarchy_post_process(TOPLEVEL * pr_current, NETLIST * head)
 
 int
 s_hierarchy_setup_rename(TOPLEVEL * pr_current, NETLIST * head, char *uref,
-			 char *label, char *new_name)
+			 char *label, const char *new_name)
 {
     NETLIST *nl_current;
     CPINLIST *pl_current;
@@ -307,7 +307,6 @@ void s_hierarchy_remove_urefconn(NETLIST * head, char *uref_disable)
     NETLIST *nl_current;
     CPINLIST *pl_current;
     NET *n_current;
-    char uref[80], pin[10];
 
     nl_current = head;
     while (nl_current != NULL) {
@@ -315,19 +314,17 @@ void s_hierarchy_remove_urefconn(NETLIST * head, char *uref_disable)
 	while (pl_current != NULL) {
 	    n_current = pl_current->nets;
 	    while (n_current != NULL) {
-		if (n_current->connected_to != NULL) {
-		    sscanf(n_current->connected_to, "%s %s", uref, pin);
+		if (n_current->connected_uref != NULL) {
 #if DEBUG
-		    printf("	looking at : %s %s\n", uref, pin);
+		    printf("	looking at : %s %s\n",
+			   n_current->connected_uref, n_current->connected_pin);
 #endif
-		    if (strcmp(uref_disable, uref) == 0) {
+		    if (strcmp(uref_disable, n_current->connected_uref) == 0) {
 #if DEBUG
 			printf("conn disabling %s\n",
-			       n_current->connected_to);
+			       s_net_connected_to(n_current));
 #endif
-			/* can't do frees, since some names are links */
-/* 		g_free(n_current->connected_to);*/
-			n_current->connected_to = NULL;
+			s_net_set_connected(n_current, NULL, NULL);
 		    }
 		}
 		n_current = n_current->next;
@@ -546,9 +543,7 @@ s_hierarchy_remove_uref_mangling(TOPLEVEL * pr_current, NETLIST * head)
     NETLIST *nl_current;
     CPINLIST *pl_current;
     NET *n_current;
-    char uref[80], pin[10];
     char *new_uref = NULL;
-    char *new_connected_to = NULL;
 
     nl_current = head;
     while (nl_current != NULL) {
@@ -568,14 +563,14 @@ s_hierarchy_remove_uref_mangling(TOPLEVEL * pr_current, NETLIST * head)
 	    n_current = pl_current->nets;
 	    while (n_current != NULL) {
 
-		if (n_current->connected_to) {
+		if (n_current->connected_uref) {
 		    verbose_print("U");
-		    sscanf(n_current->connected_to, "%s %s", uref, pin);
 		    new_uref =
-			s_hierarchy_return_baseuref(pr_current, uref);
-		    new_connected_to = g_strdup_printf("%s %s", new_uref, pin);
-		    g_free(n_current->connected_to);
-		    n_current->connected_to = new_connected_to;
+			s_hierarchy_return_baseuref(pr_current,
+						    (char *) n_current->connected_uref);
+		    s_net_set_connected(n_current, new_uref,
+					n_current->connected_pin);
+		    g_free(new_uref);
 		}
 		n_current = n_current->next;
 	    }
@@ -89,6 +89,8 @@ NET *s_net_add(NET * ptr)
     new_node->pin_label = NULL;
     new_node->net_name_has_priority = FALSE;
     new_node->nid = 0;
+    new_node->connected_uref = NULL;
+    new_node->connected_pin = NULL;
     new_node->connected_to = NULL;
 
     /* Setup link list stuff */
@@ -104,6 +106,66 @@ NET *s_net_add(NET * ptr)
     }
 }
 
+/* add a copy of node after ptr */
+NET *s_net_copy(NET * ptr, const NET * node)
+{
+    NET *new_node = s_net_add(ptr);
+
+    new_node->nid = node->nid;
+    new_node->net_name_has_priority = node->net_name_has_priority;
+    new_node->net_name = node->net_name;
+    new_node->pin_label = node->pin_label;
+    new_node->connected_uref = node->connected_uref;
+    new_node->connected_pin = node->connected_pin;
+
+    return new_node;
+}
+
+/* free a node which isn't linked to any other */
+void s_net_free(NET * node)
+{
+    g_free(node->connected_to);
+    g_free(node);
+}
+
+/* set the name of the node, or clear it if name is NULL */
+void s_net_set_name(NET * node, const char *name)
+{
+    node->net_name = (name != NULL) ? g_intern_string(name) : NULL;
+}
+
+/* set the pin the node is, or clear it if uref is NULL */
+void s_net_set_connected(NET * node, const char *uref, const char *pin)
+{
+    if (uref != NULL && pin != NULL) {
+	node->connected_uref = g_intern_string(uref);
+	node->connected_pin = g_intern_string(pin);
+    } else {
+	node->connected_uref = NULL;
+	node->connected_pin = NULL;
+    }
+
+    /* the string form is made again when needed */
+    g_free(node->connected_to);
+    node->connected_to = NULL;
+}
+
+/* returns the pin the node is as a "uref pin" string, or NULL if it
+ * isn't a pin.  The string belongs to the node. */
+const char *s_net_connected_to(NET * node)
+{
+    if (node->connected_uref == NULL) {
+	return NULL;
+    }
+
+    if (node->connected_to == NULL) {
+	node->connected_to = g_strdup_printf("%s %s", node->connected_uref,
+					     node->connected_pin);
+    }
+
+    return node->connected_to;
+}
+
 void s_net_print(NET * ptr)
 {
     NET *n_current = NULL;
@@ -124,8 +186,9 @@ void s_net_print(NET * ptr)
 	    }
 #endif
 
-	    if (n_current->connected_to) {
-		printf("		%s [%d]\n", n_current->connected_to, n_current->nid);
+	    if (n_current->connected_uref) {
+		printf("		%s [%d]\n", s_net_connected_to(n_current),
+		       n_current->nid);
 	    }
 	}
 
@@ -135,15 +198,14 @@ void s_net_print(NET * ptr)
 
 
 /* object being a pin */
-char *s_net_return_connected_string(TOPLEVEL * pr_current, OBJECT * object,
-				    char *hierarchy_tag)
+void s_net_connect_pin(TOPLEVEL * pr_current, NET * node, OBJECT * object,
+		       char *hierarchy_tag)
 {
     OBJECT *o_current;
     char *pinnum = NULL;
     char *uref = NULL;
     SCM scm_uref;
     char *temp_uref = NULL;
-    char *string;
     char *misc;
 
     o_current = object;
@@ -164,21 +226,21 @@ char *s_net_return_connected_string(TOPLEVEL * pr_current, OBJECT * object,
     uref = s_hierarchy_create_uref(pr_current, temp_uref, hierarchy_tag);
 
     if (uref && pinnum) {
-	string = g_strdup_printf("%s %s", uref, pinnum);
-        s_netattrib_check_connected_string (string);
+        s_netattrib_check_uref (uref);
+	s_net_set_connected(node, uref, pinnum);
 
     } else {
 	if (pinnum) {
-          string = s_netattrib_pinnum_get_connected_string (pinnum);
+          s_netattrib_net_set_pinnum (node, pinnum);
 	} else {
 	    if (hierarchy_tag) {
 		misc =
 		    s_hierarchy_create_uref(pr_current, "U?",
 					    hierarchy_tag);
-		string = g_strdup_printf("%s ?", misc);
+		s_net_set_connected(node, misc, "?");
 		g_free(misc);
 	    } else {
-		string = g_strdup("U? ?");
+		s_net_set_connected(node, "U?", "?");
 	    }
 
 	    fprintf(stderr, _("Missing Attributes (refdes and pin number)\n"));
@@ -190,8 +252,6 @@ char *s_net_return_connected_string(TOPLEVEL * pr_current, OBJECT * object,
     g_free(uref);
 
     g_free(temp_uref);
-
-    return (string);
 }
 
 int s_net_find(NET * net_head, NET * node)
@@ -209,10 +269,10 @@ int s_net_find(NET * net_head, NET * node)
     return (FALSE);
 }
 
-char *s_net_name_search(TOPLEVEL * pr_current, NET * net_head)
+const char *s_net_name_search(TOPLEVEL * pr_current, NET * net_head)
 {
     NET *n_current;
-    char *name = NULL;
+    const char *name = NULL;
     EdaConfig *cfg;
     gint net_naming_priority;
     gchar *str;
@@ -357,7 +417,7 @@ char *s_net_name (TOPLEVEL * pr_current, NETLIST * netlist_head,
     NET *n_start;
     NETLIST *nl_current;
     CPINLIST *pl_current;
-    char *net_name = NULL;
+    const char *net_name = NULL;
     int found = 0;
     char *temp;
     int *unnamed_counter;
@@ -367,7 +427,7 @@ char *s_net_name (TOPLEVEL * pr_current, NETLIST * netlist_head,
     net_name = s_net_name_search(pr_current, net_head);
 
     if (net_name) {
-	return (net_name);
+	return (g_strdup(net_name));
     }
 
 #if DEBUG
@@ -392,7 +452,7 @@ char *s_net_name (TOPLEVEL * pr_current, NETLIST * netlist_head,
 			    net_name =
 				s_net_name_search(pr_current, n_start);
 			    if (net_name) {
-				return (net_name);
+				return (g_strdup(net_name));
 			    }
 
 			}
@@ -38,38 +38,36 @@
 #include "../include/prototype.h"
 #include "../include/gettext.h"
 
-/* Used by the connected string functions */
-#define PIN_NET_PREFIX "__netattrib_power_pin "
+/* The uref of the pins created by net= attributes */
+#define PIN_NET_UREF "__netattrib_power_pin"
 
 /* used by the extract functions below */
 #define DELIMITERS ",; "
 
-gchar *
-s_netattrib_pinnum_get_connected_string (const gchar *pinnum)
+void
+s_netattrib_net_set_pinnum (NET *node, const gchar *pinnum)
 {
-  gchar *str = g_strdup_printf (PIN_NET_PREFIX "%s", pinnum);
-  return str;
+  s_net_set_connected (node, PIN_NET_UREF, pinnum);
 }
 
 const gchar *
-s_netattrib_connected_string_get_pinnum (const gchar *str)
+s_netattrib_net_get_pinnum (const NET *node)
 {
-  int prefix_len = (sizeof PIN_NET_PREFIX) - 1;
-
-  if (strncmp (str, PIN_NET_PREFIX, prefix_len) != 0) {
+  /* the urefs are interned, so comparing the pointers is enough */
+  if (node->connected_uref != g_intern_static_string (PIN_NET_UREF)) {
     return NULL;
   }
 
-  return str + prefix_len;
+  return node->connected_pin;
 }
 
 void
-s_netattrib_check_connected_string (const gchar *str)
+s_netattrib_check_uref (const gchar *uref)
 {
-  if (s_netattrib_connected_string_get_pinnum (str) == NULL) return;
+  if (strcmp (uref, PIN_NET_UREF) != 0) return;
 
   fprintf (stderr,
-           _("ERROR: `%s' is reserved for internal use."), PIN_NET_PREFIX);
+           _("ERROR: `%s' is reserved for internal use."), PIN_NET_UREF);
   exit (1); /*! \bug Use appropriate exit code */
 }
 
@@ -111,11 +109,11 @@ s_netattrib_create_pins(TOPLEVEL * pr_current, OBJECT * o_current,
     CPINLIST *cpinlist_tail = NULL;
     CPINLIST *new_cpin = NULL;
     CPINLIST *old_cpin = NULL;
-    char *connected_to = NULL;
     char *net_name = NULL;
     char *start_of_pinlist = NULL;
     char *char_ptr = NULL;
     char *current_pin = NULL;
+    char *temp;
 
 
     char_ptr = strchr(value, ':');
@@ -127,14 +125,16 @@ s_netattrib_create_pins(TOPLEVEL * pr_current, OBJECT * o_current,
 
     net_name = s_netattrib_extract_netname(value);
 
+    /* the pins are appended to the last component, so find its last
+     * pin once and keep track of it as pins are added */
+    netlist_tail = s_netlist_return_tail(netlist);
+    cpinlist_tail = s_cpinlist_return_tail(netlist_tail->cpins);
+
     /* skip over first : */
     start_of_pinlist = char_ptr + 1;
     current_pin = strtok(start_of_pinlist, DELIMITERS);
     while (current_pin) {
 
-	netlist_tail = s_netlist_return_tail(netlist);
-	cpinlist_tail = s_cpinlist_return_tail(netlist_tail->cpins);
-
 	if (netlist->component_uref) {
 
 	    old_cpin =
@@ -148,24 +148,22 @@ s_netattrib_create_pins(TOPLEVEL * pr_current, OBJECT * o_current,
 		    fprintf(stderr,
 			    _("Found a cpinlist head with a netname! [%s]\n"),
 			    old_cpin->nets->net_name);
-		    g_free(old_cpin->nets->net_name);
 		}
 
 
-		old_cpin->nets->net_name =
-		    s_hierarchy_create_netattrib(pr_current, net_name,
-						 hierarchy_tag);
+		temp = s_hierarchy_create_netattrib(pr_current, net_name,
+						    hierarchy_tag);
+		s_net_set_name(old_cpin->nets, temp);
+		g_free(temp);
 		old_cpin->nets->net_name_has_priority = TRUE;
-		connected_to = g_strdup_printf("%s %s",
-                                   netlist->component_uref,
-                                   current_pin);
-		old_cpin->nets->connected_to = g_strdup(connected_to);
+		s_net_set_connected(old_cpin->nets, netlist->component_uref,
+				    current_pin);
 		old_cpin->nets->nid = o_current->sid;
-		g_free(connected_to);
 	    } else {
 
 
 		new_cpin = s_cpinlist_add(cpinlist_tail);
+		cpinlist_tail = new_cpin;
 
 		new_cpin->pin_number = g_strdup (current_pin);
 		new_cpin->net_name = NULL;
@@ -174,23 +172,21 @@ s_netattrib_create_pins(TOPLEVEL * pr_current, OBJECT * o_current,
 
 		new_cpin->nets = s_net_add(NULL);
 		new_cpin->nets->net_name_has_priority = TRUE;
-		new_cpin->nets->net_name =
-		    s_hierarchy_create_netattrib(pr_current, net_name,
-						 hierarchy_tag);
-
-		connected_to = g_strdup_printf("%s %s",
-                                   netlist->component_uref,
-                                   current_pin);
-		new_cpin->nets->connected_to = g_strdup(connected_to);
+		temp = s_hierarchy_create_netattrib(pr_current, net_name,
+						    hierarchy_tag);
+		s_net_set_name(new_cpin->nets, temp);
+		g_free(temp);
+
+		s_net_set_connected(new_cpin->nets, netlist->component_uref,
+				    current_pin);
 		new_cpin->nets->nid = o_current->sid;
 
 #if DEBUG
-		printf("Finished creating: %s\n", connected_to);
+		printf("Finished creating: %s\n",
+		       s_net_connected_to(new_cpin->nets));
 		printf("netname: %s %s\n", new_cpin->nets->net_name,
 		       hierarchy_tag);
 #endif
-
-		g_free(connected_to);
 	    }
 
 	} else {		/* no uref, means this is a special component */
@@ -250,7 +246,7 @@ char *s_netattrib_net_search (OBJECT * o_current, const gchar *wanted_pin)
   int counter;
 
   if (o_current == NULL ||
-      o_current->complex == NULL)
+      (o_current->type != OBJ_COMPLEX && o_current->type != OBJ_PLACEHOLDER))
     return NULL;
 
   /* for now just look inside the component */
@@ -320,18 +316,16 @@ char *s_netattrib_net_search (OBJECT * o_current, const gchar *wanted_pin)
 }
 
 char *s_netattrib_return_netname(TOPLEVEL * pr_current, OBJECT * o_current,
-				 char *pinnumber, char *hierarchy_tag)
+				 const gchar *pinnumber, char *hierarchy_tag)
 {
-    const gchar *current_pin;
     char *netname;
     char *temp_netname;
 
-    current_pin = s_netattrib_connected_string_get_pinnum (pinnumber);
-    if (current_pin == NULL) return NULL;
+    if (pinnumber == NULL) return NULL;
 
     /* use hierarchy tag here to make this net uniq */
     temp_netname = s_netattrib_net_search(o_current->parent,
-                                          current_pin);
+                                          pinnumber);
 
     netname =
 	s_hierarchy_create_netattrib(pr_current, temp_netname,
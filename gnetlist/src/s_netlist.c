@@ -176,8 +176,8 @@ void s_netlist_post_process(TOPLEVEL * pr_current, NETLIST * head)
 			   node of the nets linked list */
 			if (pl_current->net_name && pl_current->nets) {
 			    if (pl_current->nets->next) {
-				pl_current->nets->next->net_name =
-				    g_strdup (pl_current->net_name);
+				s_net_set_name(pl_current->nets->next,
+					       pl_current->net_name);
 			    }
 			}
 		    }
@@ -220,7 +220,8 @@ void s_netlist_name_named_nets (TOPLEVEL *pr_current,
   NETLIST *nl_current;
   CPINLIST *pl_current;
   NET *n_current;
-  char *net_name;
+  const char *net_name;
+  char *temp;
 
   if (verbose_mode) {
     printf("\n- Staring post processing\n");
@@ -244,10 +245,11 @@ void s_netlist_name_named_nets (TOPLEVEL *pr_current,
 	  net_name = NULL;
 	  n_current = pl_current->nets;
 	  while (n_current != NULL) {
-	    g_free (n_current->net_name);
-	    n_current->net_name = s_netlist_netname_of_netid(pr_current,
-							     named_netlist,
-							     n_current->nid);
+	    temp = s_netlist_netname_of_netid(pr_current,
+					      named_netlist,
+					      n_current->nid);
+	    s_net_set_name (n_current, temp);
+	    g_free (temp);
 
 	    if (n_current->net_name != NULL) {
 	      net_name = n_current->net_name;
@@ -299,3 +301,220 @@ char *s_netlist_netname_of_netid (TOPLEVEL *pr_current,
     }
   return NULL;
 }
+
+/* The packages of the netlist with a given refdes */
+typedef struct {
+  GPtrArray *packages;	/* the NETLIST entries, in netlist order */
+  GHashTable *pins;	/* pin number -> GPtrArray of their CPINLISTs */
+} PackageIndex;
+
+/* refdes -> PackageIndex, built by s_netlist_index() */
+static GHashTable *package_index = NULL;
+
+/* The pins connected to a net */
+typedef struct {
+  GPtrArray *nodes;	/* a NET node for each pin, in netlist order */
+  GHashTable *seen;	/* the same nodes, to leave out duplicates */
+} NetConnections;
+
+/* net name -> NetConnections */
+static GHashTable *connection_index = NULL;
+
+/* The names of the connected nets, in netlist order */
+static GPtrArray *unique_nets = NULL;
+
+static void s_netlist_free_package_index (gpointer data)
+{
+  PackageIndex *index = data;
+
+  g_ptr_array_free (index->packages, TRUE);
+  g_hash_table_destroy (index->pins);
+  g_free (index);
+}
+
+static void s_netlist_free_pin_index (gpointer data)
+{
+  g_ptr_array_free ((GPtrArray *) data, TRUE);
+}
+
+static void s_netlist_free_connections (gpointer data)
+{
+  NetConnections *connections = data;
+
+  g_ptr_array_free (connections->nodes, TRUE);
+  g_hash_table_destroy (connections->seen);
+  g_free (connections);
+}
+
+/* The refdes and pin of a node are interned, so the pointers identify
+ * the pin */
+static guint s_netlist_connection_hash (gconstpointer key)
+{
+  const NET *node = key;
+
+  return g_direct_hash (node->connected_uref) * 31 +
+    g_direct_hash (node->connected_pin);
+}
+
+static gboolean s_netlist_connection_equal (gconstpointer a, gconstpointer b)
+{
+  const NET *node_a = a;
+  const NET *node_b = b;
+
+  return (node_a->connected_uref == node_b->connected_uref &&
+          node_a->connected_pin == node_b->connected_pin);
+}
+
+/* Adds the pins connected to a pin to the net it is on, leaving out
+ * the ones the net already has. */
+static void s_netlist_index_connections (CPINLIST *pin)
+{
+  NetConnections *connections;
+  NET *n_current;
+
+  connections = g_hash_table_lookup (connection_index, pin->net_name);
+
+  if (connections == NULL) {
+    connections = g_new0 (NetConnections, 1);
+    connections->nodes = g_ptr_array_new ();
+    connections->seen = g_hash_table_new (s_netlist_connection_hash,
+                                          s_netlist_connection_equal);
+    g_hash_table_insert (connection_index, pin->net_name, connections);
+
+    /* filter off unconnected pins */
+    if (strncmp (pin->net_name, "unconnected_pin", 15) != 0) {
+      g_ptr_array_add (unique_nets, pin->net_name);
+    }
+  }
+
+  for (n_current = pin->nets; n_current != NULL; n_current = n_current->next) {
+    if (n_current->connected_uref == NULL)
+      continue;
+
+    if (g_hash_table_lookup (connections->seen, n_current) != NULL)
+      continue;
+
+    g_hash_table_insert (connections->seen, n_current, n_current);
+    g_ptr_array_add (connections->nodes, n_current);
+  }
+}
+
+/* Index the packages and pins of the netlist by refdes and pin
+ * number, so that the Scheme accessors don't walk the whole netlist
+ * for every package and pin they are asked about.  Must be called
+ * again whenever refdes or pin numbers change. */
+void s_netlist_index (NETLIST *head)
+{
+  NETLIST *nl_current;
+  CPINLIST *pl_current;
+
+  if (package_index != NULL) {
+    g_hash_table_destroy (package_index);
+    g_hash_table_destroy (connection_index);
+    g_ptr_array_free (unique_nets, TRUE);
+  }
+
+  package_index = g_hash_table_new_full (g_str_hash, g_str_equal, NULL,
+                                         s_netlist_free_package_index);
+  connection_index = g_hash_table_new_full (g_str_hash, g_str_equal, NULL,
+                                            s_netlist_free_connections);
+  unique_nets = g_ptr_array_new ();
+
+  for (nl_current = head; nl_current != NULL; nl_current = nl_current->next) {
+    for (pl_current = nl_current->cpins; pl_current != NULL;
+         pl_current = pl_current->next) {
+      if (pl_current->net_name != NULL) {
+        s_netlist_index_connections (pl_current);
+      }
+    }
+  }
+
+  for (nl_current = head; nl_current != NULL; nl_current = nl_current->next) {
+    PackageIndex *index;
+
+    if (nl_current->component_uref == NULL)
+      continue;
+
+    index = g_hash_table_lookup (package_index, nl_current->component_uref);
+
+    if (index == NULL) {
+      index = g_new0 (PackageIndex, 1);
+      index->packages = g_ptr_array_new ();
+      index->pins = g_hash_table_new_full (g_str_hash, g_str_equal, NULL,
+                                           s_netlist_free_pin_index);
+      g_hash_table_insert (package_index, nl_current->component_uref, index);
+    }
+
+    g_ptr_array_add (index->packages, nl_current);
+
+    for (pl_current = nl_current->cpins; pl_current != NULL;
+         pl_current = pl_current->next) {
+      GPtrArray *pins;
+
+      if (pl_current->pin_number == NULL)
+        continue;
+
+      pins = g_hash_table_lookup (index->pins, pl_current->pin_number);
+
+      if (pins == NULL) {
+        pins = g_ptr_array_new ();
+        g_hash_table_insert (index->pins, pl_current->pin_number, pins);
+      }
+
+      g_ptr_array_add (pins, pl_current);
+    }
+  }
+}
+
+/* Returns the NETLIST entries with the given refdes, in netlist
+ * order, or NULL if there are none or the netlist hasn't been
+ * indexed yet.  The array belongs to the index. */
+GPtrArray *s_netlist_find_packages (const char *uref)
+{
+  PackageIndex *index;
+
+  if (package_index == NULL)
+    return NULL;
+
+  index = g_hash_table_lookup (package_index, uref);
+
+  return (index != NULL) ? index->packages : NULL;
+}
+
+/* Returns the CPINLIST entries of the packages with the given refdes
+ * and pin number, in netlist order, or NULL if there are none.  The
+ * array belongs to the index. */
+GPtrArray *s_netlist_find_pins (const char *uref, const char *pin_number)
+{
+  PackageIndex *index;
+
+  if (package_index == NULL)
+    return NULL;
+
+  index = g_hash_table_lookup (package_index, uref);
+
+  return (index != NULL) ? g_hash_table_lookup (index->pins, pin_number) : NULL;
+}
+
+/* Returns a NET node for each pin connected to the named net, without
+ * duplicates and in netlist order, or NULL if there is no such net.
+ * The array belongs to the index. */
+GPtrArray *s_netlist_find_connections (const char *net_name)
+{
+  NetConnections *connections;
+
+  if (connection_index == NULL)
+    return NULL;
+
+  connections = g_hash_table_lookup (connection_index, net_name);
+
+  return (connections != NULL) ? connections->nodes : NULL;
+}
+
+/* Returns the names of the nets that have a pin connected, without
+ * duplicates and in netlist order, or NULL if the netlist hasn't been
+ * indexed yet.  The array belongs to the index. */
+GPtrArray *s_netlist_unique_nets (void)
+{
+  return unique_nets;
+}
@@ -126,7 +126,7 @@ void s_rename_print(void)
 /* if the src is found, return true */
 /* if the dest is found, also return true, but warn user */
 /* If quiet_flag is true than don't print anything */
-int s_rename_search(char *src, char *dest, int quiet_flag)
+int s_rename_search(const char *src, const char *dest, int quiet_flag)
 {
     RENAME * temp;
 
@@ -192,7 +192,7 @@ static void s_rename_add_lowlevel (const char *src, const char *dest)
     }
 }
 
-void s_rename_add(char *src, char *dest)
+void s_rename_add(const char *src, const char *dest)
 {
     int flag;
     RENAME * last;
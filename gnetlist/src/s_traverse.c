@@ -32,58 +32,30 @@
 #include "../include/prototype.h"
 #include "../include/gettext.h"
 
-/*! Tracks which OBJECTs have been visited so far, and how many times.
+/*! The NET nodes of the pins and nets of the sheet being traversed.
  *
- * The keys of the table are the OBJECT pointers, and the visit count
- * is stored directly in the value pointers.
+ * The keys of the table are the OBJECT pointers, and the values the
+ * NET nodes describing them.  Each node is made the first time its
+ * object is reached, so the attributes and refdes of an object are
+ * looked up once, however many pins its net connects.  Every pin
+ * gets copies of these nodes, which share their strings.
  */
-static GHashTable *visit_table = NULL;
+static GHashTable *sheet_nodes = NULL;
 
-/*! Trivial function used when clearing #visit_table. */
-static gboolean
-returns_true (gpointer key, gpointer value, gpointer user_data)
-{
-  return TRUE;
-}
-
-/*! Retrieve the current visit count for a particular OBJECT. */
-static inline gint
-is_visited(OBJECT *obj)
-{
-  gpointer val;
-  gpointer orig_key;
-  gboolean exist = g_hash_table_lookup_extended (visit_table,
-                                                 obj,
-                                                 &orig_key,
-                                                 &val);
-  return exist ? GPOINTER_TO_INT(val) : 0;
-}
-
-/*! Increment the current visit count for a particular OBJECT. */
-static inline gint
-visit(OBJECT *obj)
-{
-  gpointer val = GINT_TO_POINTER(is_visited (obj) + 1);
-  g_hash_table_replace (visit_table, obj, val);
-  return GPOINTER_TO_INT (val);
-}
-
-/*! Reset all visit counts. Simply clears the hashtable completely. */
-static inline void
-s_traverse_clear_all_visited (const GList *obj_list)
-{
-  g_hash_table_foreach_remove (visit_table,
-                               (GHRFunc) returns_true,
-                               NULL);
-}
+/* The last components of the netlists, which s_traverse_sheet()
+ * appends to, so that it doesn't have to look for them every time */
+static NETLIST *netlist_tail = NULL;
+static NETLIST *graphical_netlist_tail = NULL;
 
 void s_traverse_init(void)
 {
     netlist_head = s_netlist_add(NULL);
     netlist_head->nlid = -1;	/* head node */
+    netlist_tail = netlist_head;
 
     graphical_netlist_head = s_netlist_add(NULL);
     graphical_netlist_head->nlid = -1;	/* head node */
+    graphical_netlist_tail = graphical_netlist_head;
 
     if (verbose_mode) {
 	printf
@@ -104,11 +76,6 @@ void s_traverse_init(void)
 	    ("------------------------------------------------------\n\n");
 
     }
-
-    /* Initialise the hashtable which contains the visit
-       count. N.b. no free functions are required. */
-    visit_table = g_hash_table_new (g_direct_hash,
-                                    g_direct_equal);
 }
 
 void s_traverse_start(TOPLEVEL * pr_current)
@@ -133,6 +100,9 @@ void s_traverse_start(TOPLEVEL * pr_current)
   /* post processing work */
   s_netlist_post_process(pr_current, netlist_head);
 
+  /* refdes and pin numbers are final now */
+  s_netlist_index(netlist_head);
+
   /* Now match the graphical netlist with the net names already assigned */
   s_netlist_name_named_nets(pr_current, netlist_head,
                             graphical_netlist_head);
@@ -155,6 +125,7 @@ s_traverse_sheet (TOPLEVEL * pr_current, const GList *obj_list, char *hierarchy_
   const GList *iter;
   GError *err = NULL;
   EdaConfig *cfg;
+  GHashTable *parent_nodes = sheet_nodes;
 
   cfg = eda_config_get_context_for_file (NULL);
   is_hierarchy = eda_config_get_boolean (cfg, "gnetlist", "traverse-hierarchy", &err);
@@ -167,11 +138,14 @@ s_traverse_sheet (TOPLEVEL * pr_current, const GList *obj_list, char *hierarchy_
     printf("- Starting internal netlist creation\n");
   }
 
+  /* Underlying schematics are traversed from within the loop below,
+   * each with nodes of its own */
+  sheet_nodes = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+                                       NULL, (GDestroyNotify) s_net_free);
+
   for (iter = obj_list; iter != NULL; iter = g_list_next (iter)) {
     OBJECT *o_current = iter->data;
 
-    netlist = s_netlist_return_tail(netlist_head);
-
     if (o_current->type == OBJ_PLACEHOLDER) {
       printf(_("WARNING: Found a placeholder/missing component, are you missing a symbol file? [%s]\n"), o_current->complex_basename);
     }
@@ -190,14 +164,15 @@ s_traverse_sheet (TOPLEVEL * pr_current, const GList *obj_list, char *hierarchy_
       if (g_strcmp0 (temp, "1") == 0) {
         /* traverse graphical elements, but adding them to the
 	   graphical netlist */
-
-	netlist = s_netlist_return_tail(graphical_netlist_head);
 	is_graphical = TRUE;
-
-
       }
       g_free (temp);
-      netlist = s_netlist_add(netlist);
+
+      if (is_graphical) {
+	netlist = graphical_netlist_tail = s_netlist_add(graphical_netlist_tail);
+      } else {
+	netlist = netlist_tail = s_netlist_add(netlist_tail);
+      }
       netlist->nlid = o_current->sid;
 
       scm_uref = g_scm_c_get_uref(pr_current, o_current);
@@ -263,6 +238,9 @@ s_traverse_sheet (TOPLEVEL * pr_current, const GList *obj_list, char *hierarchy_
     }
   }
 
+  g_hash_table_destroy (sheet_nodes);
+  sheet_nodes = parent_nodes;
+
   verbose_done();
 }
 
@@ -306,9 +284,8 @@ CPINLIST *s_traverse_component(TOPLEVEL * pr_current, OBJECT * component,
 
     /* This avoids us adding an unnamed net for an unconnected pin */
     if (o_current->conn_list != NULL) {
-      s_traverse_net (pr_current, nets, TRUE,
-		      o_current, hierarchy_tag, cpins->type);
-      s_traverse_clear_all_visited (s_page_objects (pr_current->page_current));
+      s_traverse_net (pr_current, nets, o_current, hierarchy_tag,
+                      cpins->type);
     }
 
     cpins->nets = nets_head;
@@ -333,21 +310,26 @@ static int connection_type (OBJECT *object)
 }
 
 
-NET *s_traverse_net (TOPLEVEL *pr_current, NET *nets, int starting,
-                     OBJECT *object, char *hierarchy_tag, int type)
+/*! \brief Describe an object of a net.
+ *  \par Function Description
+ *  Creates the NET node for a pin or a net, holding its name if it
+ *  is a net with a netname= attribute, or the refdes and number of
+ *  the pin if it is a pin.
+ *
+ *  \param [in] pr_current     The TOPLEVEL.
+ *  \param [in] object         The pin or net.
+ *  \param [in] hierarchy_tag  The hierarchy tag of the sheet.
+ *  \return A new NET node, not linked to any other.
+ */
+static NET *s_traverse_net_node (TOPLEVEL *pr_current, OBJECT *object,
+                                 char *hierarchy_tag)
 {
   NET *new_net;
-  CONN *c_current;
-  GList *cl_current;
   char *temp = NULL;
+  char *name;
   const gchar *netattrib_pinnum = NULL;
 
-  visit (object);
-
-  if (connection_type (object) != type)
-    return nets;
-
-  new_net = nets = s_net_add(nets);
+  new_net = s_net_add(NULL);
   new_net->nid = object->sid;
 
   /* pins are not allowed to have the netname attribute attached to them */
@@ -357,88 +339,148 @@ NET *s_traverse_net (TOPLEVEL *pr_current, NET *nets, int starting,
       temp = o_attrib_search_object_attribs_by_name (object, "netname", 0);
 
     if (temp) {
-      new_net->net_name =
-        s_hierarchy_create_netname(pr_current, temp,
-                                   hierarchy_tag);
+      name = s_hierarchy_create_netname(pr_current, temp, hierarchy_tag);
+      s_net_set_name (new_net, name);
+      g_free(name);
       g_free(temp);
     } else if (object->type == OBJ_NET) {
       /* search for the old label= attribute on nets */
       temp = o_attrib_search_object_attribs_by_name (object, "label", 0);
       if (temp) {
         printf(_("WARNING: Found label=%s. label= is deprecated, please use netname=\n"), temp);
-        new_net->net_name =
-          s_hierarchy_create_netname(pr_current, temp,
-                                     hierarchy_tag);
+        name = s_hierarchy_create_netname(pr_current, temp, hierarchy_tag);
+        s_net_set_name (new_net, name);
+        g_free(name);
         g_free(temp);
       }
     }
   }
 #if DEBUG
-  printf("inside traverse: %s\n", object->name);
+  printf("inside traverse: %c.%d\n", object->type, object->sid);
 #endif
 
   if (object->type == OBJ_PIN) {
 
-    verbose_print (starting ? "p" : "P");
-
-    new_net->connected_to =
-      s_net_return_connected_string (pr_current, object, hierarchy_tag);
+    s_net_connect_pin (pr_current, new_net, object, hierarchy_tag);
 
     temp = o_attrib_search_object_attribs_by_name (object, "pinlabel", 0);
 
     if (temp) {
-      new_net->pin_label = temp;
+      new_net->pin_label = g_intern_string (temp);
+      g_free (temp);
     }
 
     /* net= new */
-    netattrib_pinnum = s_netattrib_connected_string_get_pinnum (nets->connected_to);
-    if (netattrib_pinnum != NULL && type == PIN_TYPE_NET) {
+    netattrib_pinnum = s_netattrib_net_get_pinnum (new_net);
+    if (netattrib_pinnum != NULL && object->pin_type == PIN_TYPE_NET) {
 
 #if DEBUG
-      printf("going to find netname %s \n", nets->connected_to);
+      printf("going to find netname %s \n", s_net_connected_to (new_net));
 #endif
-      nets->net_name =
-        s_netattrib_return_netname (pr_current, object,
-                                    nets->connected_to,
-                                    hierarchy_tag);
-      nets->net_name_has_priority = TRUE;
-      g_free(nets->connected_to);
-      nets->connected_to = NULL;
+      name = s_netattrib_return_netname (pr_current, object,
+                                         netattrib_pinnum,
+                                         hierarchy_tag);
+      s_net_set_name (new_net, name);
+      g_free (name);
+      new_net->net_name_has_priority = TRUE;
+      s_net_set_connected (new_net, NULL, NULL);
     }
 #if DEBUG
-    printf("traverse connected_to: %s\n", new_net->connected_to);
+    printf("traverse connected_to: %s\n", s_net_connected_to (new_net));
 #endif
+  }
+
+  return new_net;
+}
+
+
+/*! \brief Add the objects of a net reached from an object.
+ *  \par Function Description
+ *  Appends the NET node of \a object to \a nets, then walks its
+ *  connections depth first, skipping the objects already in
+ *  \a visited and those whose type isn't \a type.  Pins other than
+ *  the one the walk started from end it.
+ *
+ *  \return The last node of \a nets.
+ */
+static NET *s_traverse_net_walk (TOPLEVEL *pr_current, NET *nets,
+                                 GHashTable *visited, int starting,
+                                 OBJECT *object, char *hierarchy_tag,
+                                 int type)
+{
+  NET *node;
+  CONN *c_current;
+  GList *cl_current;
+
+  g_hash_table_insert (visited, object, object);
+
+  if (connection_type (object) != type)
+    return nets;
+
+  node = g_hash_table_lookup (sheet_nodes, object);
+  if (node == NULL) {
+    node = s_traverse_net_node (pr_current, object, hierarchy_tag);
+    g_hash_table_insert (sheet_nodes, object, node);
+  }
+
+  nets = s_net_copy (nets, node);
+
+  if (object->type == OBJ_PIN) {
+
+    verbose_print (starting ? "p" : "P");
 
     /* Terminate if we hit a pin which isn't the one we started with */
     if (!starting)
       return nets;
   }
 
-  /*printf("Found net %s\n", object->name); */
   verbose_print("n");
 
-  /* this is not perfect yet and won't detect a loop... */
-  if (is_visited(object) > 100) {
-    fprintf(stderr, _("Found a possible net/pin infinite connection\n"));
-    exit(-1);
-  }
-
   cl_current = object->conn_list;
   while (cl_current != NULL) {
 
     c_current = (CONN *) cl_current->data;
 
-    if (c_current->other_object != NULL) {
-
-      if (!is_visited(c_current->other_object) &&
-          c_current->other_object != object) {
-        nets = s_traverse_net (pr_current, nets, FALSE,
-                               c_current->other_object, hierarchy_tag, type);
-      }
-
+    if (c_current->other_object != NULL &&
+        c_current->other_object != object &&
+        g_hash_table_lookup (visited, c_current->other_object) == NULL) {
+      nets = s_traverse_net_walk (pr_current, nets, visited, FALSE,
+                                  c_current->other_object, hierarchy_tag,
+                                  type);
     }
     cl_current = g_list_next(cl_current);
   }
 
-  return (nets);
+  return nets;
+}
+
+
+/*! \brief Find all the objects of a net.
+ *  \par Function Description
+ *  Appends to \a nets the NET nodes of \a pin and of every pin and
+ *  net of type \a type connected to it, in the order a depth first
+ *  walk from \a pin finds them.  The nodes are copies of those kept
+ *  for the sheet, so the objects of a net are described only once,
+ *  but each pin still gets its own list, in its own order, as the
+ *  backends expect.
+ *
+ *  \param [in] pr_current     The TOPLEVEL.
+ *  \param [in] nets           The list to append to.
+ *  \param [in] pin            The pin to start from.
+ *  \param [in] hierarchy_tag  The hierarchy tag of the sheet.
+ *  \param [in] type           The type of the net, PIN_TYPE_NET or
+ *                             PIN_TYPE_BUS.
+ *  \return The last node of \a nets.
+ */
+NET *s_traverse_net (TOPLEVEL *pr_current, NET *nets, OBJECT *pin,
+                     char *hierarchy_tag, int type)
+{
+  GHashTable *visited = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+  nets = s_traverse_net_walk (pr_current, nets, visited, TRUE, pin,
+                              hierarchy_tag, type);
+
+  g_hash_table_destroy (visited);
+
+  return nets;
 }
@@ -48,7 +48,7 @@ vams_get_attribs_list (OBJECT *object)
   a_iter = o_current->attribs;
   while(a_iter != NULL) {
     a_current = a_iter->data;
-    if (a_current->text && a_current->text->string) {
+    if (a_current->type == OBJ_TEXT && a_current->text->string) {
       val = o_attrib_get_name_value (a_current, &found_name, NULL);
 
       if (val) {
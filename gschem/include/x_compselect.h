@@ -69,6 +69,8 @@ struct _Compselect {
   GtkEntry    *entry_filter;
   GtkButton   *button_clear;
   guint        filter_timeout;
+  gchar       *filter_text;
+  GHashTable  *filter_matches;
   GtkComboBox *combobox_behaviors;
 
   gboolean hidden;
@@ -145,9 +145,8 @@ gboolean o_find_object (GschemToplevel *w_current, int w_x, int w_y,
      position point. You can change the selected object by clicking
      at the same place multiple times. */
   if (toplevel->page_current->object_lastplace != NULL) {
-    /* NB: g_list_find doesn't declare its input const, so we cast */
-    iter = g_list_find ((GList *)s_page_objects (toplevel->page_current),
-                        toplevel->page_current->object_lastplace);
+    iter = s_page_object_link (toplevel->page_current,
+                               toplevel->page_current->object_lastplace);
     iter = g_list_next (iter);
   }
 
@@ -285,7 +285,7 @@ void o_edit_show_hidden_lowlevel (GschemToplevel *w_current,
 
     if (o_current->type == OBJ_COMPLEX || o_current->type == OBJ_PLACEHOLDER) {
       o_edit_show_hidden_lowlevel(w_current, o_current->complex->prim_objs);
-      o_current->w_bounds_valid_for = NULL;
+      geda_object_invalidate_bounds (o_current);
     }
 
     iter = g_list_next (iter);
@@ -209,7 +209,7 @@ void o_move_end(GschemToplevel *w_current)
 
         o_move_end_lowlevel_glist (w_current, object->complex->prim_objs,
                                    diff_x, diff_y);
-        object->w_bounds_valid_for = NULL;
+        geda_object_invalidate_bounds (object);
         break;
 
       default:
@@ -598,8 +598,8 @@ void o_move_check_endpoint(GschemToplevel *w_current, OBJECT * object)
     whichone = o_move_return_whichone (other, c_current->x, c_current->y);
 
 #if DEBUG
-    printf ("FOUND: %s type: %d, whichone: %d, x,y: %d %d\n",
-            other->name, c_current->type,
+    printf ("FOUND: %c.%d type: %d, whichone: %d, x,y: %d %d\n",
+            other->type, other->sid, c_current->type,
             whichone, c_current->x, c_current->y);
 
     printf("other x,y: %d %d\n", c_current->x, c_current->y);
@@ -726,7 +726,7 @@ void o_move_end_rubberband (GschemToplevel *w_current,
         continue;
       }
 
-      object->w_bounds_valid_for = NULL;
+      geda_object_invalidate_bounds (object);
       s_conn_update_object (page, object);
       *objects = g_list_append (*objects, object);
     }
@@ -872,7 +872,7 @@ int o_net_add_busrippers(GschemToplevel *w_current, OBJECT *net_obj,
           }
 
           net_obj->line->y[found_conn->whichone] -= ripper_size;
-          net_obj->w_bounds_valid_for = NULL;
+          geda_object_invalidate_bounds (net_obj);
           rippers[ripper_count].x[0] =
             net_obj->line->x[found_conn->whichone];
           rippers[ripper_count].y[0] =
@@ -909,7 +909,7 @@ int o_net_add_busrippers(GschemToplevel *w_current, OBJECT *net_obj,
           }
 
           net_obj->line->y[found_conn->whichone] += ripper_size;
-          net_obj->w_bounds_valid_for = NULL;
+          geda_object_invalidate_bounds (net_obj);
           rippers[ripper_count].x[0] =
             net_obj->line->x[found_conn->whichone];
           rippers[ripper_count].y[0] =
@@ -980,7 +980,7 @@ int o_net_add_busrippers(GschemToplevel *w_current, OBJECT *net_obj,
           }
 
           net_obj->line->x[found_conn->whichone] -= ripper_size;
-          net_obj->w_bounds_valid_for = NULL;
+          geda_object_invalidate_bounds (net_obj);
           rippers[ripper_count].x[0] =
             net_obj->line->x[found_conn->whichone];
           rippers[ripper_count].y[0] =
@@ -1016,7 +1016,7 @@ int o_net_add_busrippers(GschemToplevel *w_current, OBJECT *net_obj,
           }
 
           net_obj->line->x[found_conn->whichone] += ripper_size;
-          net_obj->w_bounds_valid_for = NULL;
+          geda_object_invalidate_bounds (net_obj);
           rippers[ripper_count].x[0] =
             net_obj->line->x[found_conn->whichone];
           rippers[ripper_count].y[0] =
@@ -318,6 +318,90 @@ static gboolean is_symbol(GtkTreeModel *tree_model, GtkTreeIter *iter)
   return result;
 }
 
+/*! \brief Forgets the symbols matching the filter text.
+ *  \par Function Description
+ *  Discards the set of symbols computed by
+ *  compselect_filter_matches(), so that it is computed again the next
+ *  time it is needed.  Must be called when the library changes.
+ *
+ *  \param [in] compselect The component selection dialog.
+ */
+static void
+compselect_clear_filter_matches (Compselect *compselect)
+{
+  if (compselect->filter_matches != NULL) {
+    g_hash_table_destroy (compselect->filter_matches);
+    compselect->filter_matches = NULL;
+  }
+  g_free (compselect->filter_text);
+  compselect->filter_text = NULL;
+}
+
+/*! \brief Gets the symbols matching the filter text.
+ *  \par Function Description
+ *  Returns the set of symbols whose names contain \a text, ignoring
+ *  case.  \a text may contain the wildcards '*' and '?'.  The library
+ *  is only searched when \a text differs from the text of the
+ *  previous call, rather than for every row of the tree.
+ *
+ *  \param [in] compselect The component selection dialog.
+ *  \param [in] text       The filter text.
+ *  \returns A hash table with the matching symbols as keys.
+ */
+static GHashTable*
+compselect_filter_matches (Compselect *compselect, const gchar *text)
+{
+  GList *sources, *symbols, *iter, *iter2;
+  GPatternSpec *pattern;
+  gchar *text_upper, *name_upper, *tmp;
+
+  if (compselect->filter_matches != NULL &&
+      strcmp (compselect->filter_text, text) == 0) {
+    return compselect->filter_matches;
+  }
+
+  compselect_clear_filter_matches (compselect);
+
+  compselect->filter_text = g_strdup (text);
+  compselect->filter_matches = g_hash_table_new (g_direct_hash,
+                                                 g_direct_equal);
+
+  if (strpbrk (text, "*?") == NULL) {
+    symbols = s_clib_search (text, CLIB_SUBSTRING);
+    for (iter = symbols; iter != NULL; iter = g_list_next (iter)) {
+      g_hash_table_insert (compselect->filter_matches, iter->data, iter->data);
+    }
+    g_list_free (symbols);
+    return compselect->filter_matches;
+  }
+
+  /* Do a case insensitive comparison, converting the strings
+     to uppercase */
+  text_upper = g_ascii_strup (text, -1);
+  tmp = g_strconcat ("*", text_upper, "*", NULL);
+  pattern = g_pattern_spec_new (tmp);
+  g_free (tmp);
+  g_free (text_upper);
+
+  sources = s_clib_get_sources (FALSE);
+  for (iter = sources; iter != NULL; iter = g_list_next (iter)) {
+    symbols = s_clib_source_get_symbols ((CLibSource*) iter->data);
+    for (iter2 = symbols; iter2 != NULL; iter2 = g_list_next (iter2)) {
+      name_upper = g_ascii_strup (s_clib_symbol_get_name (iter2->data), -1);
+      if (g_pattern_match_string (pattern, name_upper)) {
+        g_hash_table_insert (compselect->filter_matches,
+                             iter2->data, iter2->data);
+      }
+      g_free (name_upper);
+    }
+    g_list_free (symbols);
+  }
+  g_list_free (sources);
+  g_pattern_spec_free (pattern);
+
+  return compselect->filter_matches;
+}
+
 /*! \brief Determines visibility of items of the library treeview.
  *  \par Function Description
  *  This is the function used to filter entries of the component
@@ -335,8 +419,6 @@ lib_model_filter_visible_func (GtkTreeModel *model,
 {
   Compselect *compselect = (Compselect*)data;
   CLibSymbol *sym;
-  const gchar *compname;
-  gchar *compname_upper, *text_upper, *pattern;
   const gchar *text;
   gboolean ret;
 
@@ -364,16 +446,9 @@ lib_model_filter_visible_func (GtkTreeModel *model,
     gtk_tree_model_get (model, iter,
                         0, &sym,
                         -1);
-    compname = s_clib_symbol_get_name (sym);
-    /* Do a case insensitive comparison, converting the strings
-       to uppercase */
-    compname_upper = g_ascii_strup (compname, -1);
-    text_upper = g_ascii_strup (text, -1);
-    pattern = g_strconcat ("*", text_upper, "*", NULL);
-    ret = g_pattern_match_simple (pattern, compname_upper);
-    g_free (compname_upper);
-    g_free (text_upper);
-    g_free (pattern);
+    /* Do a case insensitive substring search */
+    ret = (g_hash_table_lookup (compselect_filter_matches (compselect, text),
+                                sym) != NULL);
   }
 
   return ret;
@@ -884,6 +959,7 @@ compselect_callback_refresh_library (GtkButton *button, gpointer user_data)
 
   /* Rescan the libraries for symbols */
   s_clib_refresh ();
+  compselect_clear_filter_matches (compselect);
 
   /* Refresh the "Library" view */
   g_object_unref (gtk_tree_view_get_model (compselect->libtreeview));
@@ -1555,6 +1631,8 @@ compselect_finalize (GObject *object)
     compselect->filter_timeout = 0;
   }
 
+  compselect_clear_filter_matches (compselect);
+
   G_OBJECT_CLASS (compselect_parent_class)->finalize (object);
 }
 
@@ -12,3 +12,7 @@ extern int default_promote_invisible;
 extern int default_keep_invisible;
 
 extern int default_make_backup_files;
+
+extern int default_component_library_index;
+extern int default_object_cache;
+extern int default_object_arena;
@@ -114,6 +114,9 @@ geda_arc_object_shortest_distance (TOPLEVEL *toplevel,
 gchar*
 geda_arc_object_to_buffer (const GedaObject *object);
 
+void
+geda_arc_object_append_to_buffer (const GedaObject *object, GString *buffer);
+
 void
 geda_arc_object_translate (GedaObject *object, int dx, int dy);
 
@@ -89,6 +89,9 @@ geda_box_object_shortest_distance (TOPLEVEL *toplevel,
 gchar*
 geda_box_object_to_buffer (const GedaObject *object);
 
+void
+geda_box_object_append_to_buffer (const GedaObject *object, GString *buffer);
+
 void
 geda_box_object_translate (GedaObject *object, int dx, int dy);
 
@@ -102,6 +102,9 @@ geda_bus_object_set_y1 (GedaObject *object, gint y);
 gchar*
 geda_bus_object_to_buffer (const GedaObject *object);
 
+void
+geda_bus_object_append_to_buffer (const GedaObject *object, GString *buffer);
+
 void
 geda_bus_object_translate (GedaObject *object, gint dx, gint dy);
 
@@ -95,6 +95,9 @@ geda_circle_object_shortest_distance (TOPLEVEL *toplevel,
 gchar*
 geda_circle_object_to_buffer (const GedaObject *object);
 
+void
+geda_circle_object_append_to_buffer (const GedaObject *object, GString *buffer);
+
 void
 geda_circle_object_translate (GedaObject *object, gint dx, gint dy);
 
@@ -69,6 +69,9 @@ o_complex_read(TOPLEVEL *toplevel, const char buf[], unsigned int release_ver, u
 gchar*
 geda_complex_object_to_buffer (const GedaObject *object);
 
+void
+geda_complex_object_append_to_buffer (const GedaObject *object, GString *buffer);
+
 double
 geda_complex_object_shortest_distance (TOPLEVEL *toplevel, OBJECT *object, int x, int y, int force_soild);
 
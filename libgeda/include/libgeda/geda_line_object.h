@@ -105,6 +105,9 @@ geda_line_object_shortest_distance (TOPLEVEL *toplevel,
 gchar*
 geda_line_object_to_buffer (const GedaObject *object);
 
+void
+geda_line_object_append_to_buffer (const GedaObject *object, GString *buffer);
+
 void
 geda_line_object_translate (GedaObject *object, int dx, int dy);
 
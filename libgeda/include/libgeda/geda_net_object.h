@@ -104,6 +104,9 @@ geda_net_object_set_y1 (GedaObject *object, gint y);
 gchar*
 geda_net_object_to_buffer (const GedaObject *object);
 
+void
+geda_net_object_append_to_buffer (const GedaObject *object, GString *buffer);
+
 void
 geda_net_object_translate (GedaObject *object, int dx, int dy);
 
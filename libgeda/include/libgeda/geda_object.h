@@ -24,21 +24,26 @@ struct st_object
 {
   int type;				/* Basic information */
   int sid;
-  char *name;
 
   PAGE *page; /* Parent page */
+  GList *page_link; /* Link in the parent page's object list */
 
   GedaBounds bounds;
   TOPLEVEL *w_bounds_valid_for;
 
-  COMPLEX *complex;
-  GedaLine *line;
-  GedaCircle *circle;
-  GedaArc *arc;
-  BOX *box;
-  TEXT *text;
-  PICTURE *picture;
-  PATH *path;
+  /* The geometry of the object.  Only the member matching the type
+   * is valid: line for lines, nets, pins and buses, complex for
+   * complexes and placeholders, and so on. */
+  union {
+    COMPLEX *complex;
+    GedaLine *line;
+    GedaCircle *circle;
+    GedaArc *arc;
+    BOX *box;
+    TEXT *text;
+    PICTURE *picture;
+    PATH *path;
+  };
 
   GList *conn_list;			/* List of connections */
   /* to and from this object */
@@ -57,29 +62,30 @@ struct st_object
   int fill_angle1, fill_pitch1;
   int fill_angle2, fill_pitch2;
 
-  gboolean complex_embedded;                    /* is embedded component? */
   gchar *complex_basename;              /* Component Library Symbol name */
   OBJECT *parent;                       /* Parent object pointer */
 
+  gboolean complex_embedded;                    /* is embedded component? */
   int color; 				/* Which color */
   int dont_redraw;			/* Flag to skip redrawing */
   int selectable;			/* object selectable flag */
   int selected;				/* object selected flag */
 
-  /* controls which direction bus rippers go */
-  /* it is either 0 for un-inited, */
-  /* 1 for right, -1 for left (horizontal bus) */
-  /* 1 for up, -1 for down (vertial bus) */
-  int bus_ripper_direction;             /* only valid on buses */
-
-
-  int font_text_size;			/* used only with fonts defs */
-  GList *font_prim_objs;			/* used only with fonts defs */
+  union {
+    struct {
+      int whichend;    /* for pins only, either 0 or 1 */
+      int pin_type;    /* for pins only, either NET or BUS */
+    };
 
-  int whichend;    /* for pins only, either 0 or 1 */
-  int pin_type;    /* for pins only, either NET or BUS */
+    /* controls which direction bus rippers go */
+    /* it is either 0 for un-inited, */
+    /* 1 for right, -1 for left (horizontal bus) */
+    /* 1 for up, -1 for down (vertial bus) */
+    int bus_ripper_direction;             /* only valid on buses */
+  };
 
   GList *attribs;       /* attribute stuff */
+  GHashTable *attrib_index; /* attributes by name, built on demand */
   int show_name_value;
   int visibility;
   OBJECT *attached_to;  /* when object is an attribute */
@@ -115,6 +121,9 @@ geda_object_get_color (const GedaObject *object);
 gint
 geda_object_get_drawing_color (const GedaObject *object);
 
+gchar*
+geda_object_get_name (const GedaObject *object);
+
 gboolean
 geda_object_get_position (const GedaObject *object, gint *x, gint *y);
 
@@ -124,6 +133,9 @@ geda_object_get_selectable (const GedaObject *object);
 gint
 geda_object_get_visible (const GedaObject *object);
 
+void
+geda_object_invalidate_bounds (GedaObject *object);
+
 void
 geda_object_rotate (TOPLEVEL *toplevel,
                     int world_centerx,
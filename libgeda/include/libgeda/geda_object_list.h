@@ -41,6 +41,9 @@ geda_object_list_set_selectable (const GList *objects, gboolean selectable);
 gchar*
 geda_object_list_to_buffer (const GList *objects);
 
+gboolean
+geda_object_list_to_stream (const GList *objects, GOutputStream *stream, GError **err);
+
 void
 geda_object_list_translate (const GList *objects, int dx, int dy);
 
@@ -26,10 +26,13 @@ struct st_page
   int pid;
 
   GList *_object_list;
+  GList *_object_list_tail;
+  GedaPageIndex *object_index; /* spatial index of the objects */
   SELECTION *selection_list; /* new selection mechanism */
   GList *place_list;
   OBJECT *object_lastplace; /* the last found item */
   GList *connectible_list;  /* connectible page objects */
+  ConnIndex *conn_index;    /* endpoints of connectible objects */
 
   char *page_filename;
   int CHANGED;			/* changed flag */
@@ -124,6 +127,9 @@ s_page_delete_objects (TOPLEVEL *toplevel, PAGE *page);
 const GList*
 s_page_objects (PAGE *page);
 
+const GList*
+s_page_object_link (PAGE *page, OBJECT *object);
+
 GList*
 s_page_objects_in_region (TOPLEVEL *toplevel, PAGE *page, int min_x, int min_y, int max_x, int max_y);
 
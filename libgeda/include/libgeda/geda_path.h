@@ -61,6 +61,9 @@ s_path_parse (const char *path_str);
 double
 s_path_shortest_distance (PATH *path, int x, int y, int solid);
 
+void
+s_path_append_to_buffer (const PATH *path, GString *buffer);
+
 char*
 s_path_string_from_path (const PATH *path);
 
@@ -54,6 +54,9 @@ o_path_read(TOPLEVEL *toplevel, const char *first_line, TextBuffer *tb, unsigned
 gchar*
 geda_path_object_to_buffer (const GedaObject *object);
 
+void
+geda_path_object_append_to_buffer (const GedaObject *object, GString *buffer);
+
 double
 geda_path_object_shortest_distance (TOPLEVEL *toplevel, OBJECT *object, int x, int y, int force_soild);
 
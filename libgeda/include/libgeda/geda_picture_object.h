@@ -87,6 +87,9 @@ o_picture_read(TOPLEVEL *toplevel, const char *first_line, TextBuffer *tb, unsig
 gchar*
 geda_picture_object_to_buffer (const GedaObject *object);
 
+void
+geda_picture_object_append_to_buffer (const GedaObject *object, GString *buffer);
+
 double
 geda_picture_object_shortest_distance (TOPLEVEL *toplevel, OBJECT *object, int x, int y, int force_soild);
 
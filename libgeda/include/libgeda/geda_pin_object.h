@@ -100,6 +100,9 @@ geda_pin_object_set_y1 (GedaObject *object, gint y);
 gchar*
 geda_pin_object_to_buffer (const GedaObject *object);
 
+void
+geda_pin_object_append_to_buffer (const GedaObject *object, GString *buffer);
+
 void
 geda_pin_object_translate (GedaObject *object, int dx, int dy);
 
@@ -111,6 +111,9 @@ geda_text_object_shortest_distance (TOPLEVEL *toplevel,
 gchar*
 geda_text_object_to_buffer (const GedaObject *object);
 
+void
+geda_text_object_append_to_buffer (const GedaObject *object, GString *buffer);
+
 void
 geda_text_object_translate (GedaObject *object, int dx, int dy);
 
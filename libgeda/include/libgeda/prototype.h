@@ -11,6 +11,8 @@ gboolean f_has_active_autosave (const gchar *filename, GError **err);
 int f_open(TOPLEVEL *toplevel, PAGE *page, const gchar *filename, GError **err);
 int f_open_flags(TOPLEVEL *toplevel, PAGE *page, const gchar *filename,
                  const gint flags, GError **err);
+gboolean f_open_pages (TOPLEVEL *toplevel, GList *pages, const gint flags,
+                       PAGE **failed_page, GError **err);
 void f_close(TOPLEVEL *toplevel);
 int f_save(TOPLEVEL *toplevel, PAGE *page, const char *filename, GError **error);
 gchar *f_normalize_filename (const gchar *filename, GError **error);
@@ -115,6 +117,8 @@ GList *s_clib_search (const gchar *pattern, const CLibSearchMode mode);
 void s_clib_flush_search_cache ();
 void s_clib_flush_symbol_cache ();
 void s_clib_symbol_invalidate_data (const CLibSymbol *symbol);
+void s_clib_set_symbol_cache_size (gsize size);
+void s_clib_get_symbol_cache_stats (CLibCacheStats *stats);
 const CLibSymbol *s_clib_get_symbol_by_name (const gchar *name);
 gchar *s_clib_symbol_get_data_by_name (const gchar *name);
 GList *s_toplevel_get_symbols (const TOPLEVEL *toplevel);
@@ -42,12 +42,29 @@ typedef struct st_chkerrs CHKERRS;
 /* Managed text buffers */
 typedef struct _TextBuffer TextBuffer;
 
+/* Spatial index of the objects on a page */
+typedef struct _GedaPageIndex GedaPageIndex;
+
+/* Index of the endpoints of connectible objects */
+typedef struct _ConnIndex ConnIndex;
+
 /* Component library objects */
 typedef struct _CLibSource CLibSource;
 typedef struct _CLibSymbol CLibSymbol;
 
 /* Component library search modes */
-typedef enum { CLIB_EXACT=0, CLIB_GLOB } CLibSearchMode;
+typedef enum { CLIB_EXACT=0, CLIB_GLOB, CLIB_SUBSTRING } CLibSearchMode;
+
+/* Component library symbol cache statistics.  See documentation for
+   s_clib_get_symbol_cache_stats() in s_clib.c. */
+typedef struct {
+  guint64 hits;
+  guint64 misses;
+  guint64 evictions;
+  guint entries;
+  gsize size;
+  gsize budget;
+} CLibCacheStats;
 
 /* f_open behaviour flags.  See documentation for f_open_flags() in
    f_basic.c. */
@@ -130,10 +147,16 @@ struct st_net {
   int nid;
 
   int net_name_has_priority;
-  char *net_name;
-  char *pin_label;
 
-  char *connected_to; /* new to replace above */
+  /* interned with g_intern_string(), so copies of a node share them */
+  const char *net_name;
+  const char *pin_label;
+
+  /* the pin this node is, as strings interned with g_intern_string() */
+  const char *connected_uref;
+  const char *connected_pin;
+
+  char *connected_to; /* "uref pin", made by s_net_connected_to() */
 
   NET *prev;
   NET *next;
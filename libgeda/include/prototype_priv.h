@@ -1,3 +1,7 @@
+/* a_basic.c */
+int o_read_scan_line (const char *line, const char **end, char *type, int count, ...);
+void o_save_fields (GString *buffer, char type, int count, ...);
+
 /* g_rc.c */
 int vstbl_lookup_str(const vstbl_entry *table, int size, const char *str);
 int vstbl_get_val(const vstbl_entry *table, int index);
@@ -18,12 +22,35 @@ SCM g_rc_promote_invisible(SCM mode);
 SCM g_rc_keep_invisible(SCM mode);
 SCM g_rc_always_promote_attributes(SCM scmsymname);
 SCM g_rc_make_backup_files(SCM mode);
+SCM g_rc_component_library_index(SCM mode);
+SCM g_rc_object_cache(SCM mode);
+SCM g_rc_object_arena(SCM mode);
+SCM g_rc_symbol_cache_size(SCM size);
 SCM g_rc_print_color_map (SCM scm_map);
 
 /* g_register.c */
 void g_register_libgeda_funcs(void);
 void g_register_libgeda_dirs (void);
 
+/* geda_arena.c */
+GedaArena *geda_arena_new (void);
+void geda_arena_unref (GedaArena *arena);
+GedaArena *geda_arena_set_current (GedaArena *arena);
+gpointer geda_arena_alloc0 (gsize size);
+void geda_arena_free (gpointer mem);
+
+/* geda_complex_object.c */
+OBJECT *o_complex_new_by_name(TOPLEVEL *toplevel, char type, int x, int y, int angle, int mirror, const gchar *basename, int selectable);
+
+/* geda_page_index.c */
+GedaPageIndex *geda_page_index_new (TOPLEVEL *toplevel);
+void geda_page_index_free (GedaPageIndex *index);
+void geda_page_index_add (GedaPageIndex *index, OBJECT *object);
+void geda_page_index_remove (GedaPageIndex *index, OBJECT *object);
+void geda_page_index_replace (GedaPageIndex *index, OBJECT *object1, OBJECT *object2);
+void geda_page_index_invalidate (GedaPageIndex *index, OBJECT *object);
+gboolean geda_page_index_query (TOPLEVEL *toplevel, GedaPageIndex *index, BOX *rects, int n_rects, GList **result);
+
 /* m_hatch.c */
 void m_hatch_polygon(GArray *points, gint angle, gint pitch, GArray *lines);
 
@@ -38,14 +65,24 @@ GList *o_read_attribs(TOPLEVEL *toplevel,
                       unsigned int release_ver,
                       unsigned int fileformat_ver, GError **err);
 OBJECT *o_attrib_find_attrib_by_name(const GList *list, char *name, int count);
+void o_attrib_invalidate_index(OBJECT *object);
+void o_attrib_invalidate_owner_index(OBJECT *attrib);
 
 /* o_basic.c */
 void o_bounds_invalidate(TOPLEVEL *toplevel, OBJECT *object);
 void o_emit_pre_change_notify(TOPLEVEL *toplevel, OBJECT *object);
 void o_emit_change_notify(TOPLEVEL *toplevel, OBJECT *object);
+int geda_object_new_sid (void);
+OBJECT *o_object_copy_unmarked (TOPLEVEL *toplevel, OBJECT *selected);
+
+/* o_cache.c */
+GList *o_cache_read_buffer(TOPLEVEL *toplevel, GList *object_list, char *buffer, int size, const char *name, GError **err);
 
 /* s_clib.c */
 void s_clib_init (void);
+CLibPrototype *s_clib_symbol_get_prototype (TOPLEVEL *toplevel, const CLibSymbol *symbol);
+const GList *s_clib_prototype_get_objects (const CLibPrototype *prototype);
+void s_clib_prototype_unref (CLibPrototype *prototype);
 
 /* s_conn.c */
 CONN *s_conn_return_new(OBJECT *other_object, int type, int x, int y, int whichone, int other_whichone);
@@ -55,6 +92,9 @@ OBJECT *s_conn_check_midpoint(OBJECT *o_current, int x, int y);
 void s_conn_print(GList *conn_list);
 void s_conn_add_object(PAGE *page, OBJECT *object);
 void s_conn_remove_object(PAGE *page, OBJECT *object);
+void s_conn_refile_object(PAGE *page, OBJECT *object);
+ConnIndex *s_conn_index_new(void);
+void s_conn_index_free(ConnIndex *index);
 
 /* s_encoding.c */
 gchar* s_encoding_base64_encode (gchar* src, guint srclen, guint* dstlenp, gboolean strict);
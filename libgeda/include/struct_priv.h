@@ -22,4 +22,10 @@
 #ifndef STRUCT_PRIV_H
 #define STRUCT_PRIV_H
 
+/* Memory arena for the objects read from a file */
+typedef struct _GedaArena GedaArena;
+
+/* Parsed objects of a library symbol, shared by its instances */
+typedef struct _CLibPrototype CLibPrototype;
+
 #endif /* !STRUCT_PRIV_H */
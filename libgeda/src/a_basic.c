@@ -25,6 +25,7 @@
 #include <version.h>
 
 #include <stdio.h>
+#include <stdarg.h>
 #ifdef HAVE_STRING_H
 #include <string.h>
 #endif
@@ -33,7 +34,10 @@
 
 /*! \brief Save a file
  *  \par Function Description
- *  This function saves the data in a libgeda format to a file
+ *  This function saves the data in a libgeda format to a file.  The
+ *  objects are written to the file as they are formatted, rather than
+ *  being collected in memory first.  The file is only replaced once
+ *  all of the data has been written successfully.
  *
  *  \bug g_access introduces a race condition in certain cases, but
  *  solves bug #698565 in the normal use-case
@@ -47,7 +51,10 @@
 int o_save (TOPLEVEL *toplevel, const GList *object_list,
             const char *filename, GError **err)
 {
-  char *buffer;
+  GFile *file;
+  GFileOutputStream *stream;
+  GCancellable *cancellable;
+  gboolean result;
 
   /* Check to see if real filename is writable; if file doesn't exists
      we assume all is well */
@@ -58,14 +65,146 @@ int o_save (TOPLEVEL *toplevel, const GList *object_list,
     return 0;
   }
 
-  buffer = geda_object_list_to_buffer (object_list);
-  if (!g_file_set_contents (filename, buffer, strlen(buffer), err)) {
-    g_free (buffer);
+  /* Like g_file_set_contents(), this writes to a temporary file which
+   * replaces the original one when the stream is closed */
+  file = g_file_new_for_path (filename);
+  stream = g_file_replace (file, NULL, FALSE, G_FILE_CREATE_NONE, NULL, err);
+  g_object_unref (file);
+
+  if (stream == NULL) {
     return 0;
   }
-  g_free (buffer);
 
-  return 1;
+  if (geda_object_list_to_stream (object_list, G_OUTPUT_STREAM (stream), err)) {
+    result = g_output_stream_close (G_OUTPUT_STREAM (stream), NULL, err);
+  } else {
+    /* Closing a cancelled stream leaves the original file alone */
+    cancellable = g_cancellable_new ();
+    g_cancellable_cancel (cancellable);
+    g_output_stream_close (G_OUTPUT_STREAM (stream), cancellable, NULL);
+    g_object_unref (cancellable);
+    result = FALSE;
+  }
+
+  g_object_unref (stream);
+
+  return result ? 1 : 0;
+}
+
+/*! \brief Parse the fields of an object line
+ *  \par Function Description
+ *  Parses a line consisting of an object type character followed by
+ *  \a count whitespace separated decimal integers, which are stored
+ *  through the \b int pointers passed after \a count.  This is
+ *  equivalent to sscanf() with a format of "%c %d %d ...", without
+ *  having to interpret a format string for every object read.
+ *
+ *  \param [in]  line   The line to parse.
+ *  \param [out] end    Set to the first character after the last
+ *                      field parsed, or NULL.
+ *  \param [out] type   The object type character.
+ *  \param [in]  count  The number of integers to parse.
+ *  \return The number of fields parsed, including the type, or -1 if
+ *          \a line is empty, as sscanf() would return.
+ */
+int o_read_scan_line (const char *line, const char **end, char *type,
+                      int count, ...)
+{
+  const char *s = line;
+  va_list args;
+  int n = 0;
+  int i;
+
+  if (*s == '\0') return -1;
+
+  *type = *s++;
+  n++;
+
+  va_start (args, count);
+
+  for (i = 0; i < count; i++) {
+    int *value = va_arg (args, int *);
+    const char *digits;
+    gboolean negative = FALSE;
+    gint64 v = 0;
+
+    while (g_ascii_isspace (*s)) s++;
+
+    if (*s == '-' || *s == '+') {
+      negative = (*s == '-');
+      s++;
+    }
+
+    for (digits = s; g_ascii_isdigit (*s); s++) {
+      /* Saturate rather than overflow */
+      if (v <= G_MAXINT) {
+        v = v * 10 + (*s - '0');
+      }
+    }
+
+    if (s == digits) break;
+
+    if (negative) {
+      *value = (int) MAX (-v, (gint64) G_MININT);
+    } else {
+      *value = (int) MIN (v, (gint64) G_MAXINT);
+    }
+    n++;
+  }
+
+  va_end (args);
+
+  if (end != NULL) {
+    *end = s;
+  }
+
+  return n;
+}
+
+/*! \brief Write the fields of an object line
+ *  \par Function Description
+ *  Appends an object type character followed by \a count decimal
+ *  integers, each preceded by a space, to \a buffer.  The integers are
+ *  passed as \b int arguments after \a count.  This is equivalent to
+ *  g_string_append_printf() with a format of "%c %d %d ...", without
+ *  having to interpret a format string or allocate a temporary string
+ *  for every object written.  It is the counterpart of
+ *  o_read_scan_line().
+ *
+ *  \param [in,out] buffer  The buffer to append to.
+ *  \param [in]     type    The object type character.
+ *  \param [in]     count   The number of integers to write.
+ */
+void o_save_fields (GString *buffer, char type, int count, ...)
+{
+  char digits[16];
+  va_list args;
+  int i;
+
+  g_string_append_c (buffer, type);
+
+  va_start (args, count);
+
+  for (i = 0; i < count; i++) {
+    int value = va_arg (args, int);
+    unsigned int magnitude = (value < 0) ? 0u - (unsigned int) value
+                                         : (unsigned int) value;
+    char *s = digits + sizeof (digits);
+
+    do {
+      *--s = '0' + magnitude % 10;
+      magnitude /= 10;
+    } while (magnitude != 0);
+
+    if (value < 0) {
+      *--s = '-';
+    }
+    *--s = ' ';
+
+    g_string_append_len (buffer, s, digits + sizeof (digits) - s);
+  }
+
+  va_end (args);
 }
 
 /*! \brief Read a memory buffer
@@ -122,7 +261,7 @@ GList *o_read_buffer (TOPLEVEL *toplevel, GList *object_list,
     line = s_textbuffer_next_line(tb);
     if (line == NULL) break;
 
-    sscanf(line, "%c", &objtype);
+    objtype = line[0];
 
     /* Do we need to check the symbol version?  Yes, but only if */
     /* 1) the last object read was a complex and */
@@ -367,7 +506,10 @@ GList *o_read_buffer (TOPLEVEL *toplevel, GList *object_list,
 
 /*! \brief Read a file
  *  \par Function Description
- *  This function reads a file in libgeda format.
+ *  This function reads a file in libgeda format.  Regular files are
+ *  mapped into memory and parsed in place, so that their contents
+ *  needn't be copied to the heap first.  Other files, such as pipes,
+ *  are read into a buffer.
  *
  *  \param [in,out] toplevel    The current TOPLEVEL structure.
  *  \param [in]     object_list  The object_list to read data to.
@@ -382,17 +524,38 @@ GList *o_read (TOPLEVEL *toplevel, GList *object_list, char *filename,
   char *buffer = NULL;
   size_t size;
   GList *result;
+  GMappedFile *mapped;
 
   /* Return NULL if error reporting is enabled and the return location
    * for an error isn't NULL. */
   g_return_val_if_fail (err == NULL || *err == NULL, NULL);
 
+  /* Files whose size isn't known, and empty files, which can't be
+   * mapped, are read the usual way */
+  mapped = g_mapped_file_new (filename, FALSE, NULL);
+  if (mapped != NULL) {
+    size = g_mapped_file_get_length (mapped);
+    if (size > 0) {
+      result = o_cache_read_buffer (toplevel, object_list,
+                                    g_mapped_file_get_contents (mapped), size,
+                                    filename, err);
+    }
+#if GLIB_CHECK_VERSION(2,22,0)
+    g_mapped_file_unref (mapped);
+#else
+    g_mapped_file_free (mapped);
+#endif
+    if (size > 0) {
+      return result;
+    }
+  }
+
   if (!g_file_get_contents(filename, &buffer, &size, err)) {
     return NULL;
   }
 
   /* Parse file contents */
-  result = o_read_buffer (toplevel, object_list, buffer, size, filename, err);
+  result = o_cache_read_buffer (toplevel, object_list, buffer, size, filename, err);
   g_free (buffer);
   return result;
 }
@@ -376,6 +376,29 @@ eda_get_user_config_dir(void)
 	return user_config_dir;
 }
 
+const gchar *
+eda_get_user_cache_dir(void)
+{
+	static gchar *user_cache_dir;
+
+	if (g_once_init_enter(&user_cache_dir)) {
+		gchar *dir = get_user_dotdir();
+
+		if (dir) {
+			gchar *cache_dir = g_build_filename(dir, "cache", NULL);
+			g_free(dir);
+			dir = cache_dir;
+		} else {
+			dir = g_build_filename(g_get_user_cache_dir(),
+			                       DATA_XDG_SUBDIR, NULL);
+		}
+
+		g_once_init_leave(&user_cache_dir, dir);
+	}
+
+	return user_cache_dir;
+}
+
 /* ================================================================
  * Module initialisation
  * ================================================================ */
@@ -395,6 +418,7 @@ eda_paths_init(void)
 	eda_get_system_config_dirs();
 	eda_get_user_data_dir();
 	eda_get_user_config_dir();
+	eda_get_user_cache_dir();
 
 	eda_paths_init_env();
 }
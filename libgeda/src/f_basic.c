@@ -165,45 +165,49 @@ int f_open(TOPLEVEL *toplevel, PAGE *page,
                        F_OPEN_RC | F_OPEN_CHECK_BACKUP, err);
 }
 
-/*! \brief Opens the schematic file with fine-grained control over behaviour.
+/*! Maximum number of threads used to read the files of f_open_pages() */
+#define F_OPEN_THREADS 8
+
+/*! The loading of one page, possibly read on a worker thread */
+typedef struct _PageLoad PageLoad;
+struct _PageLoad {
+  /*! The TOPLEVEL the page belongs to */
+  TOPLEVEL *toplevel;
+  /*! The page being loaded */
+  PAGE *page;
+  /*! The file actually read: the schematic or its autosave backup */
+  gchar *filename;
+  /*! The directory of the schematic, which is the working directory
+   *  while it is read */
+  gchar *directory;
+  /*! TRUE if the autosave backup is loaded instead of the schematic */
+  gboolean backup;
+  /*! The objects read from the file */
+  GList *objects;
+  /*! Set if the file could not be read */
+  GError *error;
+};
+
+/*! \brief Find the file of a page.
  *  \par Function Description
- *  Opens the schematic file and carries out a number of actions
- *  depending on the \a flags set.  If #F_OPEN_RC is set, executes RC
- *  files found in the target directory.  If #F_OPEN_CHECK_BACKUP is
- *  set, warns user if a backup is found for the file being loaded,
- *  and possibly prompts user for whether to load the backup instead.
- *  If #F_OPEN_RESTORE_CWD is set, does not change the working
- *  directory to that of the file being loaded.
+ *  Normalizes \a filename into the filename of the page of \a load,
+ *  and sets the file to read and its directory.  This must be done on
+ *  the main thread.
  *
- *  \param [in,out] toplevel  The TOPLEVEL object to load the schematic into.
- *  \param [in]     filename   A character string containing the file name
- *                             to open.
- *  \param [in]     flags      Combination of #FOpenFlags values.
- *  \param [in,out] err  #GError structure for error reporting, or
- *                       NULL to disable error reporting
+ *  Private function used only in f_basic.c.
  *
- *  \return 0 on failure, 1 on success.
+ *  \param [in,out] load      The #PageLoad to fill in.
+ *  \param [in]     filename  The file name to open.
+ *  \param [in,out] err       #GError structure for error reporting.
+ *  \return TRUE if the file was found, FALSE otherwise.
  */
-int f_open_flags(TOPLEVEL *toplevel, PAGE *page,
-                 const gchar *filename,
-                 const gint flags, GError **err)
+static gboolean page_load_locate (PageLoad *load, const gchar *filename,
+                                  GError **err)
 {
-  int opened=FALSE;
+  PAGE *page = load->page;
   char *full_filename = NULL;
-  char *file_directory = NULL;
-  char *saved_cwd = NULL;
-  char *backup_filename = NULL;
-  char load_backup_file = 0;
   GError *tmp_err = NULL;
 
-  /* has the head been freed yet? */
-  /* probably not hack PAGE */
-
-  /* Cache the cwd so we can restore it later. */
-  if (flags & F_OPEN_RESTORE_CWD) {
-    saved_cwd = g_get_current_dir();
-  }
-
   /* get full, absolute path to file */
   full_filename = f_normalize_filename (filename, &tmp_err);
   if (full_filename == NULL) {
@@ -211,17 +215,40 @@ int f_open_flags(TOPLEVEL *toplevel, PAGE *page,
                  _("Cannot find file %s: %s"),
                  filename, tmp_err->message);
     g_error_free(tmp_err);
-    return 0;
+    return FALSE;
   }
 
   /* write full, absolute filename into page->page_filename */
   g_free(page->page_filename);
   page->page_filename = g_strdup(full_filename);
 
+  load->filename = full_filename;
+  load->directory = g_dirname (full_filename);
+  return TRUE;
+}
+
+/*! \brief Prepare to load a page from a file.
+ *  \par Function Description
+ *  Carries out everything f_open_flags() does between finding the file
+ *  with page_load_locate() and reading its objects: changes into the
+ *  directory of the file, executes its RC files if #F_OPEN_RC is set,
+ *  and checks for an autosave backup if #F_OPEN_CHECK_BACKUP is set.
+ *  This must be done on the main thread.
+ *
+ *  Private function used only in f_basic.c.
+ *
+ *  \param [in,out] load   The #PageLoad to prepare.
+ *  \param [in]     flags  Combination of #FOpenFlags values.
+ */
+static void page_load_prepare (PageLoad *load, const gint flags)
+{
+  TOPLEVEL *toplevel = load->toplevel;
+  char *full_filename = load->filename;
+  char *file_directory = load->directory;
+  GError *tmp_err = NULL;
+
   /* Before we open the page, let's load the corresponding gafrc. */
   /* First cd into file's directory. */
-  file_directory = g_dirname (full_filename);
-
   if (file_directory) { 
     if (chdir (file_directory)) {
       /* Error occurred with chdir */
@@ -244,13 +271,13 @@ int f_open_flags(TOPLEVEL *toplevel, PAGE *page,
     }
   }
 
-  g_free (file_directory);
+  load->backup = FALSE;
 
   if (flags & F_OPEN_CHECK_BACKUP) {
     /* Check if there is a newer autosave backup file */
     GString *message;
     gboolean active_backup = f_has_active_autosave (full_filename, &tmp_err);
-    backup_filename = f_get_autosave_filename (full_filename);
+    gchar *backup_filename = f_get_autosave_filename (full_filename);
 
     if (tmp_err != NULL) g_warning ("%s\n", tmp_err->message);
     if (active_backup) {
@@ -270,42 +297,143 @@ int f_open_flags(TOPLEVEL *toplevel, PAGE *page,
         if (toplevel->load_newer_backup_func
             (toplevel->load_newer_backup_data, message)) {
           /* Load the backup file */
-          load_backup_file = 1;
+          load->backup = TRUE;
         }
       }
       g_string_free (message, TRUE);
     }
     if (tmp_err != NULL) g_error_free (tmp_err);
+
+    if (load->backup) {
+      g_free (load->filename);
+      load->filename = backup_filename;
+    } else {
+      g_free (backup_filename);
+    }
   }
+}
 
-  /* Now that we have set the current directory and read
-   * the RC file, it's time to read in the file. */
-  if (load_backup_file == 1) {
-    /* Load the backup file */
-    s_page_append_list (toplevel, page,
-                        o_read (toplevel, NULL, backup_filename, &tmp_err));
-  } else {
-    /* Load the original file */
-    s_page_append_list (toplevel, page,
-                        o_read (toplevel, NULL, full_filename, &tmp_err));
+/*! \brief Read the objects of a page.
+ *  \par Function Description
+ *  Reads the objects of the file chosen by page_load_prepare() into
+ *  \a load.  Only the TOPLEVEL is used, not the page, so this may be
+ *  run on a worker thread.  If the object-arena rc option is enabled,
+ *  the objects are allocated from an arena of their own.
+ *
+ *  Private function used only in f_basic.c.
+ *
+ *  \param [in,out] load  The #PageLoad to read.
+ */
+static void page_load_read (PageLoad *load)
+{
+  GedaArena *arena = NULL;
+  GedaArena *previous = NULL;
+
+  /* Allocate the objects of the page together */
+  if (default_object_arena) {
+    arena = geda_arena_new ();
+    previous = geda_arena_set_current (arena);
   }
 
-  if (tmp_err == NULL)
-    opened = TRUE;
-  else
-    g_propagate_error (err, tmp_err);
+  load->objects = o_read (load->toplevel, NULL, load->filename, &load->error);
 
-  if (load_backup_file == 0) {
+  if (arena != NULL) {
+    geda_arena_set_current (previous);
+    geda_arena_unref (arena);
+  }
+}
+
+/*! \brief Thread pool callback for reading a page.
+ *  \par Function Description
+ *  Private function used only in f_basic.c.
+ */
+static void page_load_worker (gpointer data, gpointer user_data)
+{
+  page_load_read ((PageLoad *) data);
+}
+
+/*! \brief Finish loading a page.
+ *  \par Function Description
+ *  Adds the objects read by page_load_read() to the page and frees
+ *  the contents of \a load.  This must be done on the main thread.
+ *
+ *  Private function used only in f_basic.c.
+ *
+ *  \param [in,out] load  The #PageLoad to finish.
+ *  \param [in,out] err   #GError structure for error reporting.
+ *  \return TRUE if the file was read successfully, FALSE otherwise.
+ */
+static gboolean page_load_finish (PageLoad *load, GError **err)
+{
+  gboolean opened = (load->error == NULL);
+
+  s_page_append_list (load->toplevel, load->page, load->objects);
+  load->objects = NULL;
+
+  if (load->error != NULL) {
+    g_propagate_error (err, load->error);
+    load->error = NULL;
+  }
+
+  if (!load->backup) {
     /* If it's not the backup file */
-    page->CHANGED=0; /* added 4/7/98 */
+    load->page->CHANGED=0; /* added 4/7/98 */
   } else {
     /* We are loading the backup file, so gschem should ask
        the user if save it or not when closing the page. */
-    page->CHANGED=1;
+    load->page->CHANGED=1;
   }
 
-  g_free(full_filename);
-  g_free (backup_filename);
+  g_free (load->filename);
+  load->filename = NULL;
+  g_free (load->directory);
+  load->directory = NULL;
+
+  return opened;
+}
+
+/*! \brief Opens the schematic file with fine-grained control over behaviour.
+ *  \par Function Description
+ *  Opens the schematic file and carries out a number of actions
+ *  depending on the \a flags set.  If #F_OPEN_RC is set, executes RC
+ *  files found in the target directory.  If #F_OPEN_CHECK_BACKUP is
+ *  set, warns user if a backup is found for the file being loaded,
+ *  and possibly prompts user for whether to load the backup instead.
+ *  If #F_OPEN_RESTORE_CWD is set, does not change the working
+ *  directory to that of the file being loaded.
+ *
+ *  \param [in,out] toplevel  The TOPLEVEL object to load the schematic into.
+ *  \param [in]     filename   A character string containing the file name
+ *                             to open.
+ *  \param [in]     flags      Combination of #FOpenFlags values.
+ *  \param [in,out] err  #GError structure for error reporting, or
+ *                       NULL to disable error reporting
+ *
+ *  \return 0 on failure, 1 on success.
+ */
+int f_open_flags(TOPLEVEL *toplevel, PAGE *page,
+                 const gchar *filename,
+                 const gint flags, GError **err)
+{
+  int opened=FALSE;
+  char *saved_cwd = NULL;
+  PageLoad load = { toplevel, page, NULL, NULL, FALSE, NULL, NULL };
+
+  /* has the head been freed yet? */
+  /* probably not hack PAGE */
+
+  /* Cache the cwd so we can restore it later. */
+  if (flags & F_OPEN_RESTORE_CWD) {
+    saved_cwd = g_get_current_dir();
+  }
+
+  /* Once we have set the current directory and read the RC
+   * file, it's time to read in the file. */
+  if (page_load_locate (&load, filename, err)) {
+    page_load_prepare (&load, flags);
+    page_load_read (&load);
+    opened = page_load_finish (&load, err);
+  }
 
   /* Reset the directory to the value it had when f_open was
    * called. */
@@ -320,6 +448,137 @@ int f_open_flags(TOPLEVEL *toplevel, PAGE *page,
   return opened;
 }
 
+/*! \brief Opens several schematic files at once.
+ *  \par Function Description
+ *  Loads each page in \a pages from the file named by its
+ *  <B>page_filename</B>, as f_open_flags() would.  The pages are
+ *  handled in the order of \a pages, and consecutive files in the same
+ *  directory are read together on worker threads, with that directory
+ *  as the working directory.  The RC files of a directory are only
+ *  executed once every file before it has been read, so each file
+ *  sees the same component libraries and settings as if the files
+ *  were opened one by one.  Finally, the objects are added to their
+ *  pages in the order of \a pages.
+ *
+ *  If a file can't be loaded, \a failed_page is set to the first page
+ *  which failed, and \a err to its error.  The other pages are still
+ *  loaded.  If every page was loaded but the working directory can't
+ *  be restored afterwards, \a failed_page is left NULL and \a err
+ *  describes the failure.
+ *
+ *  \param [in,out] toplevel     The TOPLEVEL object to load the pages into.
+ *  \param [in]     pages        The #PAGE structures to load.
+ *  \param [in]     flags        Combination of #FOpenFlags values.
+ *  \param [out]    failed_page  The first page which failed, or NULL.
+ *  \param [in,out] err          #GError structure for error reporting, or
+ *                               NULL to disable error reporting
+ *
+ *  \return TRUE if all the pages were loaded, FALSE otherwise.
+ */
+gboolean f_open_pages (TOPLEVEL *toplevel, GList *pages, const gint flags,
+                       PAGE **failed_page, GError **err)
+{
+  gint count = g_list_length (pages);
+  PageLoad *loads = g_new0 (PageLoad, count);
+  GThreadPool *pool = NULL;
+  const gchar *directory = NULL;
+  char *saved_cwd = NULL;
+  gboolean opened = TRUE;
+  GList *iter;
+  gint i;
+
+  if (failed_page != NULL) *failed_page = NULL;
+
+  /* Cache the cwd so we can restore it later. */
+  if (flags & F_OPEN_RESTORE_CWD) {
+    saved_cwd = g_get_current_dir();
+  }
+
+  for (iter = pages, i = 0; iter != NULL; iter = g_list_next (iter), i++) {
+    PageLoad *load = &loads[i];
+
+    load->toplevel = toplevel;
+    load->page = (PAGE *) iter->data;
+
+    if (!page_load_locate (load, load->page->page_filename, &load->error)) {
+      continue;
+    }
+
+    /* Files are read relative to their own directory, and RC files may
+     * change the component libraries, so the files of the previous
+     * directory must have been read before changing into the next
+     * one and executing its RC files. */
+    if (directory == NULL || strcmp (directory, load->directory) != 0) {
+      if (pool != NULL) {
+        g_thread_pool_free (pool, FALSE, TRUE);
+        pool = NULL;
+      }
+      directory = load->directory;
+    }
+
+    page_load_prepare (load, flags);
+
+    if (pool == NULL && count > 1 && g_thread_supported ()) {
+      pool = g_thread_pool_new (page_load_worker, NULL,
+                                MIN (count, F_OPEN_THREADS), FALSE, NULL);
+    }
+
+    if (pool != NULL) {
+      g_thread_pool_push (pool, load, NULL);
+    } else {
+      page_load_read (load);
+    }
+  }
+
+  if (pool != NULL) {
+    g_thread_pool_free (pool, FALSE, TRUE);
+  }
+
+  /* Add the objects to the pages in order */
+  for (i = 0; i < count; i++) {
+    PageLoad *load = &loads[i];
+    GError *tmp_err = NULL;
+
+    if (load->filename != NULL) {
+      if (page_load_finish (load, &tmp_err)) continue;
+    } else {
+      tmp_err = load->error;
+    }
+
+    if (opened) {
+      opened = FALSE;
+      if (failed_page != NULL) *failed_page = load->page;
+      g_propagate_error (err, tmp_err);
+    } else {
+      g_error_free (tmp_err);
+    }
+  }
+
+  /* Reset the directory to the value it had when f_open_pages was
+   * called. */
+  if (flags & F_OPEN_RESTORE_CWD) {
+    if (chdir (saved_cwd)) {
+      int errsv = errno;
+
+      /* Only report this if no page failed, as err is already set
+       * otherwise */
+      if (opened) {
+        g_set_error (err, G_FILE_ERROR, g_file_error_from_errno (errsv),
+                     _("Failed to change back to directory %s: %s"),
+                     saved_cwd, g_strerror (errsv));
+        opened = FALSE;
+      } else {
+        g_warning (_("Failed to change back to directory %s: %s\n"),
+                   saved_cwd, g_strerror (errsv));
+      }
+    }
+    g_free(saved_cwd);
+  }
+
+  g_free (loads);
+  return opened;
+}
+
 /*! \brief Closes the schematic file
  *  \par Function Description
  *  Does nothing
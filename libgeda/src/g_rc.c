@@ -1062,6 +1062,95 @@ SCM g_rc_make_backup_files(SCM mode)
                   2);
 }
 
+/*! \brief Enable the component library index
+ *  \par Function Description
+ *  If enabled then the list of symbols found in each component library
+ *  directory is saved in the user cache directory, and reused instead
+ *  of scanning the directory again while it is unchanged.  Only affects
+ *  component libraries added after it is called.
+ *
+ *  \param [in] mode  String. 'enabled' or 'disabled'
+ *  \return           Bool. False if mode is not a valid value; true if it is.
+ */
+SCM g_rc_component_library_index(SCM mode)
+{
+  static const vstbl_entry mode_table[] = {
+    {TRUE , "enabled" },
+    {FALSE, "disabled"},
+  };
+
+  RETURN_G_RC_MODE("component-library-index",
+                  default_component_library_index,
+                  2);
+}
+
+/*! \brief Enable the object cache
+ *  \par Function Description
+ *  If enabled then the objects read from each schematic and symbol file
+ *  are saved in a binary form in the user cache directory, and read
+ *  back from there instead of parsing the same file contents again.
+ *
+ *  \param [in] mode  String. 'enabled' or 'disabled'
+ *  \return           Bool. False if mode is not a valid value; true if it is.
+ */
+SCM g_rc_object_cache(SCM mode)
+{
+  static const vstbl_entry mode_table[] = {
+    {TRUE , "enabled" },
+    {FALSE, "disabled"},
+  };
+
+  RETURN_G_RC_MODE("object-cache",
+                  default_object_cache,
+                  2);
+}
+
+/*! \brief Enable allocating objects in arenas
+ *  \par Function Description
+ *  If enabled then the objects read from each file are allocated
+ *  together in large chunks of memory, which are released as a whole
+ *  once all the objects have been deleted.
+ *
+ *  \param [in] mode  String. 'enabled' or 'disabled'
+ *  \return           Bool. False if mode is not a valid value; true if it is.
+ */
+SCM g_rc_object_arena(SCM mode)
+{
+  static const vstbl_entry mode_table[] = {
+    {TRUE , "enabled" },
+    {FALSE, "disabled"},
+  };
+
+  RETURN_G_RC_MODE("object-arena",
+                  default_object_arena,
+                  2);
+}
+
+/*! \brief Set the size of the symbol data cache
+ *  \par Function Description
+ *  Sets the approximate number of kilobytes of memory used to cache
+ *  symbol data read from the component library.
+ *
+ *  \param [in] size  Number. Cache size in kilobytes.
+ *  \return           SCM_BOOL_T always.
+ */
+SCM g_rc_symbol_cache_size(SCM size)
+#define FUNC_NAME "symbol-cache-size"
+{
+  SCM_ASSERT (scm_is_integer (size) && scm_is_true (scm_positive_p (size)),
+              size, SCM_ARG1, FUNC_NAME);
+
+  /* The size in bytes must fit in a size_t */
+  if (scm_is_false (scm_leq_p (size, scm_from_size_t (G_MAXSIZE / 1024)))) {
+    scm_out_of_range (FUNC_NAME, size);
+  }
+
+  s_clib_set_symbol_cache_size (scm_to_size_t (size) * 1024);
+
+  return SCM_BOOL_T;
+}
+#undef FUNC_NAME
+
 SCM g_rc_print_color_map (SCM scm_map)
 {
   if (scm_map == SCM_UNDEFINED) {
@@ -65,6 +65,10 @@ static struct gsubr_t libgeda_funcs[] = {
   { "keep-invisible",            1, 0, 0, g_rc_keep_invisible },
   { "always-promote-attributes",1, 0, 0, g_rc_always_promote_attributes },
   { "make-backup-files",        1, 0, 0, g_rc_make_backup_files },
+  { "symbol-cache-size",        1, 0, 0, g_rc_symbol_cache_size },
+  { "component-library-index",  1, 0, 0, g_rc_component_library_index },
+  { "object-cache",             1, 0, 0, g_rc_object_cache },
+  { "object-arena",             1, 0, 0, g_rc_object_arena },
   { "print-color-map", 0, 1, 0, g_rc_print_color_map },
   { "rc-filename",              0, 0, 0, g_rc_rc_filename },
   { "rc-config",                0, 0, 0, g_rc_rc_config },
@@ -35,7 +35,7 @@
 GedaArc*
 geda_arc_new ()
 {
-  return g_new0 (GedaArc, 1);
+  return geda_arena_alloc0 (sizeof (GedaArc));
 }
 
 /*! \brief Free memory associated with the arc
@@ -45,7 +45,7 @@ geda_arc_new ()
 void
 geda_arc_free (GedaArc *arc)
 {
-  g_free (arc);
+  geda_arena_free (arc);
 }
 
 /*! \brief Determines if a point lies within the sweep of the arc.
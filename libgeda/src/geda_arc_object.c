@@ -353,7 +353,7 @@ geda_arc_object_modify (TOPLEVEL *toplevel, OBJECT *object, int x, int y, int wh
 	}
 
 	/* update the screen coords and the bounding box */
-	object->w_bounds_valid_for = NULL;
+	geda_object_invalidate_bounds (object);
 	o_emit_change_notify (toplevel, object);
 }
 
@@ -403,8 +403,8 @@ OBJECT *o_arc_read (TOPLEVEL *toplevel, const char buf[],
    *  restrictive - the oldest - file format are set to common values
    */
   if(release_ver <= VERSION_20000704) {
-    if (sscanf(buf, "%c %d %d %d %d %d %d", &type,
-	       &x1, &y1, &radius, &start_angle, &sweep_angle, &color) != 7) {
+    if (o_read_scan_line (buf, NULL, &type, 6,
+                          &x1, &y1, &radius, &start_angle, &sweep_angle, &color) != 7) {
       g_set_error (err, EDA_ERROR, EDA_ERROR_PARSE, _("Failed to parse arc object"));
       return NULL;
     }
@@ -415,9 +415,9 @@ OBJECT *o_arc_read (TOPLEVEL *toplevel, const char buf[],
     arc_space = -1;
     arc_length= -1;
   } else {
-    if (sscanf(buf, "%c %d %d %d %d %d %d %d %d %d %d %d", &type,
-	       &x1, &y1, &radius, &start_angle, &sweep_angle, &color,
-	       &arc_width, &arc_end, &arc_type, &arc_length, &arc_space) != 12) {
+    if (o_read_scan_line (buf, NULL, &type, 11,
+                          &x1, &y1, &radius, &start_angle, &sweep_angle, &color,
+                          &arc_width, &arc_end, &arc_type, &arc_length, &arc_space) != 12) {
       g_set_error (err, EDA_ERROR, EDA_ERROR_PARSE, _("Failed to parse arc object"));
       return NULL;
     }
@@ -470,25 +470,47 @@ OBJECT *o_arc_read (TOPLEVEL *toplevel, const char buf[],
 gchar*
 geda_arc_object_to_buffer (const GedaObject *object)
 {
+  GString *buffer;
+
   g_return_val_if_fail (object != NULL, NULL);
   g_return_val_if_fail (object->arc != NULL, NULL);
   g_return_val_if_fail (object->type == OBJ_ARC, NULL);
 
+  buffer = g_string_new (NULL);
+  geda_arc_object_append_to_buffer (object, buffer);
+
+  return g_string_free (buffer, FALSE);
+}
+
+/*! \brief Append a string representation of the arc object
+ *  \par Function Description
+ *  Appends the same text as geda_arc_object_to_buffer() to \a buffer,
+ *  without allocating a string for it.
+ *
+ *  \param [in]     object  The arc object
+ *  \param [in,out] buffer  The buffer to append to
+ */
+void
+geda_arc_object_append_to_buffer (const GedaObject *object, GString *buffer)
+{
+  g_return_if_fail (object != NULL);
+  g_return_if_fail (object->arc != NULL);
+  g_return_if_fail (object->type == OBJ_ARC);
+
   /* Describe a circle with post-20000704 file format */
 
-  return g_strdup_printf ("%c %d %d %d %d %d %d %d %d %d %d %d",
-                          OBJ_ARC,
-                          geda_arc_object_get_center_x (object),
-                          geda_arc_object_get_center_y (object),
-                          geda_arc_object_get_radius (object),
-                          geda_arc_object_get_start_angle (object),
-                          geda_arc_object_get_sweep_angle (object),
-                          geda_object_get_color (object),
-                          object->line_width,
-                          object->line_end,
-                          object->line_type,
-                          object->line_length,
-                          object->line_space);
+  o_save_fields (buffer, OBJ_ARC, 11,
+                 geda_arc_object_get_center_x (object),
+                 geda_arc_object_get_center_y (object),
+                 geda_arc_object_get_radius (object),
+                 geda_arc_object_get_start_angle (object),
+                 geda_arc_object_get_sweep_angle (object),
+                 geda_object_get_color (object),
+                 object->line_width,
+                 object->line_end,
+                 object->line_type,
+                 object->line_length,
+                 object->line_space);
 }
 
 /*! \brief
@@ -513,7 +535,7 @@ geda_arc_object_translate (GedaObject *object, int dx, int dy)
 
 
   /* Recalculate screen coords from new world coords */
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
 }
 
 /*! \brief
@@ -569,7 +591,7 @@ void geda_arc_object_rotate (TOPLEVEL *toplevel,
   object->arc->y += world_centery;
 
   /* update the screen coords and the bounding box */
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
 
 }
 
@@ -613,7 +635,7 @@ void geda_arc_object_mirror (TOPLEVEL *toplevel,
   object->arc->x += world_centerx;
 
   /* update the screen coords and bounding box */
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
 
 }
 
@@ -0,0 +1,198 @@
+/* gEDA - GPL Electronic Design Automation
+ * libgeda - gEDA's library
+ * Copyright (C) 1998-2010 Ales Hvezda
+ * Copyright (C) 1998-2010 gEDA Contributors (see ChangeLog for details)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*! \file geda_arena.c
+ *  \brief Memory arenas for the objects read from a file
+ *
+ *  An arena hands out memory from large chunks, so that the many
+ *  small structures making up the objects of a file are allocated
+ *  without a call to malloc() each, and end up next to each other
+ *  instead of scattered over the heap.
+ *
+ *  Each thread has a current arena, set with geda_arena_set_current().
+ *  geda_arena_alloc0() takes memory from it, or from the heap if there
+ *  is no current arena.  Every block remembers where it came from, so
+ *  geda_arena_free() works for both.
+ *
+ *  Objects can outlive the page they were read into, e.g. when they
+ *  are moved to another page, so an arena is reference counted: every
+ *  block holds a reference, and so does whoever created the arena.
+ *  Freeing a block only drops its reference, and the chunks are all
+ *  released together once the last block of the arena is freed.
+ */
+
+#include <config.h>
+
+#include "libgeda_priv.h"
+
+/*! Size of the chunks an arena allocates from the heap */
+#define ARENA_CHUNK_SIZE (256 * 1024)
+
+/*! Blocks larger than this are always allocated from the heap */
+#define ARENA_MAX_BLOCK (ARENA_CHUNK_SIZE / 16)
+
+struct _GedaArena {
+  /*! One reference per block, plus one for the creator */
+  volatile gint ref_count;
+  /*! The chunks allocated so far, most recent first */
+  GSList *chunks;
+  /*! The unused part of the most recent chunk */
+  gchar *next;
+  gchar *end;
+};
+
+/*! The header in front of every block.  Its size keeps the blocks
+ *  aligned for any of the structures stored in them. */
+typedef union {
+  /*! The arena the block belongs to, or NULL if it is on the heap */
+  GedaArena *arena;
+  gint64 align_int;
+  gdouble align_double;
+  gpointer align_pointer[2];
+} BlockHeader;
+
+/*! The current arena of each thread */
+#if GLIB_CHECK_VERSION(2,32,0)
+static GPrivate current_arena = G_PRIVATE_INIT (NULL);
+#define GET_CURRENT_ARENA()  ((GedaArena *) g_private_get (&current_arena))
+#define SET_CURRENT_ARENA(a) g_private_set (&current_arena, (a))
+#else
+static GStaticPrivate current_arena = G_STATIC_PRIVATE_INIT;
+#define GET_CURRENT_ARENA()  ((GedaArena *) g_static_private_get (&current_arena))
+#define SET_CURRENT_ARENA(a) g_static_private_set (&current_arena, (a), NULL)
+#endif
+
+/*! \brief Create a new arena.
+ *  \par Function Description
+ *  Creates an empty arena.  The caller holds a reference to it, which
+ *  must be dropped with geda_arena_unref() once no more memory will be
+ *  allocated from it.
+ *
+ *  \return The new arena.
+ */
+GedaArena *geda_arena_new ()
+{
+  GedaArena *arena = g_new0 (GedaArena, 1);
+
+  arena->ref_count = 1;
+
+  return arena;
+}
+
+/*! \brief Drop a reference to an arena.
+ *  \par Function Description
+ *  Frees the chunks of \a arena when the last reference to it is
+ *  dropped, i.e. when its creator is done with it and all of its
+ *  blocks have been freed.
+ *
+ *  \param [in] arena  The arena to drop a reference to.
+ */
+void geda_arena_unref (GedaArena *arena)
+{
+  g_return_if_fail (arena != NULL);
+
+  if (g_atomic_int_dec_and_test (&arena->ref_count)) {
+    g_slist_foreach (arena->chunks, (GFunc) g_free, NULL);
+    g_slist_free (arena->chunks);
+    g_free (arena);
+  }
+}
+
+/*! \brief Set the current arena of this thread.
+ *  \par Function Description
+ *  Makes geda_arena_alloc0() allocate from \a arena on the calling
+ *  thread, or from the heap if \a arena is NULL.  The caller must keep
+ *  its reference to \a arena for as long as it is current.
+ *
+ *  \param [in] arena  The new current arena, or NULL.
+ *  \return The previous current arena, to restore later.
+ */
+GedaArena *geda_arena_set_current (GedaArena *arena)
+{
+  GedaArena *previous = GET_CURRENT_ARENA ();
+
+  SET_CURRENT_ARENA (arena);
+
+  return previous;
+}
+
+/*! \brief Allocate a block of memory.
+ *  \par Function Description
+ *  Allocates \a size bytes, filled with zeros, from the current arena
+ *  of the calling thread, or from the heap if there is none.  The
+ *  block must be freed with geda_arena_free().
+ *
+ *  \param [in] size  The number of bytes to allocate.
+ *  \return The new block.
+ */
+gpointer geda_arena_alloc0 (gsize size)
+{
+  GedaArena *arena = GET_CURRENT_ARENA ();
+  BlockHeader *header;
+  gsize total;
+
+  /* Round up to keep the next block aligned */
+  total = sizeof (BlockHeader) +
+    (size + sizeof (BlockHeader) - 1) / sizeof (BlockHeader) * sizeof (BlockHeader);
+
+  if (arena == NULL || total > ARENA_MAX_BLOCK) {
+    header = g_malloc0 (total);
+    header->arena = NULL;
+    return header + 1;
+  }
+
+  if (arena->next == NULL || (gsize) (arena->end - arena->next) < total) {
+    /* The rest of the current chunk is wasted */
+    arena->next = g_malloc0 (ARENA_CHUNK_SIZE);
+    arena->end = arena->next + ARENA_CHUNK_SIZE;
+    arena->chunks = g_slist_prepend (arena->chunks, arena->next);
+  }
+
+  header = (BlockHeader *) arena->next;
+  arena->next += total;
+
+  header->arena = arena;
+  g_atomic_int_inc (&arena->ref_count);
+
+  return header + 1;
+}
+
+/*! \brief Free a block of memory.
+ *  \par Function Description
+ *  Frees a block allocated by geda_arena_alloc0().  A block from an
+ *  arena is not reused; its memory is released along with the rest
+ *  of the arena.
+ *
+ *  \param [in] mem  The block to free, or NULL.
+ */
+void geda_arena_free (gpointer mem)
+{
+  BlockHeader *header;
+
+  if (mem == NULL) return;
+
+  header = ((BlockHeader *) mem) - 1;
+
+  if (header->arena == NULL) {
+    g_free (header);
+  } else {
+    geda_arena_unref (header->arena);
+  }
+}
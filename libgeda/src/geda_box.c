@@ -35,7 +35,7 @@
 GedaBox*
 geda_box_new ()
 {
-  return g_new0 (GedaBox, 1);
+  return geda_arena_alloc0 (sizeof (GedaBox));
 }
 
 /*! \brief Free memory associated with the box
@@ -45,7 +45,7 @@ geda_box_new ()
 void
 geda_box_free (GedaBox *box)
 {
-  g_free (box);
+  geda_arena_free (box);
 }
 
 
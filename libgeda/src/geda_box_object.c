@@ -160,7 +160,7 @@ geda_box_object_modify_all (TOPLEVEL *toplevel, OBJECT *object,
   object->box->upper_y = (y1 > y2) ? y1 : y2;
 
   /* recalculate the world coords and bounds */
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
   o_emit_change_notify (toplevel, object);
 }
 
@@ -235,7 +235,7 @@ geda_box_object_modify (TOPLEVEL *toplevel, OBJECT *object, int x, int y, int wh
 	}
 
 	/* recalculate the world coords and the boundings */
-	object->w_bounds_valid_for = NULL;
+	geda_object_invalidate_bounds (object);
 	o_emit_change_notify (toplevel, object);
 
 }
@@ -282,8 +282,7 @@ OBJECT *o_box_read (TOPLEVEL *toplevel, const char buf[],
    *  to default.
    */
 
-    if (sscanf (buf, "%c %d %d %d %d %d\n",
-		&type, &x1, &y1, &width, &height, &color) != 6) {
+    if (o_read_scan_line (buf, NULL, &type, 5, &x1, &y1, &width, &height, &color) != 6) {
       g_set_error(err, EDA_ERROR, EDA_ERROR_PARSE, _("Failed to parse box object"));
       return NULL;
     }
@@ -308,11 +307,10 @@ OBJECT *o_box_read (TOPLEVEL *toplevel, const char buf[],
      *  characters and numbers in plain ASCII on a single line. The meaning of
      *  each item is described in the file format documentation.
      */
-    if (sscanf (buf, "%c %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n",
-		&type, &x1, &y1, &width, &height, &color,
-		&box_width, &box_end, &box_type, &box_length,
-		&box_space, &box_filling,
-		&fill_width, &angle1, &pitch1, &angle2, &pitch2) != 17) {
+    if (o_read_scan_line (buf, NULL, &type, 16, &x1, &y1, &width, &height, &color,
+                          &box_width, &box_end, &box_type, &box_length,
+                          &box_space, &box_filling,
+                          &fill_width, &angle1, &pitch1, &angle2, &pitch2) != 17) {
       g_set_error(err, EDA_ERROR, EDA_ERROR_PARSE, _("Failed to parse box object"));
       return NULL;
     }
@@ -376,15 +374,28 @@ OBJECT *o_box_read (TOPLEVEL *toplevel, const char buf[],
  */
 gchar*
 geda_box_object_to_buffer (const GedaObject *object)
+{
+  GString *buffer;
+
+  buffer = g_string_new (NULL);
+  geda_box_object_append_to_buffer (object, buffer);
+
+  return g_string_free (buffer, FALSE);
+}
+
+/*! \brief Append a string representation of the box object
+ *  \par Function Description
+ *  Appends the same text as geda_box_object_to_buffer() to \a buffer,
+ *  without allocating a string for it.
+ *
+ *  \param [in]     object  The box object
+ *  \param [in,out] buffer  The buffer to append to
+ */
+void
+geda_box_object_append_to_buffer (const GedaObject *object, GString *buffer)
 {
   int x1, y1;
   int width, height;
-  int box_width, box_space, box_length;
-  int fill_width, angle1, pitch1, angle2, pitch2;
-  OBJECT_END box_end;
-  OBJECT_TYPE box_type;
-  OBJECT_FILLING box_fill;
-  char *buf;
 
   /*! \note
    *  A box is internally represented by its lower right and upper left corner
@@ -404,29 +415,21 @@ geda_box_object_to_buffer (const GedaObject *object)
   printf("box: %d %d %d %d\n", x1, y1, width, height);
 #endif
 
-  /* description of the line type for the outline */
-  box_end    = object->line_end;
-  box_width  = object->line_width;
-  box_type   = object->line_type;
-  box_length = object->line_length;
-  box_space  = object->line_space;
-
-  /* description of the filling of the box */
-  box_fill   = object->fill_type;
-  fill_width = object->fill_width;
-  angle1     = object->fill_angle1;
-  pitch1     = object->fill_pitch1;
-  angle2     = object->fill_angle2;
-  pitch2     = object->fill_pitch2;
-
-  buf = g_strdup_printf("%c %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d",
-			object->type,
-			x1, y1, width, height, geda_object_get_color (object),
-			box_width, box_end, box_type, box_length, box_space,
-			box_fill,
-			fill_width, angle1, pitch1, angle2, pitch2);
-
-  return(buf);
+  o_save_fields (buffer, object->type, 16,
+                 x1, y1, width, height, geda_object_get_color (object),
+                 /* description of the line type for the outline */
+                 object->line_width,
+                 object->line_end,
+                 object->line_type,
+                 object->line_length,
+                 object->line_space,
+                 /* description of the filling of the box */
+                 object->fill_type,
+                 object->fill_width,
+                 object->fill_angle1,
+                 object->fill_pitch1,
+                 object->fill_angle2,
+                 object->fill_pitch2);
 }
 
 /*! \brief Translate a BOX position in WORLD coordinates by a delta.
@@ -452,7 +455,7 @@ geda_box_object_translate (GedaObject *object, int dx, int dy)
   object->box->lower_y = object->box->lower_y + dy;
 
   /* recalc the screen coords and the bounding box */
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
 }
 
 /*! \brief Rotate BOX OBJECT using WORLD coordinates.
@@ -522,7 +525,7 @@ void geda_box_object_rotate (TOPLEVEL *toplevel,
   object->box->lower_y += world_centery;
 
   /* recalc boundings and world coords */
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
 }
 
 /*! \brief Mirror BOX using WORLD coordinates.
@@ -574,7 +577,7 @@ void geda_box_object_mirror (TOPLEVEL *toplevel,
   object->box->lower_y += world_centery;
 
   /* recalc boundings and world coords */
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
 
 }
 
@@ -341,14 +341,14 @@ o_bus_read (TOPLEVEL *toplevel,
   int ripper_dir;
 
   if (release_ver <= VERSION_20020825) {
-    if (sscanf (buf, "%c %d %d %d %d %d\n", &type, &x1, &y1, &x2, &y2, &color) != 6) {
+    if (o_read_scan_line (buf, NULL, &type, 5, &x1, &y1, &x2, &y2, &color) != 6) {
       g_set_error(err, EDA_ERROR, EDA_ERROR_PARSE, _("Failed to parse bus object"));
       return NULL;
     }
     ripper_dir = 0;
   } else {
-    if (sscanf (buf, "%c %d %d %d %d %d %d\n", &type, &x1, &y1, &x2, &y2, &color,
-		&ripper_dir) != 7) {
+    if (o_read_scan_line (buf, NULL, &type, 6, &x1, &y1, &x2, &y2, &color,
+                          &ripper_dir) != 7) {
       g_set_error(err, EDA_ERROR, EDA_ERROR_PARSE, _("Failed to parse bus object"));
       return NULL;
     }
@@ -387,18 +387,40 @@ o_bus_read (TOPLEVEL *toplevel,
 gchar*
 geda_bus_object_to_buffer (const GedaObject *object)
 {
+  GString *buffer;
+
   g_return_val_if_fail (object != NULL, NULL);
   g_return_val_if_fail (object->line != NULL, NULL);
   g_return_val_if_fail (object->type == OBJ_BUS, NULL);
 
-  return g_strdup_printf ("%c %d %d %d %d %d %d",
-                          OBJ_BUS,
-                          geda_bus_object_get_x0 (object),
-                          geda_bus_object_get_y0 (object),
-                          geda_bus_object_get_x1 (object),
-                          geda_bus_object_get_y1 (object),
-                          geda_object_get_color (object),
-                          geda_bus_object_get_ripper_direction (object));
+  buffer = g_string_new (NULL);
+  geda_bus_object_append_to_buffer (object, buffer);
+
+  return g_string_free (buffer, FALSE);
+}
+
+/*! \brief Append a string representation of the bus object
+ *  \par Function Description
+ *  Appends the same text as geda_bus_object_to_buffer() to \a buffer,
+ *  without allocating a string for it.
+ *
+ *  \param [in]     object  The bus object
+ *  \param [in,out] buffer  The buffer to append to
+ */
+void
+geda_bus_object_append_to_buffer (const GedaObject *object, GString *buffer)
+{
+  g_return_if_fail (object != NULL);
+  g_return_if_fail (object->line != NULL);
+  g_return_if_fail (object->type == OBJ_BUS);
+
+  o_save_fields (buffer, OBJ_BUS, 6,
+                 geda_bus_object_get_x0 (object),
+                 geda_bus_object_get_y0 (object),
+                 geda_bus_object_get_x1 (object),
+                 geda_bus_object_get_y1 (object),
+                 geda_object_get_color (object),
+                 geda_bus_object_get_ripper_direction (object));
 }
 
 /*! \brief move a bus object
@@ -423,7 +445,7 @@ geda_bus_object_translate (GedaObject *object, gint dx, gint dy)
   object->line->y[1] = object->line->y[1] + dy;
 
   /* Update bounding box */
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
 }
 
 /*! \brief create a copy of a bus object
@@ -595,5 +617,5 @@ geda_bus_object_modify (TOPLEVEL *toplevel,
   object->line->x[whichone] = x;
   object->line->y[whichone] = y;
 
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
 }
@@ -36,7 +36,7 @@
 GedaCircle*
 geda_circle_new ()
 {
-  return g_new0 (GedaCircle, 1);
+  return geda_arena_alloc0 (sizeof (GedaCircle));
 }
 
 /*! \brief Free memory associated with the circle
@@ -46,7 +46,7 @@ geda_circle_new ()
 void
 geda_circle_free (GedaCircle *circle)
 {
-  g_free (circle);
+  geda_arena_free (circle);
 }
 
 /*! \brief Calculate the bounds of a circle
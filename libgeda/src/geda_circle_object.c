@@ -293,7 +293,7 @@ geda_circle_object_modify (TOPLEVEL *toplevel,
   }
 
   /* recalculate the boundings */
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
   o_emit_change_notify (toplevel, object);
 }
 
@@ -339,7 +339,7 @@ o_circle_read (TOPLEVEL *toplevel,
      * handle the line type and the filling of the box object. They are set
      * to default.
      */
-    if (sscanf(buf, "%c %d %d %d %d\n", &type, &x1, &y1, &radius, &color) != 5) {
+    if (o_read_scan_line (buf, NULL, &type, 4, &x1, &y1, &radius, &color) != 5) {
       g_set_error(err, EDA_ERROR, EDA_ERROR_PARSE, _("Failed to parse circle object"));
       return NULL;
     }
@@ -364,11 +364,10 @@ o_circle_read (TOPLEVEL *toplevel,
      * list of characters and numbers in plain ASCII on a single line. The
      * meaning of each item is described in the file format documentation.
      */
-    if (sscanf(buf, "%c %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n",
-	       &type, &x1, &y1, &radius, &color,
-	       &circle_width, &circle_end, &circle_type,
-	       &circle_length, &circle_space, &circle_fill,
-	       &fill_width, &angle1, &pitch1, &angle2, &pitch2) != 16) {
+    if (o_read_scan_line (buf, NULL, &type, 15, &x1, &y1, &radius, &color,
+                          &circle_width, &circle_end, &circle_type,
+                          &circle_length, &circle_space, &circle_fill,
+                          &fill_width, &angle1, &pitch1, &angle2, &pitch2) != 16) {
       g_set_error(err, EDA_ERROR, EDA_ERROR_PARSE, _("Failed to parse circle object"));
       return NULL;
     }
@@ -423,27 +422,49 @@ o_circle_read (TOPLEVEL *toplevel,
 gchar*
 geda_circle_object_to_buffer (const GedaObject *object)
 {
+  GString *buffer;
+
   g_return_val_if_fail (object != NULL, NULL);
   g_return_val_if_fail (object->circle != NULL, NULL);
   g_return_val_if_fail (object->type == OBJ_CIRCLE, NULL);
 
-  return g_strdup_printf ("%c %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d",
-                          OBJ_CIRCLE,
-                          geda_circle_object_get_center_x (object),
-                          geda_circle_object_get_center_y (object),
-                          geda_circle_object_get_radius (object),
-                          geda_object_get_color (object),
-                          object->line_width,
-                          object->line_end,
-                          object->line_type,
-                          object->line_length,
-                          object->line_space,
-                          object->fill_type,
-                          object->fill_width,
-                          object->fill_angle1,
-                          object->fill_pitch1,
-                          object->fill_angle2,
-                          object->fill_pitch2);
+  buffer = g_string_new (NULL);
+  geda_circle_object_append_to_buffer (object, buffer);
+
+  return g_string_free (buffer, FALSE);
+}
+
+/*! \brief Append a string representation of the circle object
+ *  \par Function Description
+ *  Appends the same text as geda_circle_object_to_buffer() to \a buffer,
+ *  without allocating a string for it.
+ *
+ *  \param [in]     object  The circle object
+ *  \param [in,out] buffer  The buffer to append to
+ */
+void
+geda_circle_object_append_to_buffer (const GedaObject *object, GString *buffer)
+{
+  g_return_if_fail (object != NULL);
+  g_return_if_fail (object->circle != NULL);
+  g_return_if_fail (object->type == OBJ_CIRCLE);
+
+  o_save_fields (buffer, OBJ_CIRCLE, 15,
+                 geda_circle_object_get_center_x (object),
+                 geda_circle_object_get_center_y (object),
+                 geda_circle_object_get_radius (object),
+                 geda_object_get_color (object),
+                 object->line_width,
+                 object->line_end,
+                 object->line_type,
+                 object->line_length,
+                 object->line_space,
+                 object->fill_type,
+                 object->fill_width,
+                 object->fill_angle1,
+                 object->fill_pitch1,
+                 object->fill_angle2,
+                 object->fill_pitch2);
 }
 
 /*! \brief Translate a circle position in WORLD coordinates by a delta.
@@ -467,7 +488,7 @@ geda_circle_object_translate (GedaObject *object, gint dx, gint dy)
   object->circle->center_y = object->circle->center_y + dy;
 
   /* recalc the screen coords and the bounding box */
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
 
 }
 
@@ -526,7 +547,7 @@ geda_circle_object_rotate (TOPLEVEL *toplevel,
   object->circle->center_x += world_centerx;
   object->circle->center_y += world_centery;
 
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
 }
 
 /*! \brief Mirror circle using WORLD coordinates.
@@ -562,7 +583,7 @@ geda_circle_object_mirror (TOPLEVEL *toplevel,
   object->circle->center_x += world_centerx;
 
   /* recalc boundings and screen coords */
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
 }
 
 /*! \brief Get circle bounding rectangle in WORLD coordinates.
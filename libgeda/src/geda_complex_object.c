@@ -193,7 +193,7 @@ int o_complex_is_embedded(OBJECT *o_current)
 {
   g_return_val_if_fail(o_current != NULL, 0);
 
-  if(o_current->complex == NULL)
+  if (o_current->type != OBJ_COMPLEX && o_current->type != OBJ_PLACEHOLDER)
     return 0;
 
   if (o_current->complex_embedded) {
@@ -242,6 +242,7 @@ GList *o_complex_get_promotable (TOPLEVEL *toplevel, OBJECT *object, int detach)
       tmp->parent = NULL;
       object->complex->prim_objs =
         g_list_remove (object->complex->prim_objs, tmp);
+      o_attrib_invalidate_index (object);
     }
 
     promoted = g_list_prepend (promoted, tmp);
@@ -294,6 +295,7 @@ GList *o_complex_promote_attribs (TOPLEVEL *toplevel, OBJECT *object)
     /* Invalidate the object's bounds since we may have
      * stolen objects from inside it. */
     o_bounds_invalidate (toplevel, object);
+    o_attrib_invalidate_index (object);
   }
 
   /* Attach promoted attributes to the original complex object */
@@ -339,6 +341,7 @@ static void o_complex_remove_promotable_attribs (TOPLEVEL *toplevel, OBJECT *obj
   }
 
   o_bounds_invalidate (toplevel, object);
+  o_attrib_invalidate_index (object);
   g_list_free (promotable);
 }
 
@@ -429,10 +432,53 @@ static void create_placeholder(TOPLEVEL * toplevel, OBJECT * new_node, int x, in
     new_node->complex->prim_objs = g_list_reverse(new_node->complex->prim_objs);
 }
 
+/*! \brief Copy the parsed objects of a symbol
+ *  \par Function Description
+ *  Copies the objects in \a prototype, keeping their order and the
+ *  attachments of attributes to objects within the list.  Each copy
+ *  gets a new session-unique id.  The objects in \a prototype are not
+ *  modified, so other threads may copy them at the same time.
+ *
+ *  \param [in] toplevel   The TOPLEVEL object.
+ *  \param [in] prototype  The objects to copy.
+ *  \return A new GList of new objects.
+ */
+static GList *copy_prototype (TOPLEVEL *toplevel, const GList *prototype)
+{
+  const GList *iter;
+  GList *objects = NULL;
+  GHashTable *copies = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+  for (iter = prototype; iter != NULL; iter = g_list_next (iter)) {
+    OBJECT *copy = o_object_copy_unmarked (toplevel, (OBJECT*) iter->data);
+    objects = g_list_prepend (objects, copy);
+    g_hash_table_insert (copies, iter->data, copy);
+  }
+
+  for (iter = prototype; iter != NULL; iter = g_list_next (iter)) {
+    OBJECT *o_current = iter->data;
+    OBJECT *attached_to;
+
+    if (o_current->attached_to == NULL) continue;
+
+    attached_to = g_hash_table_lookup (copies, o_current->attached_to);
+    if (attached_to != NULL) {
+      o_attrib_attach (toplevel, g_hash_table_lookup (copies, o_current),
+                       attached_to, FALSE);
+    }
+  }
+
+  g_hash_table_destroy (copies);
+
+  return g_list_reverse (objects);
+}
+
 /* Done */
 /*! \brief
  *  \par Function Description
- *
+ *  The objects of the symbol are copied from the parsed prototype
+ *  kept by the component library, instead of parsing the symbol data
+ *  again for each instance.
  */
 OBJECT *o_complex_new(TOPLEVEL *toplevel,
 		      char type,
@@ -443,7 +489,7 @@ OBJECT *o_complex_new(TOPLEVEL *toplevel,
 {
   OBJECT *new_node=NULL;
   GList *iter;
-  gchar *buffer = NULL;
+  CLibPrototype *prototype = NULL;
 
   new_node = s_basic_new_object(type, "complex");
 
@@ -458,41 +504,33 @@ OBJECT *o_complex_new(TOPLEVEL *toplevel,
   new_node->color = color;
   new_node->selectable = selectable;
 
-  new_node->complex = (COMPLEX *) g_malloc(sizeof(COMPLEX));
+  new_node->complex = (COMPLEX *) geda_arena_alloc0 (sizeof(COMPLEX));
   new_node->complex->prim_objs = NULL;
   new_node->complex->angle = angle;
   new_node->complex->mirror = mirror;
   new_node->complex->x = x;
   new_node->complex->y = y;
 
-  /* get the symbol data */
+  /* get the parsed symbol data. If reading fails, use a placeholder
+   * object instead.  The reference keeps the prototype alive while it
+   * is copied, even if the symbol is evicted from the cache. */
   if (clib != NULL) {
-    buffer = s_clib_symbol_get_data (clib);
+    prototype = s_clib_symbol_get_prototype (toplevel, clib);
   }
 
-  if (clib == NULL || buffer == NULL)
+  if (prototype == NULL) {
     create_placeholder(toplevel, new_node, x, y);
-  else {
-    GError * err = NULL;
-
-    /* add connections till translated */
-    new_node->complex->prim_objs = o_read_buffer (toplevel, NULL, buffer, -1, new_node->complex_basename, &err);
-    if (err) {
-      g_error_free(err);
-      /* If reading fails, replace with placeholder object */
-      create_placeholder(toplevel, new_node, x, y);
-    }
-    else {
-      if (mirror) {
-        geda_object_list_mirror (new_node->complex->prim_objs, 0, 0, toplevel);
-      }
+  } else {
+    new_node->complex->prim_objs =
+      copy_prototype (toplevel, s_clib_prototype_get_objects (prototype));
+    s_clib_prototype_unref (prototype);
 
-      geda_object_list_rotate (new_node->complex->prim_objs, 0, 0, angle, toplevel);
-      geda_object_list_translate (new_node->complex->prim_objs, x, y);
+    if (mirror) {
+      geda_object_list_mirror (new_node->complex->prim_objs, 0, 0, toplevel);
     }
 
-    g_free (buffer);
-
+    geda_object_list_rotate (new_node->complex->prim_objs, 0, 0, angle, toplevel);
+    geda_object_list_translate (new_node->complex->prim_objs, x, y);
   }
 
   /* set the parent field now */
@@ -529,7 +567,7 @@ OBJECT *o_complex_new_embedded(TOPLEVEL *toplevel,
 
   new_node = s_basic_new_object(type, "complex");
 
-  new_node->complex = (COMPLEX *) g_malloc(sizeof(COMPLEX));
+  new_node->complex = (COMPLEX *) geda_arena_alloc0 (sizeof(COMPLEX));
   new_node->complex->x = x;
   new_node->complex->y = y;
 
@@ -550,6 +588,42 @@ OBJECT *o_complex_new_embedded(TOPLEVEL *toplevel,
   return new_node;
 }
 
+/*! \brief Create a complex object for a library symbol
+ *  \par Function Description
+ *  Creates a complex object using the component library symbol named
+ *  \a basename, the way it is done when reading a file: a placeholder
+ *  is used if there is no such symbol, and attributes eligible for
+ *  promotion inside the complex are deleted or hidden.
+ *
+ *  \param [in]  toplevel   The TOPLEVEL object
+ *  \param [in]  type       The type of the object (usually OBJ_COMPLEX)
+ *  \param [in]  x          The x location of the complex object
+ *  \param [in]  y          The y location of the complex object
+ *  \param [in]  angle      The rotation angle
+ *  \param [in]  mirror     The mirror status
+ *  \param [in]  basename   The name of the library symbol
+ *  \param [in]  selectable whether the object can be selected with the mouse
+ *  \return a new complex object
+ */
+OBJECT *o_complex_new_by_name (TOPLEVEL *toplevel, char type,
+                               int x, int y, int angle, int mirror,
+                               const gchar *basename, int selectable)
+{
+  const CLibSymbol *clib = s_clib_get_symbol_by_name (basename);
+  OBJECT *new_obj;
+
+  new_obj = o_complex_new(toplevel, type,
+                          DEFAULT_COLOR,
+                          x, y,
+                          angle, mirror, clib,
+                          basename, selectable);
+  /* Delete or hide attributes eligible for promotion inside the complex */
+  if (new_obj)
+    o_complex_remove_promotable_attribs (toplevel, new_obj);
+
+  return new_obj;
+}
+
 /*! \brief read a complex object from a char buffer
  *  \par Function Description
  *  This function reads a complex object from the buffer \a buf.
@@ -571,17 +645,32 @@ OBJECT *o_complex_read (TOPLEVEL *toplevel,
   int x1, y1;
   int angle;
 
-  char *basename = g_malloc (1 + strlen (buf));
+  char *basename;
+  const char *name_start;
+  const char *name_end;
 
   int selectable;
   int mirror;
 
-  if (sscanf(buf, "%c %d %d %d %d %d %s\n",
-	     &type, &x1, &y1, &selectable, &angle, &mirror, basename) != 7) {
+  if (o_read_scan_line (buf, &name_start, &type, 5,
+                        &x1, &y1, &selectable, &angle, &mirror) != 6) {
+    g_set_error(err, EDA_ERROR, EDA_ERROR_PARSE, _("Failed to parse complex object"));
+    return NULL;
+  }
+
+  /* The symbol name is the next whitespace delimited word */
+  while (g_ascii_isspace (*name_start)) name_start++;
+  for (name_end = name_start;
+       *name_end != '\0' && !g_ascii_isspace (*name_end);
+       name_end++);
+
+  if (name_end == name_start) {
     g_set_error(err, EDA_ERROR, EDA_ERROR_PARSE, _("Failed to parse complex object"));
     return NULL;
   }
 
+  basename = g_strndup (name_start, name_end - name_start);
+
   switch(angle) {
 
     case(0):
@@ -616,16 +705,8 @@ OBJECT *o_complex_read (TOPLEVEL *toplevel,
                                      selectable);
   } else {
 
-    const CLibSymbol *clib = s_clib_get_symbol_by_name (basename);
-
-    new_obj = o_complex_new(toplevel, type,
-                                DEFAULT_COLOR,
-                                x1, y1,
-                                angle, mirror, clib,
-                                basename, selectable);
-    /* Delete or hide attributes eligible for promotion inside the complex */
-    if (new_obj)
-      o_complex_remove_promotable_attribs (toplevel, new_obj);
+    new_obj = o_complex_new_by_name (toplevel, type, x1, y1, angle, mirror,
+                                     basename, selectable);
   }
 
   g_free (basename);
@@ -646,33 +727,52 @@ OBJECT *o_complex_read (TOPLEVEL *toplevel,
 gchar*
 geda_complex_object_to_buffer (const GedaObject *object)
 {
-  gchar *basename;
-  gchar *buffer;
+  GString *buffer;
 
   g_return_val_if_fail (object != NULL, NULL);
   g_return_val_if_fail (object->complex != NULL, NULL);
   g_return_val_if_fail ((object->type == OBJ_COMPLEX) ||
                         (object->type == OBJ_PLACEHOLDER), NULL);
 
-  basename = g_strdup_printf ("%s%s",
-                              object->complex_embedded ? "EMBEDDED" : "",
-                              object->complex_basename);
+  buffer = g_string_new (NULL);
+  geda_complex_object_append_to_buffer (object, buffer);
+
+  return g_string_free (buffer, FALSE);
+}
+
+/*! \brief Append a string representation of the complex object
+ *  \par Function Description
+ *  Appends the same text as geda_complex_object_to_buffer() to \a buffer,
+ *  without allocating a string for it.
+ *
+ *  \param [in]     object  The complex object
+ *  \param [in,out] buffer  The buffer to append to
+ */
+void
+geda_complex_object_append_to_buffer (const GedaObject *object, GString *buffer)
+{
+  g_return_if_fail (object != NULL);
+  g_return_if_fail (object->complex != NULL);
+  g_return_if_fail ((object->type == OBJ_COMPLEX) ||
+                    (object->type == OBJ_PLACEHOLDER));
 
   /* We force the object type to be output as OBJ_COMPLEX for both these object
    * types.
    */
-  buffer = g_strdup_printf ("%c %d %d %d %d %d %s",
-                            OBJ_COMPLEX,
-                            object->complex->x,
-                            object->complex->y,
-                            geda_object_get_selectable (object),
-                            object->complex->angle,
-                            object->complex->mirror,
-                            basename);
-
-  g_free (basename);
-
-  return buffer;
+  o_save_fields (buffer, OBJ_COMPLEX, 5,
+                 object->complex->x,
+                 object->complex->y,
+                 geda_object_get_selectable (object),
+                 object->complex->angle,
+                 object->complex->mirror);
+
+  g_string_append_c (buffer, ' ');
+  if (object->complex_embedded) {
+    g_string_append (buffer, "EMBEDDED");
+  }
+  if (object->complex_basename != NULL) {
+    g_string_append (buffer, object->complex_basename);
+  }
 }
 
 /*! \brief move a complex object
@@ -695,7 +795,7 @@ geda_complex_object_translate (GedaObject *object, int dx, int dy)
 
   geda_object_list_translate (object->complex->prim_objs, dx, dy);
 
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
 }
 
 /*! \brief Create a copy of a COMPLEX object
@@ -719,7 +819,7 @@ OBJECT *o_complex_copy(TOPLEVEL *toplevel, OBJECT *o_current)
   o_new->complex_basename = g_strdup(o_current->complex_basename);
   o_new->complex_embedded = o_current->complex_embedded;
 
-  o_new->complex = g_malloc0(sizeof(COMPLEX));
+  o_new->complex = geda_arena_alloc0 (sizeof(COMPLEX));
   o_new->complex->x = o_current->complex->x;
   o_new->complex->y = o_current->complex->y;
   o_new->complex->angle = o_current->complex->angle;
@@ -959,8 +1059,8 @@ o_complex_check_symversion(TOPLEVEL* toplevel, OBJECT* object)
   }
 
 #if DEBUG
-  printf("%s:\n\tinside: %.1f outside: %.1f\n\n", object->name,
-         inside_value, outside_value);
+  printf("%c.%d:\n\tinside: %.1f outside: %.1f\n\n", object->type,
+         object->sid, inside_value, outside_value);
 #endif
 
   /* symversion= is not present anywhere */
@@ -36,7 +36,7 @@
 GedaLine*
 geda_line_new ()
 {
-  return g_new0 (GedaLine, 1);
+  return geda_arena_alloc0 (sizeof (GedaLine));
 }
 
 /*! \brief Free memory associated with the line
@@ -46,7 +46,7 @@ geda_line_new ()
 void
 geda_line_free (GedaLine *line)
 {
-  g_free (line);
+  geda_arena_free (line);
 }
 
 /*! \brief Calculate the bounds of a line
@@ -142,7 +142,7 @@ geda_line_object_copy (TOPLEVEL *toplevel, OBJECT *o_current)
                      o_current->fill_pitch2,
                      o_current->fill_angle2);
 
-  o_current->w_bounds_valid_for = NULL;
+  new_obj->w_bounds_valid_for = NULL;
 
   return new_obj;
 }
@@ -343,7 +343,7 @@ geda_line_object_modify (TOPLEVEL *toplevel, OBJECT *object,
   }
 
   /* recalculate the bounding box */
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
   o_emit_change_notify (toplevel, object);
 }
 
@@ -386,8 +386,8 @@ OBJECT *o_line_read (TOPLEVEL *toplevel, const char buf[],
      * not handle the line type and the filling - here filling is irrelevant.
      * They are set to default.
      */
-    if (sscanf (buf, "%c %d %d %d %d %d\n", &type,
-		&x1, &y1, &x2, &y2, &color) != 6) {
+    if (o_read_scan_line (buf, NULL, &type, 5,
+                          &x1, &y1, &x2, &y2, &color) != 6) {
       g_set_error(err, EDA_ERROR, EDA_ERROR_PARSE, _("Failed to parse line object"));
       return NULL;
     }
@@ -403,9 +403,9 @@ OBJECT *o_line_read (TOPLEVEL *toplevel, const char buf[],
      * list of characters and numbers in plain ASCII on a single line.
      * The meaning of each item is described in the file format documentation.
      */
-      if (sscanf (buf, "%c %d %d %d %d %d %d %d %d %d %d\n", &type,
-		  &x1, &y1, &x2, &y2, &color,
-		  &line_width, &line_end, &line_type, &line_length, &line_space) != 11) {
+      if (o_read_scan_line (buf, NULL, &type, 10,
+                            &x1, &y1, &x2, &y2, &color,
+                            &line_width, &line_end, &line_type, &line_length, &line_space) != 11) {
         g_set_error(err, EDA_ERROR, EDA_ERROR_PARSE, _("Failed to parse line object"));
         return NULL;
       }
@@ -469,22 +469,44 @@ OBJECT *o_line_read (TOPLEVEL *toplevel, const char buf[],
 gchar*
 geda_line_object_to_buffer (const GedaObject *object)
 {
+  GString *buffer;
+
   g_return_val_if_fail (object != NULL, NULL);
   g_return_val_if_fail (object->line != NULL, NULL);
   g_return_val_if_fail (object->type == OBJ_LINE, NULL);
 
-  return g_strdup_printf ("%c %d %d %d %d %d %d %d %d %d %d",
-                          OBJ_LINE,
-                          geda_line_object_get_x0 (object),
-                          geda_line_object_get_y0 (object),
-                          geda_line_object_get_x1 (object),
-                          geda_line_object_get_y1 (object),
-                          geda_object_get_color (object),
-                          object->line_width,
-                          object->line_end,
-                          object->line_type,
-                          object->line_length,
-                          object->line_space);
+  buffer = g_string_new (NULL);
+  geda_line_object_append_to_buffer (object, buffer);
+
+  return g_string_free (buffer, FALSE);
+}
+
+/*! \brief Append a string representation of the line object
+ *  \par Function Description
+ *  Appends the same text as geda_line_object_to_buffer() to \a buffer,
+ *  without allocating a string for it.
+ *
+ *  \param [in]     object  The line object
+ *  \param [in,out] buffer  The buffer to append to
+ */
+void
+geda_line_object_append_to_buffer (const GedaObject *object, GString *buffer)
+{
+  g_return_if_fail (object != NULL);
+  g_return_if_fail (object->line != NULL);
+  g_return_if_fail (object->type == OBJ_LINE);
+
+  o_save_fields (buffer, OBJ_LINE, 10,
+                 geda_line_object_get_x0 (object),
+                 geda_line_object_get_y0 (object),
+                 geda_line_object_get_x1 (object),
+                 geda_line_object_get_y1 (object),
+                 geda_object_get_color (object),
+                 object->line_width,
+                 object->line_end,
+                 object->line_type,
+                 object->line_length,
+                 object->line_space);
 }
 
 /*! \brief Translate a line position in WORLD coordinates by a delta.
@@ -510,7 +532,7 @@ geda_line_object_translate (GedaObject *object, int dx, int dy)
   object->line->y[1] = object->line->y[1] + dy;
 
   /* Update bounding box */
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
 }
 
 /*! \brief Rotate Line OBJECT using WORLD coordinates.
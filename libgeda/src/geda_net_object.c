@@ -293,7 +293,7 @@ OBJECT *o_net_read (TOPLEVEL *toplevel, const char buf[],
   int x2, y2;
   int color;
 
-  if (sscanf (buf, "%c %d %d %d %d %d\n", &type, &x1, &y1, &x2, &y2, &color) != 6) {
+  if (o_read_scan_line (buf, NULL, &type, 5, &x1, &y1, &x2, &y2, &color) != 6) {
         g_set_error(err, EDA_ERROR, EDA_ERROR_PARSE, _("Failed to parse net object"));
     return NULL;
   }
@@ -325,17 +325,39 @@ OBJECT *o_net_read (TOPLEVEL *toplevel, const char buf[],
 gchar*
 geda_net_object_to_buffer (const GedaObject *object)
 {
+  GString *buffer;
+
   g_return_val_if_fail (object != NULL, NULL);
   g_return_val_if_fail (object->line != NULL, NULL);
   g_return_val_if_fail (object->type == OBJ_NET, NULL);
 
-  return g_strdup_printf ("%c %d %d %d %d %d",
-                          OBJ_NET,
-                          geda_net_object_get_x0 (object),
-                          geda_net_object_get_y0 (object),
-                          geda_net_object_get_x1 (object),
-                          geda_net_object_get_y1 (object),
-                          geda_object_get_color (object));
+  buffer = g_string_new (NULL);
+  geda_net_object_append_to_buffer (object, buffer);
+
+  return g_string_free (buffer, FALSE);
+}
+
+/*! \brief Append a string representation of the net object
+ *  \par Function Description
+ *  Appends the same text as geda_net_object_to_buffer() to \a buffer,
+ *  without allocating a string for it.
+ *
+ *  \param [in]     object  The net object
+ *  \param [in,out] buffer  The buffer to append to
+ */
+void
+geda_net_object_append_to_buffer (const GedaObject *object, GString *buffer)
+{
+  g_return_if_fail (object != NULL);
+  g_return_if_fail (object->line != NULL);
+  g_return_if_fail (object->type == OBJ_NET);
+
+  o_save_fields (buffer, OBJ_NET, 5,
+                 geda_net_object_get_x0 (object),
+                 geda_net_object_get_y0 (object),
+                 geda_net_object_get_x1 (object),
+                 geda_net_object_get_y1 (object),
+                 geda_object_get_color (object));
 }
 
 /*! \brief move a net object
@@ -360,7 +382,7 @@ geda_net_object_translate (GedaObject *object, int dx, int dy)
   object->line->y[1] = object->line->y[1] + dy;
 
   /* Update bounding box */
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
 }
 
 /*! \brief create a copy of a net object
@@ -560,6 +582,8 @@ static void o_net_consolidate_lowlevel (OBJECT *object,
     }
 
     object->attribs = g_list_concat (object->attribs, del_object->attribs);
+    o_attrib_invalidate_index (object);
+    o_attrib_invalidate_index (del_object);
 
     /* Don't free del_object->attribs as it's relinked into object's list */
     del_object->attribs = NULL;
@@ -590,7 +614,7 @@ static int o_net_consolidate_nomidpoint (OBJECT *object, int x, int y)
           conn->x == x && conn->y == y &&
           conn->type == CONN_MIDPOINT) {
 #if DEBUG
-        printf("Found one! %s\n", conn->other_object->name);
+        printf("Found one! %d\n", conn->other_object->sid);
 #endif
         return(FALSE);
       }
@@ -652,7 +676,7 @@ static int o_net_consolidate_segments (TOPLEVEL *toplevel, OBJECT *object)
             other_orient != NEITHER) {
 
 #if DEBUG
-          printf("consolidating %s to %s\n", object->name, other_object->name);
+          printf("consolidating %d to %d\n", object->sid, other_object->sid);
 #endif
 
           o_net_consolidate_lowlevel(object, other_object, other_orient);
@@ -670,7 +694,7 @@ static int o_net_consolidate_segments (TOPLEVEL *toplevel, OBJECT *object)
           }
 
           s_delete_object (toplevel, other_object);
-          object->w_bounds_valid_for = NULL;
+          geda_object_invalidate_bounds (object);
           s_conn_update_object (page, object);
           return(-1);
         }
@@ -740,5 +764,5 @@ geda_net_object_modify (TOPLEVEL *toplevel, OBJECT *object,
   object->line->x[whichone] = x;
   object->line->y[whichone] = y;
 
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
 }
@@ -54,8 +54,8 @@
 
 #include "libgeda_priv.h"
 
-/*! this is modified here and in o_list.c */
-int global_sid=0;
+/*! The id of the next object, allocated by geda_object_new_sid() */
+static gint global_sid=0;
 
 
 /*! \brief Get the color index of the object
@@ -101,6 +101,41 @@ geda_object_get_drawing_color (const GedaObject *object)
   return color;
 }
 
+/*! \brief Get the session-unique name of the object
+ *
+ *  The name is made from the type of the object and its sid, such as
+ *  "net.42", and is only meant for debugging output.  It is not stored
+ *  with the object, so that creating an object does not allocate it.
+ *
+ *  \param [in] object the object
+ *  \return the name of the object, which must be freed with g_free()
+ */
+gchar*
+geda_object_get_name (const GedaObject *object)
+{
+  const gchar *prefix;
+
+  g_return_val_if_fail (object != NULL, NULL);
+
+  switch (object->type) {
+    case OBJ_LINE:        prefix = "line";    break;
+    case OBJ_PATH:        prefix = "path";    break;
+    case OBJ_BOX:         prefix = "box";     break;
+    case OBJ_PICTURE:     prefix = "picture"; break;
+    case OBJ_CIRCLE:      prefix = "circle";  break;
+    case OBJ_NET:         prefix = "net";     break;
+    case OBJ_BUS:         prefix = "bus";     break;
+    case OBJ_COMPLEX:
+    case OBJ_PLACEHOLDER: prefix = "complex"; break;
+    case OBJ_TEXT:        prefix = "text";    break;
+    case OBJ_PIN:         prefix = "pin";     break;
+    case OBJ_ARC:         prefix = "arc";     break;
+    default:              prefix = "object";  break;
+  }
+
+  return g_strdup_printf ("%s.%d", prefix, object->sid);
+}
+
 /*! \brief Determines if the object can be selected
  *
  *  Locked is alternate terminology for not selectable.
@@ -134,36 +169,38 @@ geda_object_set_selectable (GedaObject *object, gboolean selectable)
 }
 
 static OBJECT*
-s_basic_init_object (OBJECT *new_node, int type, char const *name);
+s_basic_init_object (OBJECT *new_node, int type);
 
 /*! \brief Helper to allocate and initialise an object.
  *
  *  \par Function Description
- *  Allocates memory for an OBJECT and then calls s_basic_init_object() on it.
+ *  Allocates memory for an OBJECT, from the current arena of the thread
+ *  if there is one, and then calls s_basic_init_object() on it.
  *
  *  \param [in] type      The sub-type of the object to create; one of the OBJ_* constants.
- *  \param [in] prefix    The name prefix for the session-unique object name.
+ *  \param [in] prefix    Unused; the name of the object is derived from
+ *                        its type by geda_object_get_name().
  *  \return A pointer to the fully constructed OBJECT.
  */
 OBJECT*
 s_basic_new_object (int type, char const *prefix)
 {
-  return s_basic_init_object(g_malloc(sizeof (OBJECT)), type, prefix);
+  return s_basic_init_object(geda_arena_alloc0 (sizeof (OBJECT)), type);
 }
 
-/*! \todo Finish documentation!!!!
- *  \brief
+/*! \brief Copy an object without marking it.
  *  \par Function Description
- *  returns head !!!!!!!!!!!!!!!!!!!
- *  look at above.. this returns what was passed in!!!!
- *  copies selected to list_head (!! returns new list)
+ *  Copies \a selected like o_object_copy(), but leaves its
+ *  <B>copied_to</B> field alone and gives the copy an id of its own.
+ *  \a selected is not modified, so several threads may copy the same
+ *  object at once.
  *
  *  \param [in]  toplevel   The TOPLEVEL object.
- *  \param [in]  selected
- *  \return OBJECT pointer.
+ *  \param [in]  selected   The object to copy.
+ *  \return The new object.
  */
-OBJECT *o_object_copy (TOPLEVEL *toplevel,
-                       OBJECT *selected)
+OBJECT *o_object_copy_unmarked (TOPLEVEL *toplevel,
+                                OBJECT *selected)
 {
   OBJECT *new_obj;
 
@@ -223,6 +260,29 @@ OBJECT *o_object_copy (TOPLEVEL *toplevel,
       return NULL;
   }
 
+  return new_obj;
+}
+
+/*! \todo Finish documentation!!!!
+ *  \brief
+ *  \par Function Description
+ *  returns head !!!!!!!!!!!!!!!!!!!
+ *  look at above.. this returns what was passed in!!!!
+ *  copies selected to list_head (!! returns new list)
+ *
+ *  \param [in]  toplevel   The TOPLEVEL object.
+ *  \param [in]  selected
+ *  \return OBJECT pointer.
+ */
+OBJECT *o_object_copy (TOPLEVEL *toplevel,
+                       OBJECT *selected)
+{
+  OBJECT *new_obj = o_object_copy_unmarked (toplevel, selected);
+
+  if (new_obj == NULL) {
+    return NULL;
+  }
+
   /* Store a reference in the copied object to where it was copied.
    * Used to retain associations when copying attributes */
   selected->copied_to = new_obj;
@@ -256,64 +316,65 @@ s_delete_object(TOPLEVEL *toplevel, OBJECT *o_current)
       o_attrib_remove(toplevel, &o_current->attached_to->attribs, o_current);
     }
 
-    /* printf("sdeleting line\n"); */
-    geda_line_free (o_current->line);
-    o_current->line = NULL;
-
-    geda_path_free (o_current->path);
-    o_current->path = NULL;
+    /* Only the geometry matching the type of the object is set */
+    switch (o_current->type) {
+      case OBJ_LINE:
+      case OBJ_NET:
+      case OBJ_BUS:
+      case OBJ_PIN:
+        geda_line_free (o_current->line);
+        break;
 
-    /*	printf("sdeleting circle\n");*/
-    geda_circle_free (o_current->circle);
-    o_current->circle = NULL;
+      case OBJ_PATH:
+        geda_path_free (o_current->path);
+        break;
 
-    /*	printf("sdeleting arc\n");*/
-    geda_arc_free (o_current->arc);
-    o_current->arc = NULL;
+      case OBJ_CIRCLE:
+        geda_circle_free (o_current->circle);
+        break;
 
-    /*	printf("sdeleting box\n");*/
-    geda_box_free (o_current->box);
-    o_current->box = NULL;
+      case OBJ_ARC:
+        geda_arc_free (o_current->arc);
+        break;
 
-    geda_picture_free (o_current->picture);
-    o_current->picture = NULL;
+      case OBJ_BOX:
+        geda_box_free (o_current->box);
+        break;
 
-    if (o_current->text) {
-      /*printf("sdeleting text->string\n");*/
-      g_free(o_current->text->string);
-      o_current->text->string = NULL;
-      g_free(o_current->text->disp_string);
-      /*	printf("sdeleting text\n");*/
-      g_free(o_current->text);
-    }
-    o_current->text = NULL;
+      case OBJ_PICTURE:
+        geda_picture_free (o_current->picture);
+        break;
 
-    /*	printf("sdeleting name\n");*/
-    g_free(o_current->name);
-    o_current->name = NULL;
+      case OBJ_TEXT:
+        if (o_current->text) {
+          g_free(o_current->text->string);
+          g_free(o_current->text->disp_string);
+          geda_arena_free (o_current->text);
+        }
+        break;
 
+      case OBJ_COMPLEX:
+      case OBJ_PLACEHOLDER:
+        if (o_current->complex) {
+          if (o_current->complex->prim_objs) {
+            geda_object_list_delete (toplevel, o_current->complex->prim_objs);
+          }
+          geda_arena_free (o_current->complex);
+        }
+        break;
+    }
+    o_current->complex = NULL;
 
     /*	printf("sdeleting complex_basename\n");*/
     g_free(o_current->complex_basename);
     o_current->complex_basename = NULL;
 
-    if (o_current->complex) {
-
-      if (o_current->complex->prim_objs) {
-        /* printf("sdeleting complex->primitive_objects\n");*/
-        geda_object_list_delete (toplevel, o_current->complex->prim_objs);
-        o_current->complex->prim_objs = NULL;
-      }
-
-      g_free(o_current->complex);
-      o_current->complex = NULL;
-    }
-
+    /* This also frees the attribute index */
     o_attrib_detach_all (toplevel, o_current);
 
     s_weakref_notify (o_current, o_current->weak_refs);
 
-    g_free(o_current);	/* assuming it is not null */
+    geda_arena_free (o_current);	/* assuming it is not null */
 
     o_current=NULL;		/* misc clean up */
   }
@@ -457,7 +518,7 @@ void o_set_line_options(TOPLEVEL *toplevel, OBJECT *o_current,
   o_current->line_space  = space;
 
   /* Recalculate the object's bounding box */
-  o_current->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (o_current);
   o_emit_change_notify (toplevel, o_current);
 
 }
@@ -827,20 +888,49 @@ geda_object_shortest_distance_full (TOPLEVEL *toplevel, OBJECT *object,
  *  parents as having been invalidated and in need of an update. They
  *  will be recalculated next time the OBJECT's bounds are requested
  *  (e.g. via geda_object_calculate_visible_bounds() ).
- *  \param [in] toplevel
- *  \param [in] object
  *
- *  \todo Turn this into a macro?
+ *  If the top level object is on a page, the page's spatial index is
+ *  told to refile it, and so is its connection index if the object is
+ *  connectible, as its endpoints may have moved.
+ *
+ *  \param [in] object The object whose bounds have changed
  */
 void
-o_bounds_invalidate (TOPLEVEL *toplevel, GedaObject *object)
+geda_object_invalidate_bounds (GedaObject *object)
 {
   GedaObject *iter = object;
 
-  while (iter != NULL) {
+  g_return_if_fail (object != NULL);
+
+  while (TRUE) {
     iter->w_bounds_valid_for = NULL;
+
+    if (iter->parent == NULL) {
+      break;
+    }
     iter = iter->parent;
   }
+
+  if ((iter->page != NULL) && (iter->page->object_index != NULL)) {
+    geda_page_index_invalidate (iter->page->object_index, iter);
+  }
+
+  if (iter->page != NULL) {
+    s_conn_refile_object (iter->page, object);
+  }
+}
+
+/*! \brief Mark an OBJECT's cached bounds as invalid
+ *  \par Function Description
+ *  See geda_object_invalidate_bounds().
+ *
+ *  \param [in] toplevel
+ *  \param [in] object
+ */
+void
+o_bounds_invalidate (TOPLEVEL *toplevel, GedaObject *object)
+{
+  geda_object_invalidate_bounds (object);
 }
 
 
@@ -1228,6 +1318,22 @@ geda_object_calculate_visible_bounds (TOPLEVEL *toplevel,
   return 1;
 }
 
+/*! \brief Allocate a session-unique object id.
+ *  \par Function Description
+ *  Returns a new id for an object.  Objects may be created on several
+ *  threads at once, so the id is allocated atomically.
+ *
+ *  \return The new object id.
+ */
+int geda_object_new_sid (void)
+{
+#if GLIB_CHECK_VERSION(2,30,0)
+  return g_atomic_int_add (&global_sid, 1);
+#else
+  return g_atomic_int_exchange_and_add (&global_sid, 1);
+#endif
+}
+
 /*! \private
  *  \brief Initialize an already-allocated object.
  *  \par Function Description
@@ -1235,34 +1341,24 @@ geda_object_calculate_visible_bounds (TOPLEVEL *toplevel,
  *
  *  \param [in] new_node  A pointer to an allocated OBJECT
  *  \param [in] type      The object type; one of the OBJ_* constants.
- *  \param [in] name      A prefix for the object's session-unique name.
  *  \return A pointer to the initialized object.
  */
 static OBJECT*
-s_basic_init_object (OBJECT *new_node, int type, char const *name)
+s_basic_init_object (OBJECT *new_node, int type)
 {
   /* setup sid */
-  new_node->sid = global_sid++;
+  new_node->sid = geda_object_new_sid ();
   new_node->type = type;
 
-  /* Setup the name */
-  new_node->name = g_strdup_printf("%s.%d", name, new_node->sid);
-
   /* Don't associate with a page, initially */
   new_node->page = NULL;
+  new_node->page_link = NULL;
 
   /* Setup the bounding box */
   geda_bounds_init (&(new_node->bounds));
   new_node->w_bounds_valid_for = NULL;
 
-  /* Setup line/circle structs */
-  new_node->line = NULL;
-  new_node->path = NULL;
-  new_node->circle = NULL;
-  new_node->arc = NULL;
-  new_node->box = NULL;
-  new_node->picture = NULL;
-  new_node->text = NULL;
+  /* Setup line/circle structs, which share the same storage */
   new_node->complex = NULL;
 
   new_node->conn_list = NULL;
@@ -1276,8 +1372,6 @@ s_basic_init_object (OBJECT *new_node, int type, char const *name)
   new_node->selectable = TRUE;
   new_node->selected = FALSE;
 
-  new_node->bus_ripper_direction = 0;
-
   new_node->line_end = END_NONE;
   new_node->line_type = TYPE_SOLID;
   new_node->line_width = 0;
@@ -1290,11 +1384,13 @@ s_basic_init_object (OBJECT *new_node, int type, char const *name)
   new_node->fill_pitch2 = 0;
 
   new_node->attribs = NULL;
+  new_node->attrib_index = NULL;
   new_node->attached_to = NULL;
   new_node->copied_to = NULL;
   new_node->show_name_value = SHOW_NAME_VALUE;
   new_node->visibility = VISIBLE;
 
+  /* Buses set bus_ripper_direction, which shares these */
   new_node->pin_type = PIN_TYPE_NET;
   new_node->whichend = -1;
 
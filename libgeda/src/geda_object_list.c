@@ -30,12 +30,12 @@
 static const gchar*
 o_file_format_header ();
 
-static gchar*
-o_save_objects (const GList *object_list, gboolean save_attribs);
+static gboolean
+o_save_objects (const GList *object_list, gboolean save_attribs,
+                GString *buffer, GOutputStream *stream, GError **err);
 
-
-/*! global which is used in o_list_copy_all */
-extern int global_sid;
+/*! Amount of output collected before it is written to a stream */
+#define SAVE_BUFFER_SIZE 65536
 
 /*! \todo Finish function description!!!
  *  \brief
@@ -48,6 +48,10 @@ extern int global_sid;
  *  objects are unselected before they are copied and then reselected
  *  this is necessary to preserve the color info
  *
+ *  The copies are not recorded in the <B>copied_to</B> fields of the
+ *  objects in src_list, so unselected objects are not modified and
+ *  may be copied by several threads at once.
+ *
  *  \param [in] toplevel       The TOPLEVEL object.
  *  \param [in] src_list       The GList to copy from.
  *  \param [in] dest_list      The GList to copy to.
@@ -60,6 +64,8 @@ GList *o_glist_copy_all (TOPLEVEL *toplevel,
   const GList *src;
   GList *dest;
   OBJECT *src_object, *dst_object;
+  OBJECT *attached_to;
+  GHashTable *copies;
   int selected_save;
 
   src = src_list;
@@ -70,6 +76,9 @@ GList *o_glist_copy_all (TOPLEVEL *toplevel,
     return(NULL);
   }
 
+  /* Maps each object of src_list to its copy */
+  copies = g_hash_table_new (g_direct_hash, g_direct_equal);
+
   /* first do all NON text items */
   while(src != NULL) {
     src_object = (OBJECT *) src->data;
@@ -80,9 +89,10 @@ GList *o_glist_copy_all (TOPLEVEL *toplevel,
       o_selection_unselect (toplevel, src_object);
 
     if (src_object->type != OBJ_TEXT) {
-      dst_object = o_object_copy (toplevel, src_object);
-      dst_object->sid = global_sid++;
+      dst_object = o_object_copy_unmarked (toplevel, src_object);
+      dst_object->sid = geda_object_new_sid ();
       dest = g_list_prepend (dest, dst_object);
+      g_hash_table_insert (copies, src_object, dst_object);
     }
 
     /* reselect it */
@@ -104,17 +114,18 @@ GList *o_glist_copy_all (TOPLEVEL *toplevel,
       o_selection_unselect (toplevel, src_object);
 
     if (src_object->type == OBJ_TEXT) {
-      dst_object = o_object_copy (toplevel, src_object);
-      dst_object->sid = global_sid++;
+      dst_object = o_object_copy_unmarked (toplevel, src_object);
+      dst_object->sid = geda_object_new_sid ();
       dest = g_list_prepend (dest, dst_object);
 
-      if (src_object->attached_to != NULL &&
-          src_object->attached_to->copied_to != NULL) {
-        o_attrib_attach(toplevel, dst_object,
-                        src_object->attached_to->copied_to, FALSE);
+      attached_to = (src_object->attached_to == NULL) ? NULL :
+        g_hash_table_lookup (copies, src_object->attached_to);
+
+      if (attached_to != NULL) {
+        o_attrib_attach(toplevel, dst_object, attached_to, FALSE);
         /* handle slot= attribute, it's a special case */
         if (g_ascii_strncasecmp (dst_object->text->string, "slot=", 5) == 0)
-          s_slot_update_object (toplevel, src_object->attached_to->copied_to);
+          s_slot_update_object (toplevel, attached_to);
       }
     }
 
@@ -125,13 +136,7 @@ GList *o_glist_copy_all (TOPLEVEL *toplevel,
     src = g_list_next(src);
   }
 
-  /* Clean up dangling copied_to pointers */
-  src = src_list;
-  while(src != NULL) {
-    src_object = src->data;
-    src_object->copied_to = NULL;
-    src = g_list_next (src);
-  }
+  g_hash_table_destroy (copies);
 
   /* Reverse the list to be in the correct order */
   dest = g_list_reverse (dest);
@@ -174,12 +179,15 @@ geda_object_list_print (GList *objects)
 {
   OBJECT *o_current=NULL;
   GList *iter;
+  gchar *name;
 
   iter = objects;
   printf("TRYING to PRINT\n");
   while (iter != NULL) {
     o_current = (OBJECT *)iter->data;
-    printf("Name: %s\n", o_current->name);
+    name = geda_object_get_name (o_current);
+    printf("Name: %s\n", name);
+    g_free (name);
     printf("Type: %d\n", o_current->type);
     printf("Sid: %d\n", o_current->sid);
 
@@ -304,16 +312,49 @@ geda_object_list_set_selectable (const GList *objects, gboolean selectable)
 gchar*
 geda_object_list_to_buffer (const GList *objects)
 {
-  GString *acc;
-  gchar *buffer;
+  GString *buffer;
+
+  buffer = g_string_new (o_file_format_header());
+
+  if (!o_save_objects (objects, FALSE, buffer, NULL, NULL)) {
+    g_string_free (buffer, TRUE);
+    return NULL;
+  }
+
+  return g_string_free (buffer, FALSE);
+}
+
+/*! \brief Save a file to an output stream
+ *  \par Function Description
+ *  This function writes a whole schematic to \a stream in libgeda
+ *  format.  The objects are written as they are formatted, through a
+ *  buffer of limited size, so the text of the whole schematic is never
+ *  held in memory at once.  The stream is not closed.
+ *
+ *  \param [in]     objects The head of a GList of OBJECTs to save.
+ *  \param [in]     stream  The stream to write to.
+ *  \param [in,out] err     #GError structure for error reporting, or
+ *                          NULL to disable error reporting
+ *  \returns TRUE on success, FALSE on failure.
+ */
+gboolean
+geda_object_list_to_stream (const GList *objects, GOutputStream *stream,
+                            GError **err)
+{
+  GString *buffer;
+  gboolean result;
 
-  acc = g_string_new (o_file_format_header());
+  g_return_val_if_fail (G_IS_OUTPUT_STREAM (stream), FALSE);
 
-  buffer = o_save_objects (objects, FALSE);
-  g_string_append (acc, buffer);
-  g_free (buffer);
+  buffer = g_string_sized_new (SAVE_BUFFER_SIZE);
+  g_string_append (buffer, o_file_format_header());
 
-  return g_string_free (acc, FALSE);
+  result = (o_save_objects (objects, FALSE, buffer, stream, err) &&
+            g_output_stream_write_all (stream, buffer->str, buffer->len,
+                                       NULL, NULL, err));
+
+  g_string_free (buffer, TRUE);
+  return result;
 }
 
 /*! \brief Get the file header string.
@@ -335,32 +376,38 @@ static const gchar
   return header;
 }
 
-/*! \brief Save a series of objects into a string buffer
+/*! \brief Save a series of objects
  *  \par Function Description
- *  This function recursively saves a set of objects into a buffer in
- *  libgeda format.  User code should not normally call this function;
- *  they should call o_save_buffer() instead.
+ *  This function recursively saves a set of objects in libgeda format,
+ *  appending the text of each object to \a buffer.  User code should
+ *  not normally call this function; they should call
+ *  geda_object_list_to_buffer() or geda_object_list_to_stream()
+ *  instead.
+ *
+ *  If \a stream is not NULL, the contents of \a buffer are written to
+ *  it and the buffer emptied whenever it grows beyond
+ *  #SAVE_BUFFER_SIZE.  The caller must write what remains in the
+ *  buffer at the end.
  *
  *  With save_attribs passed as FALSE, attribute objects are skipped over,
  *  and saved separately - after the objects they are attached to. When
  *  we recurse for saving out those attributes, the function must be called
  *  with save_attribs passed as TRUE.
  *
- *  \param [in] toplevel      A TOPLEVEL structure.
- *  \param [in] object_list   The head of a GList of objects to save.
- *  \param [in] save_attribs  Should attribute objects encounterd be saved?
- *  \returns a buffer containing schematic data or NULL on failure.
+ *  \param [in]     object_list   The head of a GList of objects to save.
+ *  \param [in]     save_attribs  Should attribute objects encounterd be saved?
+ *  \param [in,out] buffer        The buffer to append to.
+ *  \param [in]     stream        The stream to write to, or NULL.
+ *  \param [in,out] err           #GError structure for error reporting, or
+ *                                NULL to disable error reporting
+ *  \returns TRUE on success, FALSE on failure.
  */
-static gchar*
-o_save_objects (const GList *object_list, gboolean save_attribs)
+static gboolean
+o_save_objects (const GList *object_list, gboolean save_attribs,
+                GString *buffer, GOutputStream *stream, GError **err)
 {
   OBJECT *o_current;
   const GList *iter;
-  gchar *out;
-  GString *acc;
-  gboolean already_wrote = FALSE;
-
-  acc = g_string_new("");
 
   iter = object_list;
 
@@ -372,64 +419,62 @@ o_save_objects (const GList *object_list, gboolean save_attribs)
       switch (o_current->type) {
 
         case(OBJ_LINE):
-          out = geda_line_object_to_buffer (o_current);
+          geda_line_object_append_to_buffer (o_current, buffer);
           break;
 
         case(OBJ_NET):
-          out = geda_net_object_to_buffer (o_current);
+          geda_net_object_append_to_buffer (o_current, buffer);
           break;
 
         case(OBJ_BUS):
-          out = geda_bus_object_to_buffer (o_current);
+          geda_bus_object_append_to_buffer (o_current, buffer);
           break;
 
         case(OBJ_BOX):
-          out = geda_box_object_to_buffer (o_current);
+          geda_box_object_append_to_buffer (o_current, buffer);
           break;
 
         case(OBJ_CIRCLE):
-          out = geda_circle_object_to_buffer (o_current);
+          geda_circle_object_append_to_buffer (o_current, buffer);
           break;
 
         case(OBJ_COMPLEX):
-          out = geda_complex_object_to_buffer (o_current);
-          g_string_append_printf(acc, "%s\n", out);
-          already_wrote = TRUE;
-          g_free(out); /* need to free here because of the above flag */
+          geda_complex_object_append_to_buffer (o_current, buffer);
 
           if (o_complex_is_embedded(o_current)) {
-            g_string_append(acc, "[\n");
+            g_string_append (buffer, "\n[\n");
 
-            out = o_save_objects(o_current->complex->prim_objs, FALSE);
-            g_string_append (acc, out);
-            g_free(out);
+            if (!o_save_objects (o_current->complex->prim_objs, FALSE,
+                                 buffer, stream, err)) {
+              return FALSE;
+            }
 
-            g_string_append(acc, "]\n");
+            g_string_append_c (buffer, ']');
           }
           break;
 
         case(OBJ_PLACEHOLDER):  /* new type by SDB 1.20.2005 */
-          out = geda_complex_object_to_buffer (o_current);
+          geda_complex_object_append_to_buffer (o_current, buffer);
           break;
 
         case(OBJ_TEXT):
-          out = geda_text_object_to_buffer (o_current);
+          geda_text_object_append_to_buffer (o_current, buffer);
           break;
 
         case(OBJ_PATH):
-          out = geda_path_object_to_buffer (o_current);
+          geda_path_object_append_to_buffer (o_current, buffer);
           break;
 
         case(OBJ_PIN):
-          out = geda_pin_object_to_buffer (o_current);
+          geda_pin_object_append_to_buffer (o_current, buffer);
           break;
 
         case(OBJ_ARC):
-          out = geda_arc_object_to_buffer (o_current);
+          geda_arc_object_append_to_buffer (o_current, buffer);
           break;
 
         case(OBJ_PICTURE):
-          out = geda_picture_object_to_buffer (o_current);
+          geda_picture_object_append_to_buffer (o_current, buffer);
           break;
 
         default:
@@ -439,35 +484,37 @@ o_save_objects (const GList *object_list, gboolean save_attribs)
            *  do... */
           g_critical (_("o_save_objects: object %p has unknown type '%c'\n"),
                       o_current, o_current->type);
-          /* Dump string built so far */
-          g_string_free (acc, TRUE);
-          return NULL;
+          g_set_error (err, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                       _("Object has unknown type '%c'"), o_current->type);
+          return FALSE;
       }
 
-      /* output the line */
-      if (!already_wrote) {
-        g_string_append_printf(acc, "%s\n", out);
-        g_free(out);
-      } else {
-        already_wrote = FALSE;
-      }
+      /* end the line */
+      g_string_append_c (buffer, '\n');
 
       /* save any attributes */
       if (o_current->attribs != NULL) {
-        g_string_append (acc, "{\n");
+        g_string_append (buffer, "{\n");
+
+        if (!o_save_objects (o_current->attribs, TRUE, buffer, stream, err)) {
+          return FALSE;
+        }
 
-        out = o_save_objects (o_current->attribs, TRUE);
-        g_string_append (acc, out);
-        g_free(out);
+        g_string_append (buffer, "}\n");
+      }
 
-        g_string_append (acc, "}\n");
+      /* pass on what has been collected so far */
+      if (stream != NULL && buffer->len >= SAVE_BUFFER_SIZE) {
+        if (!g_output_stream_write_all (stream, buffer->str, buffer->len,
+                                        NULL, NULL, err)) {
+          return FALSE;
+        }
+        g_string_truncate (buffer, 0);
       }
     }
 
     iter = g_list_next (iter);
   }
 
-  return g_string_free (acc, FALSE);
+  return TRUE;
 }
-
-
@@ -54,18 +54,57 @@
 
 static gint global_pid = 0;
 
-/* Called just before removing an OBJECT from a PAGE
- * or after appending an OBJECT to a PAGE. */
+/* Set up the parent page pointer of an OBJECT being added to a PAGE. */
 static void
-object_added (TOPLEVEL *toplevel, PAGE *page, OBJECT *object)
+set_object_page (PAGE *page, OBJECT *object)
 {
-  /* Set up object parent pointer */
 #ifndef NDEBUG
   if (object->page != NULL) {
     g_critical ("Object %p already has parent page %p!", object, object->page);
   }
 #endif
   object->page = page;
+}
+
+/* Link an OBJECT to the end of a PAGE's object list in constant time. */
+static void
+link_object (PAGE *page, OBJECT *object)
+{
+  GList *link = g_list_alloc ();
+
+  link->data = object;
+  link->prev = page->_object_list_tail;
+
+  if (page->_object_list_tail != NULL) {
+    page->_object_list_tail->next = link;
+  } else {
+    page->_object_list = link;
+  }
+
+  page->_object_list_tail = link;
+  object->page_link = link;
+}
+
+/* Unlink an OBJECT from a PAGE's object list in constant time. */
+static void
+unlink_object (PAGE *page, OBJECT *object)
+{
+  GList *link = object->page_link;
+
+  if (link == page->_object_list_tail) {
+    page->_object_list_tail = link->prev;
+  }
+
+  page->_object_list = g_list_delete_link (page->_object_list, link);
+  object->page_link = NULL;
+}
+
+/* Called just before removing an OBJECT from a PAGE
+ * or after appending an OBJECT to a PAGE. */
+static void
+object_added (TOPLEVEL *toplevel, PAGE *page, OBJECT *object)
+{
+  set_object_page (page, object);
 
   /* Update object connection tracking */
   s_conn_update_object (page, object);
@@ -134,9 +173,14 @@ PAGE *s_page_new (TOPLEVEL *toplevel, const gchar *filename)
 
   /* Init connectible objects array */
   page->connectible_list = NULL;
+  page->conn_index = s_conn_index_new ();
 
   /* Init the object list */
   page->_object_list = NULL;
+  page->_object_list_tail = NULL;
+
+  /* Init the spatial index of the objects */
+  page->object_index = geda_page_index_new (toplevel);
 
   /* new selection mechanism */
   page->selection_list = o_selection_new();
@@ -239,6 +283,12 @@ void s_page_delete (TOPLEVEL *toplevel, PAGE *page)
   g_list_free (page->connectible_list);
   page->connectible_list = NULL;
 
+  s_conn_index_free (page->conn_index);
+  page->conn_index = NULL;
+
+  geda_page_index_free (page->object_index);
+  page->object_index = NULL;
+
   /* free current page undo structs */
   s_undo_free_all (toplevel, page);
 
@@ -624,7 +674,8 @@ gint s_page_autosave (TOPLEVEL *toplevel)
  */
 void s_page_append (TOPLEVEL *toplevel, PAGE *page, OBJECT *object)
 {
-  page->_object_list = g_list_append (page->_object_list, object);
+  link_object (page, object);
+  geda_page_index_add (page->object_index, object);
   object_added (toplevel, page, object);
 }
 
@@ -634,6 +685,10 @@ void s_page_append (TOPLEVEL *toplevel, PAGE *page, OBJECT *object)
  *  Links the passed OBJECT GList to the end of the PAGE's
  *  object_list.
  *
+ *  The connections of the objects are built in a single pass once
+ *  they have all been linked to the page, which is much cheaper than
+ *  appending them one at a time when loading a page.
+ *
  *  \param [in] toplevel  The TOPLEVEL object.
  *  \param [in] page      The PAGE the objects are being added to.
  *  \param [in] obj_list  The OBJECT list being added to the page.
@@ -641,9 +696,31 @@ void s_page_append (TOPLEVEL *toplevel, PAGE *page, OBJECT *object)
 void s_page_append_list (TOPLEVEL *toplevel, PAGE *page, GList *obj_list)
 {
   GList *iter;
-  page->_object_list = g_list_concat (page->_object_list, obj_list);
+
+  if (obj_list == NULL) {
+    return;
+  }
+
+  /* Link the list after the last object, without walking the page */
+  if (page->_object_list_tail != NULL) {
+    page->_object_list_tail->next = obj_list;
+    obj_list->prev = page->_object_list_tail;
+  } else {
+    page->_object_list = obj_list;
+  }
+
   for (iter = obj_list; iter != NULL; iter = g_list_next (iter)) {
-    object_added (toplevel, page, iter->data);
+    ((OBJECT*) iter->data)->page_link = iter;
+    page->_object_list_tail = iter;
+    geda_page_index_add (page->object_index, iter->data);
+    set_object_page (page, iter->data);
+  }
+
+  /* Deferred update of the connection tracking */
+  s_conn_update_glist (page, obj_list);
+
+  for (iter = obj_list; iter != NULL; iter = g_list_next (iter)) {
+    o_emit_change_notify (toplevel, iter->data);
   }
 }
 
@@ -659,8 +736,14 @@ void s_page_append_list (TOPLEVEL *toplevel, PAGE *page, GList *obj_list)
  */
 void s_page_remove (TOPLEVEL *toplevel, PAGE *page, OBJECT *object)
 {
+  gboolean on_page = (object->page == page && object->page_link != NULL);
+
   pre_object_removed (toplevel, page, object);
-  page->_object_list = g_list_remove (page->_object_list, object);
+  geda_page_index_remove (page->object_index, object);
+
+  if (on_page) {
+    unlink_object (page, object);
+  }
 }
 
 /*! \brief Replace an OBJECT in a PAGE, in the same list position.
@@ -679,7 +762,7 @@ void
 s_page_replace (TOPLEVEL *toplevel, PAGE *page,
                 OBJECT *object1, OBJECT *object2)
 {
-  GList *iter = g_list_find (page->_object_list, object1);
+  GList *iter = (GList*) s_page_object_link (page, object1);
 
   /* If object1 not found, append object2 */
   if (iter == NULL) {
@@ -689,6 +772,9 @@ s_page_replace (TOPLEVEL *toplevel, PAGE *page,
 
   pre_object_removed (toplevel, page, object1);
   iter->data = object2;
+  object1->page_link = NULL;
+  object2->page_link = iter;
+  geda_page_index_replace (page->object_index, object1, object2);
   object_added (toplevel, page, object2);
 }
 
@@ -706,8 +792,11 @@ void s_page_delete_objects (TOPLEVEL *toplevel, PAGE *page)
   GList *iter;
   for (iter = objects; iter != NULL; iter = g_list_next (iter)) {
     pre_object_removed (toplevel, page, iter->data);
+    geda_page_index_remove (page->object_index, iter->data);
+    ((OBJECT*) iter->data)->page_link = NULL;
   }
   page->_object_list = NULL;
+  page->_object_list_tail = NULL;
   geda_object_list_delete (toplevel, objects);
 }
 
@@ -728,6 +817,32 @@ const GList *s_page_objects (PAGE *page)
   return page->_object_list;
 }
 
+/*! \brief Find the link of an OBJECT in the PAGE's GList of objects
+ *
+ *  \par Function Description
+ *  Finds the element of the GList returned by s_page_objects() which
+ *  holds \a object, without searching the list.
+ *
+ *  NB: This GList is owned by the PAGE, and must not be
+ *      free'd or modified by the caller.
+ *
+ *  \param [in] page    The PAGE to look in.
+ *  \param [in] object  The OBJECT to find.
+ *  \returns the list element holding \a object, or NULL if \a object
+ *           is not on \a page.
+ */
+const GList *s_page_object_link (PAGE *page, OBJECT *object)
+{
+  g_return_val_if_fail (page != NULL, NULL);
+  g_return_val_if_fail (object != NULL, NULL);
+
+  if (object->page != page) {
+    return NULL;
+  }
+
+  return object->page_link;
+}
+
 
 /*! \brief Find the objects in a given region
  *
@@ -771,11 +886,18 @@ GList *s_page_objects_in_region (TOPLEVEL *toplevel, PAGE *page,
 GList *s_page_objects_in_regions (TOPLEVEL *toplevel, PAGE *page,
                                   BOX *rects, int n_rects)
 {
+  GList *candidates;
   GList *iter;
   GList *list = NULL;
   int i;
 
-  for (iter = page->_object_list; iter != NULL; iter = g_list_next (iter)) {
+  /* Narrow the search down using the spatial index, if possible */
+  if (!geda_page_index_query (toplevel, page->object_index,
+                              rects, n_rects, &candidates)) {
+    candidates = g_list_copy (page->_object_list);
+  }
+
+  for (iter = candidates; iter != NULL; iter = g_list_next (iter)) {
     OBJECT *object = iter->data;
     int left, top, right, bottom;
     int visible;
@@ -795,6 +917,8 @@ GList *s_page_objects_in_regions (TOPLEVEL *toplevel, PAGE *page,
     }
   }
 
+  g_list_free (candidates);
+
   list = g_list_reverse (list);
   return list;
 }
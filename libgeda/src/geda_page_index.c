@@ -0,0 +1,549 @@
+/* gEDA - GPL Electronic Design Automation
+ * libgeda - gEDA's library
+ * Copyright (C) 1998-2010 Ales Hvezda
+ * Copyright (C) 1998-2010 gEDA Contributors (see ChangeLog for details)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*! \file geda_page_index.c
+ *  \brief Spatial index of the objects on a page
+ *
+ *  The world is divided into square cells of #INDEX_CELL_SIZE, and
+ *  each cell is hashed into one of #INDEX_BUCKET_COUNT buckets. Every
+ *  top level object of a page is filed in the buckets of the cells
+ *  its bounds overlap, so that a region query only needs to look at
+ *  the objects near the region instead of every object on the page.
+ *
+ *  Objects covering too many cells (e.g. title blocks) are kept on a
+ *  separate list which every query examines. Objects without visible
+ *  bounds are not filed at all.
+ *
+ *  The index never calculates bounds when an object changes. The
+ *  object is only marked stale by geda_page_index_invalidate(), and
+ *  stale objects are filed again just before the next query.
+ */
+
+#include <config.h>
+
+#include "libgeda_priv.h"
+
+/*! Width and height of an index cell in world units */
+#define INDEX_CELL_SIZE (1000)
+
+/*! Number of hash buckets the cells are distributed over */
+#define INDEX_BUCKET_COUNT (4096)
+
+/*! Objects covering more cells than this are not filed in buckets */
+#define INDEX_MAX_CELLS (64)
+
+typedef enum {
+  ENTRY_STALE,   /* waiting to be filed */
+  ENTRY_HIDDEN,  /* no visible bounds, not filed */
+  ENTRY_BUCKETS, /* filed in the buckets of its cells */
+  ENTRY_LARGE    /* filed on the list of large objects */
+} IndexEntryState;
+
+typedef struct _IndexEntry IndexEntry;
+
+struct _IndexEntry
+{
+  OBJECT *object;
+  IndexEntryState state;
+
+  /* bounds the entry was filed with */
+  GedaBounds bounds;
+
+  /* link in the stale or the large queue */
+  GList *link;
+
+  /* position of the object in the page's object list */
+  guint order;
+
+  /* stamp of the last query which visited this entry */
+  guint visit;
+};
+
+struct _GedaPageIndex
+{
+  TOPLEVEL *toplevel;
+
+  /* OBJECT -> IndexEntry */
+  GHashTable *entries;
+
+  GPtrArray *buckets[INDEX_BUCKET_COUNT];
+  GQueue large;
+  GQueue stale;
+
+  guint next_order;
+  guint visit;
+
+  /* settings the filed bounds were calculated with */
+  int show_hidden_text;
+  RenderedBoundsFunc rendered_text_bounds_func;
+  void *rendered_text_bounds_data;
+};
+
+
+/*! \brief Get the cell containing a world coordinate
+ */
+static inline gint
+index_cell (gint coord)
+{
+  /* round towards negative infinity */
+  if (coord < 0) {
+    return -1 - ((-1 - coord) / INDEX_CELL_SIZE);
+  }
+  return coord / INDEX_CELL_SIZE;
+}
+
+/*! \brief Get the bucket of a cell
+ */
+static inline GPtrArray*
+index_bucket (GedaPageIndex *index, gint cell_x, gint cell_y)
+{
+  guint hash = ((guint) cell_x * 73856093U) ^ ((guint) cell_y * 19349663U);
+
+  return index->buckets[hash % INDEX_BUCKET_COUNT];
+}
+
+/*! \brief Get the number of cells overlapped by some bounds
+ */
+static gint64
+index_cell_count (const GedaBounds *bounds)
+{
+  gint64 width  = (gint64) index_cell (bounds->max_x) - index_cell (bounds->min_x) + 1;
+  gint64 height = (gint64) index_cell (bounds->max_y) - index_cell (bounds->min_y) + 1;
+
+  return width * height;
+}
+
+/*! \brief Remove an entry from wherever it is filed
+ */
+static void
+index_entry_unfile (GedaPageIndex *index, IndexEntry *entry)
+{
+  gint cell_x, cell_y;
+
+  switch (entry->state) {
+    case ENTRY_STALE:
+      g_queue_delete_link (&index->stale, entry->link);
+      break;
+
+    case ENTRY_LARGE:
+      g_queue_delete_link (&index->large, entry->link);
+      break;
+
+    case ENTRY_BUCKETS:
+      for (cell_y = index_cell (entry->bounds.min_y);
+           cell_y <= index_cell (entry->bounds.max_y);
+           cell_y++) {
+        for (cell_x = index_cell (entry->bounds.min_x);
+             cell_x <= index_cell (entry->bounds.max_x);
+             cell_x++) {
+          g_ptr_array_remove_fast (index_bucket (index, cell_x, cell_y), entry);
+        }
+      }
+      break;
+
+    case ENTRY_HIDDEN:
+      break;
+  }
+
+  entry->link = NULL;
+}
+
+/*! \brief Mark an entry as needing to be filed again
+ */
+static void
+index_entry_mark_stale (GedaPageIndex *index, IndexEntry *entry)
+{
+  if (entry->state == ENTRY_STALE) {
+    return;
+  }
+
+  index_entry_unfile (index, entry);
+
+  g_queue_push_tail (&index->stale, entry);
+  entry->link = g_queue_peek_tail_link (&index->stale);
+  entry->state = ENTRY_STALE;
+}
+
+/*! \brief File a stale entry using the current bounds of its object
+ */
+static void
+index_entry_file (GedaPageIndex *index, IndexEntry *entry)
+{
+  gint cell_x, cell_y;
+  int visible;
+
+  g_return_if_fail (entry->state == ENTRY_STALE);
+
+  g_queue_delete_link (&index->stale, entry->link);
+  entry->link = NULL;
+
+  visible = geda_object_calculate_visible_bounds (index->toplevel,
+                                                  entry->object,
+                                                  &entry->bounds.min_x,
+                                                  &entry->bounds.min_y,
+                                                  &entry->bounds.max_x,
+                                                  &entry->bounds.max_y);
+
+  if (!visible || geda_bounds_empty (&entry->bounds)) {
+    entry->state = ENTRY_HIDDEN;
+  }
+  else if (index_cell_count (&entry->bounds) > INDEX_MAX_CELLS) {
+    g_queue_push_tail (&index->large, entry);
+    entry->link = g_queue_peek_tail_link (&index->large);
+    entry->state = ENTRY_LARGE;
+  }
+  else {
+    for (cell_y = index_cell (entry->bounds.min_y);
+         cell_y <= index_cell (entry->bounds.max_y);
+         cell_y++) {
+      for (cell_x = index_cell (entry->bounds.min_x);
+           cell_x <= index_cell (entry->bounds.max_x);
+           cell_x++) {
+        g_ptr_array_add (index_bucket (index, cell_x, cell_y), entry);
+      }
+    }
+    entry->state = ENTRY_BUCKETS;
+  }
+}
+
+static void
+index_entry_free (IndexEntry *entry)
+{
+  g_slice_free (IndexEntry, entry);
+}
+
+/*! \brief File all stale entries of the index
+ *  \par Function Description
+ *  If the settings which affect visible bounds have changed since the
+ *  index was last refreshed, every entry is filed again.
+ */
+static void
+index_refresh (GedaPageIndex *index)
+{
+  TOPLEVEL *toplevel = index->toplevel;
+
+  if ((index->show_hidden_text != toplevel->show_hidden_text) ||
+      (index->rendered_text_bounds_func != toplevel->rendered_text_bounds_func) ||
+      (index->rendered_text_bounds_data != toplevel->rendered_text_bounds_data)) {
+
+    GHashTableIter iter;
+    gpointer value;
+
+    g_hash_table_iter_init (&iter, index->entries);
+    while (g_hash_table_iter_next (&iter, NULL, &value)) {
+      index_entry_mark_stale (index, (IndexEntry*) value);
+    }
+
+    index->show_hidden_text = toplevel->show_hidden_text;
+    index->rendered_text_bounds_func = toplevel->rendered_text_bounds_func;
+    index->rendered_text_bounds_data = toplevel->rendered_text_bounds_data;
+  }
+
+  while (!g_queue_is_empty (&index->stale)) {
+    index_entry_file (index, (IndexEntry*) g_queue_peek_head (&index->stale));
+  }
+}
+
+/*! \brief Add an entry to a query result, unless already added
+ */
+static inline void
+index_visit (GedaPageIndex *index, IndexEntry *entry, GPtrArray *found)
+{
+  if (entry->visit != index->visit) {
+    entry->visit = index->visit;
+    g_ptr_array_add (found, entry);
+  }
+}
+
+/*! \brief Compare entries by their position on the page
+ */
+static gint
+index_entry_compare_order (gconstpointer a, gconstpointer b)
+{
+  const IndexEntry *entry_a = *((const IndexEntry**) a);
+  const IndexEntry *entry_b = *((const IndexEntry**) b);
+
+  if (entry_a->order < entry_b->order) {
+    return -1;
+  }
+  return (entry_a->order > entry_b->order) ? 1 : 0;
+}
+
+/*! \brief Create a spatial index for the objects of a page
+ *
+ *  \param [in] toplevel  The TOPLEVEL whose bounds will be indexed.
+ *  \return A new, empty index. Free it with geda_page_index_free().
+ */
+GedaPageIndex*
+geda_page_index_new (TOPLEVEL *toplevel)
+{
+  GedaPageIndex *index;
+  gint i;
+
+  g_return_val_if_fail (toplevel != NULL, NULL);
+
+  index = g_new0 (GedaPageIndex, 1);
+
+  index->toplevel = toplevel;
+  index->entries = g_hash_table_new_full (g_direct_hash,
+                                          g_direct_equal,
+                                          NULL,
+                                          (GDestroyNotify) index_entry_free);
+
+  for (i = 0; i < INDEX_BUCKET_COUNT; i++) {
+    index->buckets[i] = g_ptr_array_new ();
+  }
+
+  g_queue_init (&index->large);
+  g_queue_init (&index->stale);
+
+  index->show_hidden_text = toplevel->show_hidden_text;
+  index->rendered_text_bounds_func = toplevel->rendered_text_bounds_func;
+  index->rendered_text_bounds_data = toplevel->rendered_text_bounds_data;
+
+  return index;
+}
+
+/*! \brief Free a page index
+ *
+ *  \param [in] index  The index to free.
+ */
+void
+geda_page_index_free (GedaPageIndex *index)
+{
+  gint i;
+
+  if (index == NULL) {
+    return;
+  }
+
+  for (i = 0; i < INDEX_BUCKET_COUNT; i++) {
+    g_ptr_array_free (index->buckets[i], TRUE);
+  }
+
+  g_queue_clear (&index->large);
+  g_queue_clear (&index->stale);
+
+  g_hash_table_destroy (index->entries);
+
+  g_free (index);
+}
+
+/*! \brief Add an object to the end of the page index
+ *
+ *  The object is filed lazily, when the index is next queried.
+ *
+ *  \param [in] index   The page index.
+ *  \param [in] object  The top level object appended to the page.
+ */
+void
+geda_page_index_add (GedaPageIndex *index, OBJECT *object)
+{
+  IndexEntry *entry;
+
+  g_return_if_fail (index != NULL);
+  g_return_if_fail (object != NULL);
+  g_return_if_fail (g_hash_table_lookup (index->entries, object) == NULL);
+
+  entry = g_slice_new0 (IndexEntry);
+  entry->object = object;
+  entry->order = index->next_order++;
+
+  /* mark_stale() unfiles first, so start from a state needing nothing */
+  entry->state = ENTRY_HIDDEN;
+  index_entry_mark_stale (index, entry);
+
+  g_hash_table_insert (index->entries, object, entry);
+}
+
+/*! \brief Remove an object from the page index
+ *
+ *  \param [in] index   The page index.
+ *  \param [in] object  The object being removed from the page.
+ */
+void
+geda_page_index_remove (GedaPageIndex *index, OBJECT *object)
+{
+  IndexEntry *entry;
+
+  g_return_if_fail (index != NULL);
+  g_return_if_fail (object != NULL);
+
+  entry = g_hash_table_lookup (index->entries, object);
+
+  if (entry != NULL) {
+    index_entry_unfile (index, entry);
+    g_hash_table_remove (index->entries, object);
+  }
+}
+
+/*! \brief Replace an object in the page index, keeping its position
+ *
+ *  \param [in] index    The page index.
+ *  \param [in] object1  The object being removed from the page.
+ *  \param [in] object2  The object taking its place.
+ */
+void
+geda_page_index_replace (GedaPageIndex *index, OBJECT *object1, OBJECT *object2)
+{
+  IndexEntry *entry;
+
+  g_return_if_fail (index != NULL);
+  g_return_if_fail (object1 != NULL);
+  g_return_if_fail (object2 != NULL);
+
+  entry = g_hash_table_lookup (index->entries, object1);
+
+  if (entry == NULL) {
+    geda_page_index_add (index, object2);
+    return;
+  }
+
+  index_entry_mark_stale (index, entry);
+
+  g_hash_table_steal (index->entries, object1);
+  entry->object = object2;
+  g_hash_table_insert (index->entries, object2, entry);
+}
+
+/*! \brief Notify the page index that an object's bounds changed
+ *
+ *  \param [in] index   The page index.
+ *  \param [in] object  A top level object of the page.
+ */
+void
+geda_page_index_invalidate (GedaPageIndex *index, OBJECT *object)
+{
+  IndexEntry *entry;
+
+  g_return_if_fail (index != NULL);
+  g_return_if_fail (object != NULL);
+
+  entry = g_hash_table_lookup (index->entries, object);
+
+  if (entry != NULL) {
+    index_entry_mark_stale (index, entry);
+  }
+}
+
+/*! \brief Find the objects in the index possibly overlapping regions
+ *
+ *  \par Function Description
+ *  Returns the objects whose indexed bounds are in the neighbourhood
+ *  of any of the given regions, in page order. The result is a
+ *  superset of the matching objects; callers still need to test the
+ *  actual bounds of each object.
+ *
+ *  If the index cannot answer the query, e.g. because the bounds were
+ *  requested for a different TOPLEVEL, \a result is left untouched
+ *  and FALSE is returned.
+ *
+ *  \param [in]  toplevel  The TOPLEVEL the bounds are needed for.
+ *  \param [in]  index     The page index.
+ *  \param [in]  rects     The BOX regions to check.
+ *  \param [in]  n_rects   The number of regions.
+ *  \param [out] result    The GList of candidate OBJECTs.
+ *  \return TRUE if the query was answered by the index.
+ */
+gboolean
+geda_page_index_query (TOPLEVEL *toplevel, GedaPageIndex *index,
+                       BOX *rects, int n_rects, GList **result)
+{
+  GPtrArray *found;
+  GList *list = NULL;
+  GList *iter;
+  gint64 n_cells = 0;
+  gint cell_x, cell_y;
+  guint i;
+  int r;
+
+  g_return_val_if_fail (index != NULL, FALSE);
+  g_return_val_if_fail (result != NULL, FALSE);
+
+  if (toplevel != index->toplevel) {
+    return FALSE;
+  }
+
+  index_refresh (index);
+
+  found = g_ptr_array_new ();
+  index->visit++;
+
+  for (r = 0; r < n_rects; r++) {
+    GedaBounds region;
+
+    geda_bounds_init_with_points (&region,
+                                  rects[r].lower_x, rects[r].lower_y,
+                                  rects[r].upper_x, rects[r].upper_y);
+    n_cells += index_cell_count (&region);
+  }
+
+  if (n_cells >= INDEX_BUCKET_COUNT) {
+    /* Every bucket would be visited anyway */
+    for (i = 0; i < INDEX_BUCKET_COUNT; i++) {
+      GPtrArray *bucket = index->buckets[i];
+      guint j;
+
+      for (j = 0; j < bucket->len; j++) {
+        index_visit (index, g_ptr_array_index (bucket, j), found);
+      }
+    }
+  }
+  else {
+    for (r = 0; r < n_rects; r++) {
+      GedaBounds region;
+
+      geda_bounds_init_with_points (&region,
+                                    rects[r].lower_x, rects[r].lower_y,
+                                    rects[r].upper_x, rects[r].upper_y);
+
+      for (cell_y = index_cell (region.min_y);
+           cell_y <= index_cell (region.max_y);
+           cell_y++) {
+        for (cell_x = index_cell (region.min_x);
+             cell_x <= index_cell (region.max_x);
+             cell_x++) {
+          GPtrArray *bucket = index_bucket (index, cell_x, cell_y);
+          guint j;
+
+          for (j = 0; j < bucket->len; j++) {
+            index_visit (index, g_ptr_array_index (bucket, j), found);
+          }
+        }
+      }
+    }
+  }
+
+  for (iter = index->large.head; iter != NULL; iter = g_list_next (iter)) {
+    index_visit (index, iter->data, found);
+  }
+
+  g_ptr_array_sort (found, index_entry_compare_order);
+
+  for (i = found->len; i > 0; i--) {
+    IndexEntry *entry = g_ptr_array_index (found, i - 1);
+    list = g_list_prepend (list, entry->object);
+  }
+
+  g_ptr_array_free (found, TRUE);
+
+  *result = list;
+  return TRUE;
+}
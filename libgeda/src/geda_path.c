@@ -658,44 +658,58 @@ GedaPath *s_path_parse (const char *path_str)
 }
 
 
-char *s_path_string_from_path (const GedaPath *path)
+/*! \brief Append the text of a path to a buffer
+ *
+ *  Appends the same text s_path_string_from_path() returns, one line
+ *  per section with no trailing newline.
+ *
+ *  \param path [in] The path to write.
+ *  \param buffer [in,out] The buffer to append to.
+ */
+void s_path_append_to_buffer (const GedaPath *path, GString *buffer)
 {
   PATH_SECTION *section;
-  GString *path_string;
   int i;
 
-  path_string = g_string_new ("");
-
   for (i = 0; i < path->num_sections; i++) {
     section = &path->sections[i];
 
     if (i > 0)
-      g_string_append_c (path_string, '\n');
+      g_string_append_c (buffer, '\n');
 
     switch (section->code) {
       case PATH_MOVETO:
-        g_string_append_printf (path_string, "M %i,%i",
+        g_string_append_printf (buffer, "M %i,%i",
                                 section->x3, section->y3);
         break;
       case PATH_MOVETO_OPEN:
-        g_string_append_printf (path_string, "M %i,%i",
+        g_string_append_printf (buffer, "M %i,%i",
                                 section->x3, section->y3);
         break;
       case PATH_CURVETO:
-        g_string_append_printf (path_string, "C %i,%i %i,%i %i,%i",
+        g_string_append_printf (buffer, "C %i,%i %i,%i %i,%i",
                                 section->x1, section->y1,
                                 section->x2, section->y2,
                                 section->x3, section->y3);
         break;
       case PATH_LINETO:
-        g_string_append_printf (path_string, "L %i,%i",
+        g_string_append_printf (buffer, "L %i,%i",
                                 section->x3, section->y3);
         break;
       case PATH_END:
-        g_string_append_printf (path_string, "z");
+        g_string_append_printf (buffer, "z");
         break;
     }
   }
+}
+
+
+char *s_path_string_from_path (const GedaPath *path)
+{
+  GString *path_string;
+
+  path_string = g_string_new ("");
+  s_path_append_to_buffer (path, path_string);
 
   return g_string_free (path_string, FALSE);
 }
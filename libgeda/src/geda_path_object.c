@@ -150,7 +150,7 @@ geda_path_object_copy (TOPLEVEL *toplevel, OBJECT *o_current)
                       o_current->fill_pitch2, o_current->fill_angle2);
 
   /* calc the bounding box */
-  o_current->w_bounds_valid_for = NULL;
+  new_obj->w_bounds_valid_for = NULL;
 
   /* return the new tail of the object list */
   return new_obj;
@@ -199,10 +199,10 @@ OBJECT *o_path_read (TOPLEVEL *toplevel,
    * The meaning of each item is described in the file format documentation.
    */
   /* Allocate enough space */
-  if (sscanf (first_line, "%c %d %d %d %d %d %d %d %d %d %d %d %d %d\n",
-	      &type, &color, &line_width, &line_end, &line_type,
-	      &line_length, &line_space, &fill_type, &fill_width, &angle1,
-	      &pitch1, &angle2, &pitch2, &num_lines) != 14) {
+  if (o_read_scan_line (first_line, NULL, &type, 13,
+                        &color, &line_width, &line_end, &line_type,
+                        &line_length, &line_space, &fill_type, &fill_width, &angle1,
+                        &pitch1, &angle2, &pitch2, &num_lines) != 14) {
     g_set_error(err, EDA_ERROR, EDA_ERROR_PARSE, _("Failed to parse path object"));
     return NULL;
   }
@@ -270,40 +270,46 @@ OBJECT *o_path_read (TOPLEVEL *toplevel,
 gchar*
 geda_path_object_to_buffer (const GedaObject *object)
 {
-  int line_width, line_space, line_length;
-  char *buf;
-  int num_lines;
-  OBJECT_END line_end;
-  OBJECT_TYPE line_type;
-  OBJECT_FILLING fill_type;
-  int fill_width, angle1, pitch1, angle2, pitch2;
-  char *path_string;
+  GString *buffer;
 
-  /* description of the line type */
-  line_width  = object->line_width;
-  line_end    = object->line_end;
-  line_type   = object->line_type;
-  line_length = object->line_length;
-  line_space  = object->line_space;
-
-  /* filling parameters */
-  fill_type    = object->fill_type;
-  fill_width   = object->fill_width;
-  angle1       = object->fill_angle1;
-  pitch1       = object->fill_pitch1;
-  angle2       = object->fill_angle2;
-  pitch2       = object->fill_pitch2;
-
-  path_string = s_path_string_from_path (object->path);
-  num_lines = o_text_num_lines (path_string);
-  buf = g_strdup_printf ("%c %d %d %d %d %d %d %d %d %d %d %d %d %d\n%s",
-                         object->type, geda_object_get_color (object), line_width, line_end,
-                         line_type, line_length, line_space, fill_type,
-                         fill_width, angle1, pitch1, angle2, pitch2,
-                         num_lines, path_string);
-  g_free (path_string);
+  buffer = g_string_new (NULL);
+  geda_path_object_append_to_buffer (object, buffer);
+
+  return g_string_free (buffer, FALSE);
+}
 
-  return buf;
+/*! \brief Append a string representation of the path object
+ *  \par Function Description
+ *  Appends the same text as geda_path_object_to_buffer() to \a buffer,
+ *  without allocating a string for it.
+ *
+ *  \param [in]     object  The path object
+ *  \param [in,out] buffer  The buffer to append to
+ */
+void
+geda_path_object_append_to_buffer (const GedaObject *object, GString *buffer)
+{
+  /* Each section is written on a line of its own */
+  int num_lines = MAX (object->path->num_sections, 1);
+
+  o_save_fields (buffer, object->type, 13,
+                 geda_object_get_color (object),
+                 /* description of the line type */
+                 object->line_width,
+                 object->line_end,
+                 object->line_type,
+                 object->line_length,
+                 object->line_space,
+                 /* filling parameters */
+                 object->fill_type,
+                 object->fill_width,
+                 object->fill_angle1,
+                 object->fill_pitch1,
+                 object->fill_angle2,
+                 object->fill_pitch2,
+                 num_lines);
+  g_string_append_c (buffer, '\n');
+  s_path_append_to_buffer (object->path, buffer);
 }
 
 
@@ -362,7 +368,7 @@ geda_path_object_modify (TOPLEVEL *toplevel, OBJECT *object,
   }
 
   /* Update bounding box */
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
   o_emit_change_notify (toplevel, object);
 }
 
@@ -408,7 +414,7 @@ geda_path_object_translate (GedaObject *object, int dx, int dy)
   }
 
   /* Update bounding box */
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
 }
 
 
@@ -461,7 +467,7 @@ void geda_path_object_rotate (TOPLEVEL *toplevel,
       break;
     }
   }
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
 }
 
 
@@ -505,7 +511,7 @@ void geda_path_object_mirror (TOPLEVEL *toplevel, int world_centerx,
     }
   }
 
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
 }
 
 
@@ -64,8 +64,9 @@ OBJECT *o_picture_read (TOPLEVEL *toplevel,
   gchar *file_content = NULL;
   guint file_length = 0;
 
-  num_conv = sscanf(first_line, "%c %d %d %d %d %d %d %d\n",
-                    &type, &x1, &y1, &width, &height, &angle, &mirrored, &embedded);
+  num_conv = o_read_scan_line (first_line, NULL, &type, 7,
+                               &x1, &y1, &width, &height,
+                               &angle, &mirrored, &embedded);
 
   if (num_conv != 8) {
     g_set_error(err, EDA_ERROR, EDA_ERROR_PARSE, _("Failed to parse picture definition"));
@@ -177,10 +178,28 @@ OBJECT *o_picture_read (TOPLEVEL *toplevel,
  */
 gchar*
 geda_picture_object_to_buffer (const GedaObject *object)
+{
+  GString *buffer;
+
+  buffer = g_string_new (NULL);
+  geda_picture_object_append_to_buffer (object, buffer);
+
+  return g_string_free (buffer, FALSE);
+}
+
+/*! \brief Append a string representation of the picture object
+ *  \par Function Description
+ *  Appends the same text as geda_picture_object_to_buffer() to \a buffer,
+ *  without allocating a string for it.
+ *
+ *  \param [in]     object  The picture object
+ *  \param [in,out] buffer  The buffer to append to
+ */
+void
+geda_picture_object_append_to_buffer (const GedaObject *object, GString *buffer)
 {
   int width, height, x1, y1;
   gchar *encoded_picture=NULL;
-  gchar *out=NULL;
   guint encoded_picture_length;
   const gchar *filename = NULL;
 
@@ -212,32 +231,20 @@ geda_picture_object_to_buffer (const GedaObject *object)
   filename = o_picture_get_filename (object);
   if (filename == NULL) filename = "";
 
-  if (o_picture_is_embedded (object) &&
-      encoded_picture != NULL) {
-    out = g_strdup_printf("%c %d %d %d %d %d %c %c\n%s\n%s\n%s",
-                          object->type,
-                          x1, y1, width, height,
-                          object->picture->angle,
-                          /* Convert the (0,1) chars to ASCII */
-                          (object->picture->mirrored)+0x30,
-                          '1',
-                          filename,
-                          encoded_picture,
-                          ".");
-  }
-  else {
-    out = g_strdup_printf("%c %d %d %d %d %d %c %c\n%s",
-                          object->type,
-                          x1, y1, width, height,
-                          object->picture->angle,
-                          /* Convert the (0,1) chars to ASCII */
-                          (object->picture->mirrored)+0x30,
-                          '0',
-                          filename);
+  o_save_fields (buffer, object->type, 7,
+                 x1, y1, width, height,
+                 object->picture->angle,
+                 object->picture->mirrored,
+                 (encoded_picture != NULL) ? 1 : 0);
+  g_string_append_c (buffer, '\n');
+  g_string_append (buffer, filename);
+
+  if (encoded_picture != NULL) {
+    g_string_append_c (buffer, '\n');
+    g_string_append (buffer, encoded_picture);
+    g_string_append (buffer, "\n.");
   }
   g_free(encoded_picture);
-
-  return(out);
 }
 
 
@@ -504,7 +511,7 @@ void o_picture_modify(TOPLEVEL *toplevel, OBJECT *object,
   }
 
   /* recalculate the screen coords and the boundings */
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
   o_emit_change_notify (toplevel, object);
 }
 
@@ -535,7 +542,7 @@ o_picture_modify_all (TOPLEVEL *toplevel, OBJECT *object,
   object->picture->upper_y = (y1 > y2) ? y1 : y2;
 
   /* recalculate the world coords and bounds */
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
   o_emit_change_notify (toplevel, object);
 }
 
@@ -605,7 +612,7 @@ void geda_picture_object_rotate (TOPLEVEL *toplevel,
   object->picture->lower_y += world_centery;
 
   /* recalc boundings and screen coords */
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
 
 }
 
@@ -670,7 +677,7 @@ void geda_picture_object_mirror(TOPLEVEL *toplevel,
   object->picture->lower_y += world_centery;
 
   /* recalc boundings and screen coords */
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
 
 }
 
@@ -697,7 +704,7 @@ geda_picture_object_translate (GedaObject *object, int dx, int dy)
   object->picture->lower_y = object->picture->lower_y + dy;
 
   /* recalc the screen coords and the bounding picture */
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
 }
 
 /*! \brief Create a copy of a picture.
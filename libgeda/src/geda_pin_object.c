@@ -342,15 +342,15 @@ OBJECT *o_pin_read (TOPLEVEL *toplevel, const char buf[],
   int whichend;
 
   if (release_ver <= VERSION_20020825) {
-    if (sscanf (buf, "%c %d %d %d %d %d\n", &type, &x1, &y1, &x2, &y2, &color) != 6) {
+    if (o_read_scan_line (buf, NULL, &type, 5, &x1, &y1, &x2, &y2, &color) != 6) {
       g_set_error(err, EDA_ERROR, EDA_ERROR_PARSE, _("Failed to parse pin object"));
       return NULL;
     }
     pin_type = PIN_TYPE_NET;
     whichend = -1;
   } else {
-    if (sscanf (buf, "%c %d %d %d %d %d %d %d\n", &type, &x1, &y1, &x2, &y2,
-		&color, &pin_type, &whichend) != 8) {
+    if (o_read_scan_line (buf, NULL, &type, 7, &x1, &y1, &x2, &y2,
+                          &color, &pin_type, &whichend) != 8) {
       g_set_error(err, EDA_ERROR, EDA_ERROR_PARSE, _("Failed to parse pin object"));
       return NULL;
     }
@@ -399,19 +399,41 @@ OBJECT *o_pin_read (TOPLEVEL *toplevel, const char buf[],
 gchar*
 geda_pin_object_to_buffer (const GedaObject *object)
 {
+  GString *buffer;
+
   g_return_val_if_fail (object != NULL, NULL);
   g_return_val_if_fail (object->line != NULL, NULL);
   g_return_val_if_fail (object->type == OBJ_PIN, NULL);
 
-  return g_strdup_printf ("%c %d %d %d %d %d %d %d",
-                          OBJ_PIN,
-                          geda_pin_object_get_x0 (object),
-                          geda_pin_object_get_y0 (object),
-                          geda_pin_object_get_x1 (object),
-                          geda_pin_object_get_y1 (object),
-                          geda_object_get_color (object),
-                          object->pin_type,
-                          object->whichend);
+  buffer = g_string_new (NULL);
+  geda_pin_object_append_to_buffer (object, buffer);
+
+  return g_string_free (buffer, FALSE);
+}
+
+/*! \brief Append a string representation of the pin object
+ *  \par Function Description
+ *  Appends the same text as geda_pin_object_to_buffer() to \a buffer,
+ *  without allocating a string for it.
+ *
+ *  \param [in]     object  The pin object
+ *  \param [in,out] buffer  The buffer to append to
+ */
+void
+geda_pin_object_append_to_buffer (const GedaObject *object, GString *buffer)
+{
+  g_return_if_fail (object != NULL);
+  g_return_if_fail (object->line != NULL);
+  g_return_if_fail (object->type == OBJ_PIN);
+
+  o_save_fields (buffer, OBJ_PIN, 7,
+                 geda_pin_object_get_x0 (object),
+                 geda_pin_object_get_y0 (object),
+                 geda_pin_object_get_x1 (object),
+                 geda_pin_object_get_y1 (object),
+                 geda_object_get_color (object),
+                 object->pin_type,
+                 object->whichend);
 }
 
 /*! \brief move a pin object
@@ -436,7 +458,7 @@ geda_pin_object_translate (GedaObject *object, int dx, int dy)
   object->line->y[1] = object->line->y[1] + dy;
 
   /* Update bounding box */
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
 }
 
 /*! \brief create a copy of a pin object
@@ -563,7 +585,7 @@ geda_pin_object_modify(TOPLEVEL *toplevel, OBJECT *object, int x, int y, int whi
   object->line->x[whichone] = x;
   object->line->y[whichone] = y;
 
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
 }
 
 /*! \brief guess the whichend of pins of object list
@@ -419,7 +419,7 @@ geda_text_object_new (TOPLEVEL *toplevel,
 
   new_node = s_basic_new_object (OBJ_TEXT, "text");
 
-  text = (TEXT *) g_malloc(sizeof(TEXT));
+  text = (TEXT *) geda_arena_alloc0 (sizeof(TEXT));
 
   text->string = g_strdup (string);
   text->disp_string = NULL; /* We'll fix this up later */
@@ -481,30 +481,30 @@ o_text_read (TOPLEVEL *toplevel,
   GString *textstr;
 
   if (fileformat_ver >= 1) {
-    if (sscanf(first_line, "%c %d %d %d %d %d %d %d %d %d\n", &type, &x, &y,
-	       &color, &size,
-	       &visibility, &show_name_value,
-	       &angle, &alignment, &num_lines) != 10) {
+    if (o_read_scan_line (first_line, NULL, &type, 9, &x, &y,
+                          &color, &size,
+                          &visibility, &show_name_value,
+                          &angle, &alignment, &num_lines) != 10) {
       g_set_error(err, EDA_ERROR, EDA_ERROR_PARSE, _("Failed to parse text object"));
       return NULL;
     }
   } else if (release_ver < VERSION_20000220) {
     /* yes, above less than (not less than and equal) is correct. The format */
     /* change occurred in 20000220 */
-    if (sscanf(first_line, "%c %d %d %d %d %d %d %d\n", &type, &x, &y,
-	       &color, &size,
-	       &visibility, &show_name_value,
-	       &angle) != 8) {
+    if (o_read_scan_line (first_line, NULL, &type, 7, &x, &y,
+                          &color, &size,
+                          &visibility, &show_name_value,
+                          &angle) != 8) {
       g_set_error(err, EDA_ERROR, EDA_ERROR_PARSE, _("Failed to parse text object"));
       return NULL;
     }
     alignment = LOWER_LEFT; /* older versions didn't have this */
     num_lines = 1; /* only support a single line */
   } else {
-    if (sscanf(first_line, "%c %d %d %d %d %d %d %d %d\n", &type, &x, &y,
-	       &color, &size,
-	       &visibility, &show_name_value,
-           &angle, &alignment) != 9) {
+    if (o_read_scan_line (first_line, NULL, &type, 8, &x, &y,
+                          &color, &size,
+                          &visibility, &show_name_value,
+                          &angle, &alignment) != 9) {
       g_set_error (err, EDA_ERROR, EDA_ERROR_PARSE, _("Failed to parse text object"));
       return NULL;
     }
@@ -552,22 +552,37 @@ o_text_read (TOPLEVEL *toplevel,
 
   g_assert(num_lines && num_lines > 0);
 
-  textstr = g_string_new ("");
+  textstr = NULL;
   for (i = 0; i < num_lines; i++) {
     const gchar *line;
 
     line = s_textbuffer_next_line (tb);
 
     if (line == NULL) {
-      g_string_free (textstr, TRUE);
+      if (textstr != NULL) {
+        g_string_free (textstr, TRUE);
+      }
+      g_free (string);
       g_set_error(err, EDA_ERROR, EDA_ERROR_PARSE, _("Unexpected end-of-file after %d lines"), i);
       return NULL;
     }
 
-    textstr = g_string_append (textstr, line);
+    /* Most text is a single line, which doesn't need a GString */
+    if (i == 0) {
+      string = g_strdup (line);
+    } else {
+      if (textstr == NULL) {
+        textstr = g_string_new (string);
+        g_free (string);
+        string = NULL;
+      }
+      textstr = g_string_append (textstr, line);
+    }
+  }
+  if (textstr != NULL) {
+    /* retrieve the character string from the GString */
+    string = g_string_free (textstr, FALSE);
   }
-  /* retrieve the character string from the GString */
-  string = g_string_free (textstr, FALSE);
 
   string = geda_string_remove_ending_newline (string);
 
@@ -614,28 +629,52 @@ o_text_read (TOPLEVEL *toplevel,
 gchar*
 geda_text_object_to_buffer (const GedaObject *object)
 {
-  const gchar *string;
+  GString *buffer;
 
   g_return_val_if_fail (object != NULL, NULL);
   g_return_val_if_fail (object->text != NULL, NULL);
   g_return_val_if_fail (object->type == OBJ_TEXT, NULL);
+  g_return_val_if_fail (geda_text_object_get_string (object) != NULL, NULL);
 
-  string = geda_text_object_get_string (object);
+  buffer = g_string_new (NULL);
+  geda_text_object_append_to_buffer (object, buffer);
 
-  g_return_val_if_fail (string != NULL, NULL);
+  return g_string_free (buffer, FALSE);
+}
+
+/*! \brief Append a string representation of the text object
+ *  \par Function Description
+ *  Appends the same text as geda_text_object_to_buffer() to \a buffer,
+ *  without allocating a string for it.
+ *
+ *  \param [in]     object  The text object
+ *  \param [in,out] buffer  The buffer to append to
+ */
+void
+geda_text_object_append_to_buffer (const GedaObject *object, GString *buffer)
+{
+  const gchar *string;
 
-  return g_strdup_printf ("%c %d %d %d %d %d %d %d %d %d\n%s",
-                          OBJ_TEXT,
-                          geda_text_object_get_x (object),
-                          geda_text_object_get_y (object),
-                          geda_object_get_color (object),
-                          geda_text_object_get_size (object),
-                          geda_object_get_visible (object),
-                          object->show_name_value,
-                          geda_text_object_get_angle (object),
-                          geda_text_object_get_alignment (object),
-                          o_text_num_lines (string),
-                          string);
+  g_return_if_fail (object != NULL);
+  g_return_if_fail (object->text != NULL);
+  g_return_if_fail (object->type == OBJ_TEXT);
+
+  string = geda_text_object_get_string (object);
+
+  g_return_if_fail (string != NULL);
+
+  o_save_fields (buffer, OBJ_TEXT, 9,
+                 geda_text_object_get_x (object),
+                 geda_text_object_get_y (object),
+                 geda_object_get_color (object),
+                 geda_text_object_get_size (object),
+                 geda_object_get_visible (object),
+                 object->show_name_value,
+                 geda_text_object_get_angle (object),
+                 geda_text_object_get_alignment (object),
+                 o_text_num_lines (string));
+  g_string_append_c (buffer, '\n');
+  g_string_append (buffer, string);
 }
 
 /*! \brief recreate the graphics of a text object
@@ -651,7 +690,7 @@ o_text_recreate (TOPLEVEL *toplevel, OBJECT *o_current)
 {
   o_emit_pre_change_notify (toplevel, o_current);
   update_disp_string (o_current);
-  o_current->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (o_current);
   o_emit_change_notify (toplevel, o_current);
 }
 
@@ -674,7 +713,7 @@ geda_text_object_translate (GedaObject *object, int dx, int dy)
   object->text->y = object->text->y + dy;
 
   /* Update bounding box */
-  object->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (object);
 }
 
 /*! \brief create a copy of a text object
@@ -907,6 +946,9 @@ o_text_set_string (TOPLEVEL *toplevel, OBJECT *obj, const gchar *new_string)
   g_free (obj->text->string);
   obj->text->string = g_strdup (new_string);
 
+  /* The text may be an attribute, which is indexed by name */
+  o_attrib_invalidate_owner_index (obj);
+
   o_text_recreate (toplevel, obj);
 }
 
@@ -51,6 +51,10 @@ int   default_keep_invisible = TRUE;
 
 int   default_make_backup_files = TRUE;
 
+int   default_component_library_index = FALSE;
+int   default_object_cache = FALSE;
+int   default_object_arena = TRUE;
+
 /*! \brief Initialize variables in TOPLEVEL object
  *  \par Function Description
  *  This function will initialize variables to default values.
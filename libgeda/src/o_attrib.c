@@ -62,9 +62,14 @@
  */
 void o_attrib_add(TOPLEVEL *toplevel, OBJECT *object, OBJECT *item)
 {
+  /* A floating attribute inside a complex stops being inherited */
+  o_attrib_invalidate_owner_index (item);
+
   /* Add link from item to attrib listing */
   item->attached_to = object;
   object->attribs = g_list_append (object->attribs, item);
+
+  o_attrib_invalidate_index (object);
 }
 
 
@@ -167,10 +172,13 @@ void o_attrib_detach_all(TOPLEVEL *toplevel, OBJECT *object)
 
     a_current->attached_to = NULL;
     o_set_color (toplevel, a_current, DETACHED_ATTRIBUTE_COLOR);
+    o_attrib_invalidate_owner_index (a_current);
   }
 
   g_list_free (object->attribs);
   object->attribs = NULL;
+
+  o_attrib_invalidate_index (object);
 }
 
 /*! \brief Print all attributes to a Postscript document.
@@ -183,13 +191,16 @@ void o_attrib_print(GList *attributes)
 {
   OBJECT *a_current;
   GList *a_iter;
+  gchar *name;
 
   a_iter = attributes;
 
   while (a_iter != NULL) {
     a_current = a_iter->data;
-    printf("Attribute points to: %s\n", a_current->name);
-    if (a_current->text) {
+    name = geda_object_get_name (a_current);
+    printf("Attribute points to: %s\n", name);
+    g_free (name);
+    if (a_current->type == OBJ_TEXT && a_current->text) {
       printf("\tText is: %s\n", a_current->text->string);
     }
 
@@ -211,7 +222,9 @@ void o_attrib_remove(TOPLEVEL *toplevel, GList **list, OBJECT *remove)
 {
   g_return_if_fail (remove != NULL);
 
+  o_attrib_invalidate_owner_index (remove);
   remove->attached_to = NULL;
+  o_attrib_invalidate_owner_index (remove);
 
   *list = g_list_remove (*list, remove);
 }
@@ -243,7 +256,7 @@ GList *o_read_attribs (TOPLEVEL *toplevel,
     line = s_textbuffer_next_line (tb);
     if (line == NULL) break;
 
-    sscanf(line, "%c", &objtype);
+    objtype = line[0];
     switch (objtype) {
 
       case(OBJ_LINE):
@@ -489,6 +502,154 @@ OBJECT *o_attrib_find_attrib_by_name (const GList *list, char *name, int count)
 }
 
 
+/*! \brief Free an entry of an attribute index.
+ *  \par Function Description
+ *  Frees the array of attributes with the same name.
+ *
+ *  \param [in] data  The GPtrArray to free.
+ */
+static void o_attrib_free_index_entry (gpointer data)
+{
+  g_ptr_array_free ((GPtrArray *) data, TRUE);
+}
+
+
+/*! \brief Get the attribute index of an object.
+ *  \par Function Description
+ *  Returns a hash table mapping the name of each attribute of \a object
+ *  to a GPtrArray of the attribute OBJECTs with that name, in the order
+ *  o_attrib_return_attribs() lists them: attached attributes first, then
+ *  inherited ones.
+ *
+ *  The index is built when first asked for, so that each attribute is
+ *  split into its name and value once instead of on every search.  It
+ *  stays with the object until o_attrib_invalidate_index() is called.
+ *
+ *  \param [in] object  The OBJECT whose attributes to index.
+ *  \return The attribute index of \a object.
+ */
+static GHashTable *o_attrib_get_index (OBJECT *object)
+{
+  GList *attribs;
+  GList *iter;
+
+  if (object->attrib_index != NULL)
+    return object->attrib_index;
+
+  object->attrib_index =
+    g_hash_table_new_full (g_str_hash, g_str_equal,
+                           g_free, o_attrib_free_index_entry);
+
+  attribs = o_attrib_return_attribs (object);
+
+  for (iter = attribs; iter != NULL; iter = g_list_next (iter)) {
+    OBJECT *a_current = iter->data;
+    GPtrArray *entry;
+    gchar *name;
+
+    if (!o_attrib_get_name_value (a_current, &name, NULL))
+      continue;
+
+    entry = g_hash_table_lookup (object->attrib_index, name);
+
+    if (entry == NULL) {
+      entry = g_ptr_array_new ();
+      g_hash_table_insert (object->attrib_index, name, entry);
+    } else {
+      g_free (name);
+    }
+
+    g_ptr_array_add (entry, a_current);
+  }
+
+  g_list_free (attribs);
+
+  return object->attrib_index;
+}
+
+
+/*! \brief Discard the attribute index of an object.
+ *  \par Function Description
+ *  Must be called whenever the attributes of \a object change, i.e.
+ *  when an attribute is attached to or detached from it, when the
+ *  text of one of its attributes changes, or, for a complex, when
+ *  its prim_objs change.  The index is built again when next needed.
+ *
+ *  \param [in] object  The OBJECT whose attributes changed, or NULL.
+ */
+void o_attrib_invalidate_index (OBJECT *object)
+{
+  if (object == NULL || object->attrib_index == NULL)
+    return;
+
+  g_hash_table_destroy (object->attrib_index);
+  object->attrib_index = NULL;
+}
+
+
+/*! \brief Discard the attribute index an attribute is part of.
+ *  \par Function Description
+ *  Calls o_attrib_invalidate_index() on the object \a attrib is
+ *  attached to, or on the complex it is inherited from.
+ *
+ *  \param [in] attrib  The attribute OBJECT which changed.
+ */
+void o_attrib_invalidate_owner_index (OBJECT *attrib)
+{
+  g_return_if_fail (attrib != NULL);
+
+  if (attrib->attached_to != NULL) {
+    o_attrib_invalidate_index (attrib->attached_to);
+  } else {
+    o_attrib_invalidate_index (attrib->parent);
+  }
+}
+
+
+/*! \brief Search the attribute index of an object by name.
+ *  \par Function Description
+ *  Finds the n'th attribute of \a object called \a name, counting
+ *  only attached attributes, only inherited ones, or both.
+ *
+ *  \param [in] object     The OBJECT whose attributes to search.
+ *  \param [in] name       Character string with attribute name to search for.
+ *  \param [in] counter    Which occurance to return.
+ *  \param [in] attached   Whether to count attached attributes.
+ *  \param [in] inherited  Whether to count inherited attributes.
+ *  \return Character string with attribute value, NULL otherwise.
+ *
+ *  \warning
+ *  Caller must g_free returned character string.
+ */
+static char *o_attrib_search_index_by_name (OBJECT *object, char *name,
+                                            int counter, gboolean attached,
+                                            gboolean inherited)
+{
+  GPtrArray *entry;
+  guint i;
+
+  entry = g_hash_table_lookup (o_attrib_get_index (object), name);
+
+  if (entry == NULL)
+    return NULL;
+
+  for (i = 0; i < entry->len; i++) {
+    OBJECT *a_current = g_ptr_array_index (entry, i);
+    gboolean is_attached = (a_current->attached_to == object);
+
+    if (is_attached ? !attached : !inherited)
+      continue;
+
+    if (counter-- == 0) {
+      /* The text is "name=value" */
+      return g_strdup (a_current->text->string + strlen (name) + 1);
+    }
+  }
+
+  return NULL;
+}
+
+
 /*! \brief Search attribute list by name.
  *  \par Function Description
  *  Search for attribute by name.
@@ -560,7 +721,7 @@ char *o_attrib_search_floating_attribs_by_name (const GList *list, char *name, i
  */
 char *o_attrib_search_attached_attribs_by_name (OBJECT *object, char *name, int counter)
 {
-  return o_attrib_search_attrib_list_by_name (object->attribs, name, counter);
+  return o_attrib_search_index_by_name (object, name, counter, TRUE, FALSE);
 }
 
 
@@ -584,7 +745,7 @@ char *o_attrib_search_inherited_attribs_by_name (OBJECT *object, char *name, int
   g_return_val_if_fail (object->type == OBJ_COMPLEX ||
                         object->type == OBJ_PLACEHOLDER, NULL);
 
-  return o_attrib_search_floating_attribs_by_name (object->complex->prim_objs, name, counter);
+  return o_attrib_search_index_by_name (object, name, counter, FALSE, TRUE);
 }
 
 
@@ -605,14 +766,9 @@ char *o_attrib_search_inherited_attribs_by_name (OBJECT *object, char *name, int
  */
 char *o_attrib_search_object_attribs_by_name (OBJECT *object, char *name, int counter)
 {
-  char *result;
-  GList *attributes;
-
-  attributes = o_attrib_return_attribs (object);
-  result = o_attrib_search_attrib_list_by_name (attributes, name, counter);
-  g_list_free (attributes);
+  g_return_val_if_fail (object != NULL, NULL);
 
-  return result;
+  return o_attrib_search_index_by_name (object, name, counter, TRUE, TRUE);
 }
 
 
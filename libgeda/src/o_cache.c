@@ -0,0 +1,778 @@
+/* gEDA - GPL Electronic Design Automation
+ * libgeda - gEDA's library
+ * Copyright (C) 1998-2010 Ales Hvezda
+ * Copyright (C) 1998-2010 gEDA Contributors (see ChangeLog for details)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*! \file o_cache.c
+ *  \brief Binary cache of the objects read from files
+ *
+ *  Most of the time spent loading a schematic goes into parsing its
+ *  text.  When the object-cache rc option is enabled, the objects read
+ *  from a schematic or symbol are also saved in a compact binary form
+ *  in the user cache directory, in a file named after a checksum of
+ *  the text.  Reading the same text again later just copies the fields
+ *  of each object out of the cache file.
+ *
+ *  The text always remains the authoritative copy.  A cache file is
+ *  only found for exactly the same text, and a cache file which can't
+ *  be decoded is ignored and written again.  Non-embedded components
+ *  only store the name of their symbol, which is looked up in the
+ *  component library when the cache is read, as when reading the text.
+ */
+
+#include <config.h>
+#include <version.h>
+
+#include <stdio.h>
+#ifdef HAVE_STRING_H
+#include <string.h>
+#endif
+
+#include "libgeda_priv.h"
+
+/*! Subdirectory of the user cache directory holding the cache files */
+#define OBJECT_CACHE_DIR "objects"
+
+/*! Identifies an object cache file */
+#define OBJECT_CACHE_MAGIC "gEDA object cache\n"
+
+/*! Version of the layout of the cache files */
+#define OBJECT_CACHE_VERSION 1
+
+/*! Written as an integer to recognise files of a different byte order */
+#define OBJECT_CACHE_BYTE_ORDER 0x01020304
+
+typedef struct _CacheReader CacheReader;
+
+/*! \brief Position in a cache file being decoded */
+struct _CacheReader
+{
+  const gchar *pos;
+  const gchar *end;
+  gboolean failed;   /* Set when anything could not be decoded */
+};
+
+static gboolean encode_objects (GString *out, const GList *objects);
+static GList *decode_objects (TOPLEVEL *toplevel, CacheReader *reader);
+
+/*! \brief Append an integer to a cache file. */
+static void write_int (GString *out, gint value)
+{
+  gint32 value32 = value;
+
+  g_string_append_len (out, (const gchar *) &value32, sizeof (value32));
+}
+
+/*! \brief Append a block of data to a cache file. */
+static void write_data (GString *out, const gchar *data, gsize length)
+{
+  write_int (out, length);
+  g_string_append_len (out, data, length);
+}
+
+/*! \brief Append a string, which may be NULL, to a cache file. */
+static void write_string (GString *out, const gchar *string)
+{
+  if (string == NULL) {
+    write_int (out, -1);
+  } else {
+    write_data (out, string, strlen (string));
+  }
+}
+
+/*! \brief Read an integer from a cache file.
+ *  \par Function Description
+ *  Returns 0, and marks \a reader as failed, if the file is too short.
+ */
+static gint read_int (CacheReader *reader)
+{
+  gint32 value32;
+
+  if (reader->failed || reader->end - reader->pos < (gssize) sizeof (value32)) {
+    reader->failed = TRUE;
+    return 0;
+  }
+
+  memcpy (&value32, reader->pos, sizeof (value32));
+  reader->pos += sizeof (value32);
+
+  return value32;
+}
+
+/*! \brief Read \a count integers from a cache file into \a values. */
+static void read_ints (CacheReader *reader, gint *values, gint count)
+{
+  gint i;
+
+  for (i = 0; i < count; i++) {
+    values[i] = read_int (reader);
+  }
+}
+
+/*! \brief Read a block of data written by write_data().
+ *  \par Function Description
+ *  Returns a pointer into the cache file, or NULL if the block was
+ *  written for a NULL string or the file is too short.
+ */
+static const gchar *read_data (CacheReader *reader, gint *length)
+{
+  const gchar *data;
+
+  *length = read_int (reader);
+
+  if (reader->failed || *length == -1) {
+    return NULL;
+  }
+
+  if (*length < 0 || reader->end - reader->pos < *length) {
+    reader->failed = TRUE;
+    return NULL;
+  }
+
+  data = reader->pos;
+  reader->pos += *length;
+
+  return data;
+}
+
+/*! \brief Read a string written by write_string().
+ *  \return a newly allocated string, or NULL.
+ */
+static gchar *read_string (CacheReader *reader)
+{
+  gint length;
+  const gchar *data = read_data (reader, &length);
+
+  return (data == NULL) ? NULL : g_strndup (data, length);
+}
+
+/*! \brief Save the line and fill options of an object. */
+static void encode_options (GString *out, const OBJECT *object)
+{
+  write_int (out, object->line_end);
+  write_int (out, object->line_type);
+  write_int (out, object->line_width);
+  write_int (out, object->line_length);
+  write_int (out, object->line_space);
+
+  write_int (out, object->fill_type);
+  write_int (out, object->fill_width);
+  write_int (out, object->fill_pitch1);
+  write_int (out, object->fill_angle1);
+  write_int (out, object->fill_pitch2);
+  write_int (out, object->fill_angle2);
+}
+
+/*! \brief Restore the line and fill options saved by encode_options(). */
+static void decode_options (TOPLEVEL *toplevel, CacheReader *reader,
+                            OBJECT *object)
+{
+  gint v[11];
+
+  read_ints (reader, v, 11);
+  if (reader->failed) return;
+
+  o_set_line_options (toplevel, object, v[0], v[1], v[2], v[3], v[4]);
+  o_set_fill_options (toplevel, object, v[5], v[6], v[7], v[8], v[9], v[10]);
+}
+
+/*! \brief Save the fields of an object.
+ *  \par Function Description
+ *  Writes the fields of \a object which the file format describes,
+ *  after its type.  The objects inside embedded components are saved,
+ *  too.
+ *
+ *  \return FALSE if \a object can't be saved.
+ */
+static gboolean encode_object (GString *out, const OBJECT *object)
+{
+  gint i;
+
+  switch (object->type) {
+
+    case OBJ_LINE:
+    case OBJ_NET:
+    case OBJ_BUS:
+    case OBJ_PIN:
+      write_int (out, object->color);
+      write_int (out, object->line->x[0]);
+      write_int (out, object->line->y[0]);
+      write_int (out, object->line->x[1]);
+      write_int (out, object->line->y[1]);
+
+      if (object->type == OBJ_LINE) {
+        encode_options (out, object);
+      } else if (object->type == OBJ_BUS) {
+        write_int (out, object->bus_ripper_direction);
+      } else if (object->type == OBJ_PIN) {
+        write_int (out, object->pin_type);
+        write_int (out, object->whichend);
+      }
+      break;
+
+    case OBJ_BOX:
+      write_int (out, object->color);
+      write_int (out, object->box->upper_x);
+      write_int (out, object->box->upper_y);
+      write_int (out, object->box->lower_x);
+      write_int (out, object->box->lower_y);
+      encode_options (out, object);
+      break;
+
+    case OBJ_CIRCLE:
+      write_int (out, object->color);
+      write_int (out, object->circle->center_x);
+      write_int (out, object->circle->center_y);
+      write_int (out, object->circle->radius);
+      encode_options (out, object);
+      break;
+
+    case OBJ_ARC:
+      write_int (out, object->color);
+      write_int (out, object->arc->x);
+      write_int (out, object->arc->y);
+      write_int (out, object->arc->radius);
+      write_int (out, object->arc->start_angle);
+      write_int (out, object->arc->sweep_angle);
+      encode_options (out, object);
+      break;
+
+    case OBJ_PATH:
+      write_int (out, object->color);
+      write_int (out, object->path->num_sections);
+      for (i = 0; i < object->path->num_sections; i++) {
+        PATH_SECTION *section = &object->path->sections[i];
+
+        write_int (out, section->code);
+        write_int (out, section->x1);
+        write_int (out, section->y1);
+        write_int (out, section->x2);
+        write_int (out, section->y2);
+        write_int (out, section->x3);
+        write_int (out, section->y3);
+      }
+      encode_options (out, object);
+      break;
+
+    case OBJ_TEXT:
+      write_int (out, object->color);
+      write_int (out, object->text->x);
+      write_int (out, object->text->y);
+      write_int (out, object->text->alignment);
+      write_int (out, object->text->angle);
+      write_int (out, object->text->size);
+      write_int (out, object->visibility);
+      write_int (out, object->show_name_value);
+      write_string (out, geda_text_object_get_string (object));
+      break;
+
+    case OBJ_PICTURE:
+      write_int (out, object->picture->upper_x);
+      write_int (out, object->picture->upper_y);
+      write_int (out, object->picture->lower_x);
+      write_int (out, object->picture->lower_y);
+      write_int (out, object->picture->angle);
+      write_int (out, object->picture->mirrored);
+      write_int (out, object->picture->embedded);
+      write_string (out, object->picture->filename);
+      if (object->picture->embedded) {
+        if (object->picture->file_content == NULL) return FALSE;
+        write_data (out, object->picture->file_content,
+                    object->picture->file_length);
+      }
+      break;
+
+    case OBJ_COMPLEX:
+    case OBJ_PLACEHOLDER:
+      write_int (out, object->complex->x);
+      write_int (out, object->complex->y);
+      write_int (out, geda_object_get_selectable (object));
+      write_int (out, object->complex->angle);
+      write_int (out, object->complex->mirror);
+      write_int (out, object->complex_embedded);
+      write_string (out, object->complex_basename);
+      if (object->complex_embedded) {
+        return encode_objects (out, object->complex->prim_objs);
+      }
+      break;
+
+    default:
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/*! \brief Create an object from the fields saved by encode_object().
+ *  \return the new object, or NULL if it could not be decoded.
+ */
+static OBJECT *decode_object (TOPLEVEL *toplevel, CacheReader *reader,
+                              gint type)
+{
+  OBJECT *object = NULL;
+  GList *iter;
+  gchar *string;
+  gint v[8];
+  gint i;
+
+  switch (type) {
+
+    case OBJ_LINE:
+    case OBJ_NET:
+    case OBJ_BUS:
+    case OBJ_PIN:
+      read_ints (reader, v, 5);
+      if (type == OBJ_BUS) {
+        read_ints (reader, v + 5, 1);
+      } else if (type == OBJ_PIN) {
+        read_ints (reader, v + 5, 2);
+      }
+      if (reader->failed || v[0] < 0 || v[0] > MAX_COLORS) return NULL;
+
+      if (type == OBJ_LINE) {
+        object = geda_line_object_new (toplevel, v[0], v[1], v[2], v[3], v[4]);
+        decode_options (toplevel, reader, object);
+      } else if (type == OBJ_NET) {
+        object = geda_net_object_new (toplevel, OBJ_NET, v[0],
+                                      v[1], v[2], v[3], v[4]);
+      } else if (type == OBJ_BUS) {
+        object = geda_bus_object_new (toplevel, v[0], v[1], v[2], v[3], v[4],
+                                      v[5]);
+      } else {
+        object = geda_pin_object_new (toplevel, v[0], v[1], v[2], v[3], v[4],
+                                      v[5], v[6]);
+      }
+      break;
+
+    case OBJ_BOX:
+      read_ints (reader, v, 5);
+      if (reader->failed || v[0] < 0 || v[0] > MAX_COLORS) return NULL;
+
+      object = geda_box_object_new (toplevel, OBJ_BOX, v[0],
+                                    v[1], v[2], v[3], v[4]);
+      decode_options (toplevel, reader, object);
+      break;
+
+    case OBJ_CIRCLE:
+      read_ints (reader, v, 4);
+      if (reader->failed || v[0] < 0 || v[0] > MAX_COLORS) return NULL;
+
+      object = geda_circle_object_new (toplevel, v[0], v[1], v[2], v[3]);
+      decode_options (toplevel, reader, object);
+      break;
+
+    case OBJ_ARC:
+      read_ints (reader, v, 6);
+      if (reader->failed || v[0] < 0 || v[0] > MAX_COLORS) return NULL;
+
+      object = geda_arc_object_new (toplevel, v[0], v[1], v[2], v[3], v[4], v[5]);
+      decode_options (toplevel, reader, object);
+      break;
+
+    case OBJ_PATH:
+      {
+        PATH *path;
+
+        /* Every section takes seven integers */
+        read_ints (reader, v, 2);
+        if (reader->failed || v[0] < 0 || v[0] > MAX_COLORS ||
+            v[1] < 0 || v[1] > (reader->end - reader->pos) / (7 * 4)) {
+          return NULL;
+        }
+
+        path = g_new (PATH, 1);
+        path->sections = g_new (PATH_SECTION, v[1]);
+        path->num_sections = v[1];
+        path->num_sections_max = v[1];
+
+        for (i = 0; i < path->num_sections; i++) {
+          PATH_SECTION *section = &path->sections[i];
+
+          section->code = read_int (reader);
+          section->x1 = read_int (reader);
+          section->y1 = read_int (reader);
+          section->x2 = read_int (reader);
+          section->y2 = read_int (reader);
+          section->x3 = read_int (reader);
+          section->y3 = read_int (reader);
+
+          if (section->code < PATH_MOVETO || section->code > PATH_END) {
+            reader->failed = TRUE;
+          }
+        }
+
+        object = geda_path_object_new_take_path (toplevel, OBJ_PATH, v[0], path);
+        decode_options (toplevel, reader, object);
+      }
+      break;
+
+    case OBJ_TEXT:
+      read_ints (reader, v, 8);
+      string = read_string (reader);
+      /* The same values o_text_read() would have corrected */
+      if (reader->failed || string == NULL || v[0] < 0 || v[0] > MAX_COLORS ||
+          v[3] < LOWER_LEFT || v[3] > UPPER_RIGHT ||
+          !geda_angle_is_ortho (v[4]) || v[5] < MINIMUM_TEXT_SIZE) {
+        g_free (string);
+        return NULL;
+      }
+
+      object = geda_text_object_new (toplevel, v[0], v[1], v[2], v[3], v[4],
+                                     string, v[5], v[6], v[7]);
+      g_free (string);
+      break;
+
+    case OBJ_PICTURE:
+      {
+        const gchar *content = NULL;
+        gint length = 0;
+
+        read_ints (reader, v, 7);
+        if (reader->failed ||
+            (v[4] != 0 && v[4] != 90 && v[4] != 180 && v[4] != 270) ||
+            (v[5] != 0 && v[5] != 1) || (v[6] != 0 && v[6] != 1)) {
+          return NULL;
+        }
+
+        string = read_string (reader);
+        if (v[6]) {
+          content = read_data (reader, &length);
+        }
+        if (reader->failed || (v[6] && content == NULL)) {
+          g_free (string);
+          return NULL;
+        }
+
+        object = o_picture_new (toplevel, content, length, string, OBJ_PICTURE,
+                                v[0], v[1], v[2], v[3], v[4], v[5], v[6]);
+        g_free (string);
+      }
+      break;
+
+    case OBJ_COMPLEX:
+    case OBJ_PLACEHOLDER:
+      read_ints (reader, v, 6);
+      string = read_string (reader);
+      if (reader->failed || string == NULL ||
+          (v[3] != 0 && v[3] != 90 && v[3] != 180 && v[3] != 270) ||
+          (v[4] != 0 && v[4] != 1)) {
+        g_free (string);
+        return NULL;
+      }
+
+      if (v[5]) {
+        object = o_complex_new_embedded (toplevel, OBJ_COMPLEX, DEFAULT_COLOR,
+                                         v[0], v[1], v[3], v[4], string, v[2]);
+        object->complex->prim_objs = decode_objects (toplevel, reader);
+
+        /* set the parent field now */
+        for (iter = object->complex->prim_objs;
+             iter != NULL; iter = g_list_next (iter)) {
+          ((OBJECT *) iter->data)->parent = object;
+        }
+
+        object->w_bounds_valid_for = NULL;
+      } else {
+        object = o_complex_new_by_name (toplevel, OBJ_COMPLEX,
+                                        v[0], v[1], v[3], v[4], string, v[2]);
+      }
+      g_free (string);
+      break;
+  }
+
+  return object;
+}
+
+/*! \brief Save a list of objects.
+ *  \par Function Description
+ *  Writes the number of objects, followed by the type of each object,
+ *  the position in the list of the object it is attached to, or -1,
+ *  and its fields.
+ *
+ *  \return FALSE if the objects can't be saved.
+ */
+static gboolean encode_objects (GString *out, const GList *objects)
+{
+  GHashTable *positions = g_hash_table_new (NULL, NULL);
+  const GList *iter;
+  gboolean result = TRUE;
+  gint i;
+
+  write_int (out, g_list_length ((GList *) objects));
+
+  for (iter = objects, i = 0; iter != NULL && result; iter = g_list_next (iter), i++) {
+    OBJECT *object = (OBJECT *) iter->data;
+    gpointer owner = NULL;
+
+    write_int (out, object->type);
+
+    /* Attributes always follow the object they are attached to */
+    if (object->attached_to == NULL) {
+      write_int (out, -1);
+    } else if (g_hash_table_lookup_extended (positions, object->attached_to,
+                                             NULL, &owner)) {
+      write_int (out, GPOINTER_TO_INT (owner));
+    } else {
+      result = FALSE;
+    }
+
+    g_hash_table_insert (positions, object, GINT_TO_POINTER (i));
+
+    result = result && encode_object (out, object);
+  }
+
+  g_hash_table_destroy (positions);
+  return result;
+}
+
+/*! \brief Create the list of objects saved by encode_objects().
+ *  \par Function Description
+ *  Creates the objects and attaches attributes to their objects.  Then
+ *  finishes the components the way o_read_buffer() does once their
+ *  attributes have been read.
+ *
+ *  \return the new objects, or NULL if they could not be decoded.
+ */
+static GList *decode_objects (TOPLEVEL *toplevel, CacheReader *reader)
+{
+  GPtrArray *objects;
+  GList *list = NULL;
+  gint count;
+  gint i;
+
+  /* Every object takes at least two integers */
+  count = read_int (reader);
+  if (reader->failed || count < 0 || count > (reader->end - reader->pos) / 8) {
+    reader->failed = TRUE;
+    return NULL;
+  }
+
+  objects = g_ptr_array_sized_new (count);
+
+  for (i = 0; i < count && !reader->failed; i++) {
+    gint type = read_int (reader);
+    gint owner = read_int (reader);
+    OBJECT *object;
+
+    if (reader->failed || owner < -1 || owner >= i) {
+      reader->failed = TRUE;
+      break;
+    }
+
+    object = decode_object (toplevel, reader, type);
+    if (object == NULL) {
+      reader->failed = TRUE;
+      break;
+    }
+
+    g_ptr_array_add (objects, object);
+    list = g_list_prepend (list, object);
+
+    if (owner >= 0) {
+      OBJECT *parent = g_ptr_array_index (objects, owner);
+
+      if (object->type != OBJ_TEXT || parent->attached_to != NULL) {
+        reader->failed = TRUE;
+        break;
+      }
+
+      o_attrib_attach (toplevel, object, parent, FALSE);
+    }
+  }
+
+  list = g_list_reverse (list);
+
+  if (reader->failed) {
+    g_ptr_array_free (objects, TRUE);
+    geda_object_list_delete (toplevel, list);
+    return NULL;
+  }
+
+  for (i = 0; i < objects->len; i++) {
+    OBJECT *object = g_ptr_array_index (objects, i);
+
+    if (object->type == OBJ_COMPLEX || object->type == OBJ_PLACEHOLDER) {
+      o_complex_check_symversion (toplevel, object);
+
+      /* slots only apply to complex objects */
+      if (object->attribs != NULL) {
+        s_slot_update_object (toplevel, object);
+      }
+    }
+  }
+
+  g_ptr_array_free (objects, TRUE);
+  return list;
+}
+
+/*! \brief Get the name of the cache file for some text.
+ *  \return a newly allocated filename.
+ */
+static gchar *cache_filename (const char *buffer, int size)
+{
+  gchar *checksum;
+  gchar *basename;
+  gchar *filename;
+
+  checksum = g_compute_checksum_for_data (G_CHECKSUM_MD5,
+                                          (const guchar *) buffer, size);
+  basename = g_strconcat (checksum, ".bin", NULL);
+  filename = g_build_filename (eda_get_user_cache_dir (), OBJECT_CACHE_DIR,
+                               basename, NULL);
+  g_free (basename);
+  g_free (checksum);
+
+  return filename;
+}
+
+/*! \brief Read the objects from a cache file.
+ *  \par Function Description
+ *  The file must have been written by the same version of libgeda on
+ *  a machine with the same byte order.
+ *
+ *  \return TRUE if the objects were read into \a objects, FALSE if
+ *          there is no usable cache file.
+ */
+static gboolean read_cache_file (TOPLEVEL *toplevel, const gchar *filename,
+                                 GList **objects)
+{
+  GMappedFile *mapped;
+  CacheReader reader;
+  gsize magic_length = strlen (OBJECT_CACHE_MAGIC);
+  gchar *version;
+  gboolean valid;
+
+  mapped = g_mapped_file_new (filename, FALSE, NULL);
+  if (mapped == NULL) return FALSE;
+
+  reader.pos = g_mapped_file_get_contents (mapped);
+  reader.end = reader.pos + g_mapped_file_get_length (mapped);
+  reader.failed = FALSE;
+
+  valid = (reader.end - reader.pos >= (gssize) magic_length &&
+           memcmp (reader.pos, OBJECT_CACHE_MAGIC, magic_length) == 0);
+
+  if (valid) {
+    reader.pos += magic_length;
+
+    valid = (read_int (&reader) == OBJECT_CACHE_BYTE_ORDER &&
+             read_int (&reader) == OBJECT_CACHE_VERSION);
+
+    version = read_string (&reader);
+    valid = valid && version != NULL &&
+            strcmp (version, PACKAGE_DATE_VERSION) == 0;
+    g_free (version);
+  }
+
+  if (valid) {
+    *objects = decode_objects (toplevel, &reader);
+
+    valid = !reader.failed;
+    if (valid && reader.pos != reader.end) {
+      geda_object_list_delete (toplevel, *objects);
+      valid = FALSE;
+    }
+  }
+
+#if GLIB_CHECK_VERSION(2,22,0)
+  g_mapped_file_unref (mapped);
+#else
+  g_mapped_file_free (mapped);
+#endif
+
+  return valid;
+}
+
+/*! \brief Save objects to a cache file.
+ *  \par Function Description
+ *  Nothing is written if some of the objects can't be saved.  Errors
+ *  are ignored, as the objects can always be read from the text.
+ */
+static void write_cache_file (const gchar *filename, const GList *objects)
+{
+  GString *out = g_string_new (OBJECT_CACHE_MAGIC);
+  gchar *dirname;
+
+  write_int (out, OBJECT_CACHE_BYTE_ORDER);
+  write_int (out, OBJECT_CACHE_VERSION);
+  write_string (out, PACKAGE_DATE_VERSION);
+
+  if (encode_objects (out, objects)) {
+    dirname = g_path_get_dirname (filename);
+    if (g_mkdir_with_parents (dirname, 0755) == 0) {
+      g_file_set_contents (filename, out->str, out->len, NULL);
+    }
+    g_free (dirname);
+  }
+
+  g_string_free (out, TRUE);
+}
+
+/*! \brief Read objects from a buffer, using the object cache
+ *  \par Function Description
+ *  Behaves like o_read_buffer().  If the object cache is enabled, the
+ *  objects are read from the cache file saved for the same text, if
+ *  there is one.  Otherwise, the text is parsed and the objects saved
+ *  to a new cache file.
+ *
+ *  \param [in]     toplevel     The current TOPLEVEL structure.
+ *  \param [in]     object_list  The object_list to read data to.
+ *  \param [in]     buffer       The memory buffer to read from.
+ *  \param [in]     size         The size of the buffer.
+ *  \param [in]     name         The name to describe the data with.
+ *  \param [in,out] err          #GError structure for error reporting, or
+ *                               NULL to disable error reporting
+ *  \return GList of objects if successful read, or NULL on error.
+ */
+GList *o_cache_read_buffer (TOPLEVEL *toplevel, GList *object_list,
+                            char *buffer, int size,
+                            const char *name, GError **err)
+{
+  GError *tmp_err = NULL;
+  GList *objects;
+  gchar *filename;
+
+  g_return_val_if_fail ((buffer != NULL), NULL);
+
+  if (!default_object_cache) {
+    return o_read_buffer (toplevel, object_list, buffer, size, name, err);
+  }
+
+  if (size < 0) {
+    size = strlen (buffer);
+  }
+
+  filename = cache_filename (buffer, size);
+
+  if (!read_cache_file (toplevel, filename, &objects)) {
+    objects = o_read_buffer (toplevel, NULL, buffer, size, name, &tmp_err);
+
+    if (tmp_err != NULL) {
+      g_propagate_error (err, tmp_err);
+      g_free (filename);
+      return NULL;
+    }
+
+    if (objects != NULL) {
+      write_cache_file (filename, objects);
+    }
+  }
+
+  g_free (filename);
+  return g_list_concat (object_list, objects);
+}
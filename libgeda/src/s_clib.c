@@ -113,6 +113,9 @@
 #include <config.h>
 
 #include <stdio.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
 #include <glib.h>
 
 #ifdef HAVE_STRING_H
@@ -128,8 +131,6 @@
 #define WEXITSTATUS(x) 0
 #endif
 
-#include <time.h>
-
 #include "libgeda_priv.h"
 
 /* Constant definitions
@@ -146,10 +147,17 @@
 /*! Library command mode used to fetch symbol data */
 #define CLIB_DATA_CMD       "get"
 
-/*! Maximum number of symbol cache entries */
-#define CLIB_MAX_SYMBOL_CACHE 128
-/*! When symbol cache gets full, remove down to this level */
-#define CLIB_MIN_SYMBOL_CACHE 96
+/*! First line of a directory index file */
+#define CLIB_INDEX_HEADER   "gEDA component library index 1"
+
+/*! Subdirectory of the user cache directory holding index files */
+#define CLIB_INDEX_DIR      "clib"
+
+/*! Maximum number of threads used to scan directory sources */
+#define CLIB_SCAN_THREADS   4
+
+/*! Default number of bytes the symbol cache may use */
+#define CLIB_DEFAULT_SYMBOL_CACHE_SIZE (4 * 1024 * 1024)
 
 /* Type definitions
  * ================
@@ -174,6 +182,8 @@ struct _CLibSource {
   gchar *name;
   /*! Available symbols (#CLibSymbol) */
   GList *symbols;
+  /*! Available symbols indexed by name */
+  GHashTable *symbol_index;
 
   /*! Path to directory */
   gchar *directory;
@@ -195,6 +205,36 @@ struct _CLibSymbol {
   CLibSource *source;
   /*! The name of this symbol */
   gchar *name;
+  /*! The name of this symbol in lowercase, for substring searches */
+  gchar *search_name;
+};
+
+/*! A directory source scan, possibly running on a worker thread */
+typedef struct _DirectoryScan DirectoryScan;
+struct _DirectoryScan {
+  /*! The source being scanned */
+  CLibSource *source;
+  /*! Set if the directory could not be read */
+  GError *error;
+};
+
+/*! States of the parsed prototype of a cached symbol */
+enum CacheProtoState {
+  /*! The symbol data has not been parsed yet */
+  CACHE_PROTO_NONE = 0,
+  /*! The symbol data was parsed into #CacheEntry.prototype */
+  CACHE_PROTO_VALID,
+  /*! The symbol data could not be parsed */
+  CACHE_PROTO_FAILED,
+};
+
+/*! The objects parsed from the data of a symbol, shared by the symbol
+ *  cache and the callers of s_clib_symbol_get_prototype() */
+struct _CLibPrototype {
+  /*! Number of references to the prototype */
+  gint refcount;
+  /*! The objects, untransformed */
+  GList *objects;
 };
 
 /*! Symbol data cache entry */
@@ -204,8 +244,17 @@ struct _CacheEntry {
   CLibSymbol *ptr;
   /*! Symbol data */
   gchar *data;
-  /*! Last access */
-  time_t accessed;
+  /*! Link in #clib_symbol_lru */
+  GList *lru_link;
+  /*! Approximate number of bytes used by this entry */
+  gsize size;
+  /*! Distinguishes this entry from any other entry of the same
+   *  symbol, before or after it */
+  guint serial;
+  /*! Whether the symbol data has been parsed */
+  enum CacheProtoState prototype_state;
+  /*! The objects parsed from the symbol data, holding a reference */
+  CLibPrototype *prototype;
 };
 
 /* Static variables
@@ -215,16 +264,60 @@ struct _CacheEntry {
 /*! Holds the list of all known component sources */
 static GList *clib_sources = NULL;
 
+/*! Worker threads scanning directory sources, if threads are
+ *  supported and a scan has been started */
+static GThreadPool *clib_scan_pool = NULL;
+
+/*! The #DirectoryScan records of all scans started since the last call
+ *  to wait_for_scans() */
+static GList *clib_pending_scans = NULL;
+
 /*! Caches results of s_clib_search().  The key of the hashtable is a
  *  string describing the search that was carried out, and the value
  *  is a list of symbol pointers. */
 static GHashTable *clib_search_cache = NULL;
 
+/*! Substring search index over the names of all symbols.  The key of
+ *  the hashtable is a trigram of a lowercased symbol name packed into
+ *  an integer, and the value is a \b GPtrArray of all the symbols
+ *  whose names contain it, in the order they are searched.  Built on
+ *  demand, and discarded along with #clib_search_cache. */
+static GHashTable *clib_trigram_index = NULL;
+
 /*! Caches symbol data.  The key of the hashtable is a symbol pointer,
- *  and the value is a #CacheEntry structure containing the data and
- *  the time it was last used. */
+ *  and the value is a #CacheEntry structure containing the data. */
 static GHashTable *clib_symbol_cache = NULL;
 
+/*! The entries of #clib_symbol_cache, most recently used first */
+static GQueue clib_symbol_lru = G_QUEUE_INIT;
+
+/*! Number of bytes used by the entries of #clib_symbol_cache, and the
+ *  number of bytes they may use */
+static gsize clib_symbol_cache_size = 0;
+static gsize clib_symbol_cache_budget = CLIB_DEFAULT_SYMBOL_CACHE_SIZE;
+
+/*! Symbol cache statistics */
+static guint64 clib_symbol_cache_hits = 0;
+static guint64 clib_symbol_cache_misses = 0;
+static guint64 clib_symbol_cache_evictions = 0;
+
+/*! The serial number of the next entry of #clib_symbol_cache */
+static guint clib_symbol_cache_serial = 0;
+
+/*! Protects the sources and caches above, so that symbols can be
+ *  looked up and loaded on several threads at once.  It is recursive
+ *  because some of the functions taking it call each other.  It is
+ *  not held while symbol data is parsed. */
+#if GLIB_CHECK_VERSION(2,32,0)
+static GRecMutex clib_mutex;
+#define CLIB_LOCK()   g_rec_mutex_lock (&clib_mutex)
+#define CLIB_UNLOCK() g_rec_mutex_unlock (&clib_mutex)
+#else
+static GStaticRecMutex clib_mutex = G_STATIC_REC_MUTEX_INIT;
+#define CLIB_LOCK()   g_static_rec_mutex_lock (&clib_mutex)
+#define CLIB_UNLOCK() g_static_rec_mutex_unlock (&clib_mutex)
+#endif
+
 /* Local static functions
  * ======================
  */
@@ -233,17 +326,31 @@ static void free_symbol_cache_entry (gpointer data);
 static void free_source (gpointer data, gpointer user_data);
 static gint compare_source_name (gconstpointer a, gconstpointer b);
 static gint compare_symbol_name (gconstpointer a, gconstpointer b);
-static void cache_find_oldest (gpointer key, gpointer value, gpointer user_data);
+static void cache_trim (gsize budget);
+static void free_trigram_list (gpointer data);
+static void build_trigram_index (void);
+static GList *search_substring (const gchar *pattern);
+static GList *search (const gchar *pattern, const CLibSearchMode mode);
 static gchar *run_source_command (const gchar *command);
+static void source_clear_symbols (CLibSource *source);
+static CLibSymbol *source_add_symbol (CLibSource *source, gchar *name);
 static CLibSymbol *source_has_symbol (const CLibSource *source,
 				      const gchar *name);
 static gchar *uniquify_source_name (const gchar *name);
+static gchar *index_filename (const gchar *directory);
+static gboolean read_directory_index (CLibSource *source, time_t mtime);
+static void write_directory_index (CLibSource *source, time_t mtime);
+static gboolean scan_directory (CLibSource *source, GError **error);
+static void scan_directory_worker (gpointer data, gpointer user_data);
 static void refresh_directory (CLibSource *source);
+static void wait_for_scans (void);
 static void refresh_command (CLibSource *source);
 static void refresh_scm (CLibSource *source);
 static gchar *get_data_directory (const CLibSymbol *symbol);
 static gchar *get_data_command (const CLibSymbol *symbol);
+static void *get_data_scm_guile (void *data);
 static gchar *get_data_scm (const CLibSymbol *symbol);
+static CacheEntry *symbol_cache_get (const CLibSymbol *symbol);
 
 /*! \brief Initialise the component library.
  *  \par Function Description
@@ -293,6 +400,7 @@ static void free_symbol (gpointer data, gpointer user_data)
       g_free (symbol->name);
       symbol->name = NULL;
     }
+    g_free (symbol->search_name);
     g_free(symbol);
   }
 }
@@ -305,7 +413,12 @@ static void free_symbol_cache_entry (gpointer data)
 {
   CacheEntry *entry = data;
   g_return_if_fail (entry != NULL);
+  g_queue_delete_link (&clib_symbol_lru, entry->lru_link);
+  clib_symbol_cache_size -= entry->size;
   g_free (entry->data);
+  if (entry->prototype != NULL) {
+    s_clib_prototype_unref (entry->prototype);
+  }
   g_free (entry);
 }
 
@@ -326,6 +439,10 @@ static void free_source (gpointer data, gpointer user_data)
       g_list_free (source->symbols);
       source->symbols = NULL;
     }
+    if (source->symbol_index != NULL) {
+      g_hash_table_destroy (source->symbol_index);
+      source->symbol_index = NULL;
+    }
     if (source->directory != NULL) {
       g_free (source->directory);
       source->directory = NULL;
@@ -352,11 +469,25 @@ static void free_source (gpointer data, gpointer user_data)
  */
 void s_clib_free ()
 {
+  CLIB_LOCK ();
+
+  wait_for_scans ();
+
   if (clib_sources != NULL) {
     g_list_foreach (clib_sources, (GFunc) free_source, NULL);
     g_list_free (clib_sources);
     clib_sources = NULL;
   }
+
+  /* The caches are keyed by the symbols just freed */
+  if (clib_search_cache != NULL) {
+    s_clib_flush_search_cache ();
+  }
+  if (clib_symbol_cache != NULL) {
+    s_clib_flush_symbol_cache ();
+  }
+
+  CLIB_UNLOCK ();
 }
 
 /*! \brief Compare two component sources by name.
@@ -409,19 +540,27 @@ static gint compare_symbol_name (gconstpointer a, gconstpointer b)
   return strcasecmp(sym1->name, sym2->name);
 }
 
-/*! \brief Iterator callback for finding oldest symbol cache entry
+/*! \brief Evict least recently used symbol cache entries
  *  \par Function Description
+ *  Removes entries from the end of the LRU list until the cache uses
+ *  no more than \a budget bytes.  The most recently used entry is
+ *  never evicted, so that an entry larger than the budget can still be
+ *  used by the caller which just requested it.
+ *
  *  Private function used only in s_clib.c.
  */
-static void cache_find_oldest (gpointer key,
-                               gpointer value,
-                               gpointer user_data)
+static void cache_trim (gsize budget)
 {
-  CacheEntry *current = value;
-  CacheEntry **oldest = user_data;
+  GList *link = clib_symbol_lru.tail;
+
+  while (clib_symbol_cache_size > budget &&
+         link != NULL && link != clib_symbol_lru.head) {
+    CacheEntry *oldest = link->data;
 
-  if (current->accessed < (*oldest)->accessed) {
-    *oldest = current;
+    link = g_list_previous (link);
+
+    g_hash_table_remove (clib_symbol_cache, oldest->ptr);
+    clib_symbol_cache_evictions++;
   }
 }
 
@@ -495,18 +634,67 @@ static gchar *run_source_command (const gchar *command)
  */
 GList *s_clib_get_sources (const gboolean sorted)
 {
-  GList *l = g_list_copy(clib_sources);
+  GList *l;
+
+  CLIB_LOCK ();
+  l = g_list_copy(clib_sources);
+  CLIB_UNLOCK ();
+
   if (sorted) {
     l = g_list_sort (l, (GCompareFunc) compare_source_name);
   }
   return l;
 }
 
+/*! \brief Remove all symbols from a source.
+ *  \par Function Description
+ *  Frees the symbols of \a source and empties its symbol index,
+ *  creating the index if necessary.
+ *
+ *  Private function used only in s_clib.c.
+ */
+static void source_clear_symbols (CLibSource *source)
+{
+  g_list_foreach (source->symbols, (GFunc) free_symbol, NULL);
+  g_list_free (source->symbols);
+  source->symbols = NULL;
+
+  if (source->symbol_index != NULL) {
+    g_hash_table_remove_all (source->symbol_index);
+  } else {
+    source->symbol_index = g_hash_table_new (g_str_hash, g_str_equal);
+  }
+}
+
+/*! \brief Add a symbol to a source.
+ *  \par Function Description
+ *  Creates a new symbol called \a name, which is owned by the symbol
+ *  afterwards, and prepends it to the symbol list of \a source.  The
+ *  caller should check with source_has_symbol() that there is no
+ *  symbol with the same name yet.
+ *
+ *  Private function used only in s_clib.c.
+ */
+static CLibSymbol *source_add_symbol (CLibSource *source, gchar *name)
+{
+  CLibSymbol *symbol = g_new0 (CLibSymbol, 1);
+
+  symbol->source = source;
+  symbol->name = name;
+  symbol->search_name = g_ascii_strdown (name, -1);
+
+  /* Prepend because it's faster and it doesn't matter what order we
+   * add them. */
+  source->symbols = g_list_prepend (source->symbols, symbol);
+  g_hash_table_insert (source->symbol_index, symbol->name, symbol);
+
+  return symbol;
+}
+
 /*! \brief Find any symbols within a source with a given name.
  *  \par Function Description
- *  Iterates through the symbol list of the given source, checking if
- *  there is already a symbol with the given name.  If there is
- *  such a symbol, it is returned.
+ *  Checks if the given source already has a symbol with the given
+ *  name.  If there is such a symbol, it is returned.
  *
  *  \param source The source to check.
  *  \param name The symbol name to look for.
@@ -515,19 +703,9 @@ GList *s_clib_get_sources (const gboolean sorted)
 static CLibSymbol *source_has_symbol (const CLibSource *source,
 				      const gchar *name)
 {
-  GList *symlist;
-  CLibSymbol *symbol;
-
-  for (symlist = g_list_first(source->symbols);
-       symlist != NULL;
-       symlist = g_list_next(symlist)) {
-
-    symbol = (CLibSymbol *) symlist->data;
+  if (source->symbol_index == NULL) return NULL;
 
-    if (strcmp (symbol->name, name) == 0) return symbol;
-  }
-
-  return NULL;
+  return (CLibSymbol *) g_hash_table_lookup (source->symbol_index, name);
 }
 
 /*! \brief Make sure a source name is unique.
@@ -559,56 +737,188 @@ static gchar *uniquify_source_name (const gchar *name)
   return newname;
 }
 
-/*! \brief Rescan a directory for symbols.
+/*! \brief Get the index file name for a directory source.
  *  \par Function Description
- *  Rescans a directory for symbols.
+ *  Returns the name of the file in the user cache directory used to
+ *  store the list of symbols found in \a directory.  The return value
+ *  should be freed with g_free().
+ *
+ *  Private function used only in s_clib.c.
+ */
+static gchar *index_filename (const gchar *directory)
+{
+  gchar *checksum;
+  gchar *basename;
+  gchar *filename;
+
+  checksum = g_compute_checksum_for_string (G_CHECKSUM_MD5, directory, -1);
+  basename = g_strconcat (checksum, ".idx", NULL);
+  filename = g_build_filename (eda_get_user_cache_dir (), CLIB_INDEX_DIR,
+                               basename, NULL);
+  g_free (basename);
+  g_free (checksum);
+
+  return filename;
+}
+
+/*! \brief Load the symbol list of a directory source from its index.
+ *  \par Function Description
+ *  Reads the index file written by write_directory_index() for the
+ *  directory of \a source.  If the index exists and was written for
+ *  the same directory with the same modification time \a mtime, the
+ *  symbols listed in it are added to \a source, in order.  Since
+ *  adding, removing or renaming a file changes the modification time
+ *  of its directory, the symbol list is then up to date.
+ *
+ *  Private function used only in s_clib.c.
+ *
+ *  \return TRUE if the symbols were loaded from the index, FALSE if
+ *          the directory must be scanned.
+ */
+static gboolean read_directory_index (CLibSource *source, time_t mtime)
+{
+  gchar *filename = index_filename (source->directory);
+  gchar *contents;
+  gchar **lines;
+  gchar *expected_mtime;
+  gboolean valid;
+  gint i;
+
+  if (!g_file_get_contents (filename, &contents, NULL, NULL)) {
+    g_free (filename);
+    return FALSE;
+  }
+  g_free (filename);
+
+  lines = g_strsplit (contents, "\n", -1);
+  g_free (contents);
+
+  expected_mtime = g_strdup_printf ("%" G_GINT64_FORMAT, (gint64) mtime);
+
+  valid = (g_strv_length (lines) >= 3 &&
+           strcmp (lines[0], CLIB_INDEX_HEADER) == 0 &&
+           strcmp (lines[1], source->directory) == 0 &&
+           strcmp (lines[2], expected_mtime) == 0);
+
+  g_free (expected_mtime);
+
+  if (valid) {
+    for (i = 3; lines[i] != NULL; i++) {
+      if (lines[i][0] == '\0') continue;
+      if (source_has_symbol (source, lines[i]) != NULL) continue;
+
+      source_add_symbol (source, g_strdup (lines[i]));
+    }
+
+    source->symbols = g_list_reverse (source->symbols);
+  }
+
+  g_strfreev (lines);
+
+  return valid;
+}
+
+/*! \brief Save the symbol list of a directory source to its index.
+ *  \par Function Description
+ *  Writes the names of the symbols of \a source to an index file in
+ *  the user cache directory, along with the directory name and its
+ *  modification time \a mtime, so that later processes can skip
+ *  scanning the directory while it is unchanged.
+ *
+ *  The index is not written if the directory was modified in the
+ *  last couple of seconds, as further changes within the resolution
+ *  of the timestamp would then go unnoticed.  Failure to write the
+ *  index is silently ignored.
+ *
+ *  Private function used only in s_clib.c.
+ */
+static void write_directory_index (CLibSource *source, time_t mtime)
+{
+  GString *contents;
+  GList *iter;
+  gchar *filename;
+  gchar *dirname;
+
+  if (mtime >= time (NULL) - 1) return;
+
+  contents = g_string_new (CLIB_INDEX_HEADER "\n");
+  g_string_append_printf (contents, "%s\n%" G_GINT64_FORMAT "\n",
+                          source->directory, (gint64) mtime);
+
+  for (iter = source->symbols; iter != NULL; iter = g_list_next (iter)) {
+    CLibSymbol *symbol = (CLibSymbol *) iter->data;
+
+    /* Names which cannot be stored one per line are never indexed */
+    if (strchr (symbol->name, '\n') != NULL) {
+      g_string_free (contents, TRUE);
+      return;
+    }
+
+    g_string_append (contents, symbol->name);
+    g_string_append_c (contents, '\n');
+  }
+
+  filename = index_filename (source->directory);
+  dirname = g_path_get_dirname (filename);
+
+  if (g_mkdir_with_parents (dirname, 0755) == 0) {
+    g_file_set_contents (filename, contents->str, contents->len, NULL);
+  }
+
+  g_free (dirname);
+  g_free (filename);
+  g_string_free (contents, TRUE);
+}
+
+/*! \brief Scan a directory for symbols.
+ *  \par Function Description
+ *  Adds the symbols found in the directory of \a source to its empty
+ *  symbol list.  If component library indexing is enabled, the symbol
+ *  list is read from the directory's index file when the directory has
+ *  not changed since the index was written, and the index is updated
+ *  after a scan otherwise.
+ *
+ *  Only \a source is modified and nothing is logged, so that
+ *  independent directories can be scanned concurrently.
  *
  *  \todo Does this need to do something more sane with subdirectories
  *  than just skipping them silently?
  *
  *  Private function used only in s_clib.c.
+ *
+ *  \return FALSE if the directory could not be read, with \a error
+ *          set.
  */
-static void refresh_directory (CLibSource *source)
+static gboolean scan_directory (CLibSource *source, GError **error)
 {
-  CLibSymbol *symbol;
   GDir *dir;
   const gchar *entry;
   gchar *low_entry;
   gchar *fullpath;
   gboolean isfile;
-  GError *e = NULL;
+  gboolean use_index;
+  struct stat st;
 
-  g_return_if_fail (source != NULL);
-  g_return_if_fail (source->type == CLIB_DIR);
+  /* Index files are keyed by directory name, so relative paths can't
+   * be indexed. */
+  use_index = (default_component_library_index &&
+               g_path_is_absolute (source->directory) &&
+               g_stat (source->directory, &st) == 0);
 
-  /* Clear the current symbol list */
-  g_list_foreach (source->symbols, (GFunc) free_symbol, NULL);
-  g_list_free (source->symbols);
-  source->symbols = NULL;
+  if (use_index && read_directory_index (source, st.st_mtime)) {
+    return TRUE;
+  }
 
   /* Open the directory for reading. */
-  dir = g_dir_open (source->directory, 0, &e);
-
-  if (e != NULL) {
-    s_log_message (_("Failed to open directory [%s]: %s\n"),
-		   source->directory, e->message);
-    g_error_free (e);
-    return;
+  dir = g_dir_open (source->directory, 0, error);
+  if (dir == NULL) {
+    return FALSE;
   }
 
   while ((entry = g_dir_read_name (dir)) != NULL) {
     /* skip ".", ".." & hidden files */
     if (entry[0] == '.') continue;
 
-    /* skip subdirectories (for now) */
-    fullpath = g_build_filename (source->directory, entry, NULL);
-    isfile = g_file_test (fullpath, G_FILE_TEST_IS_REGULAR);
-    g_free (fullpath);
-    if (!isfile) continue;
-
-    /* skip filenames that we already know about. */
-    if (source_has_symbol (source, entry) != NULL) continue;
-
     /* skip filenames which don't have the right suffix. */
     low_entry = g_utf8_strdown (entry, -1);
     if (!g_str_has_suffix (low_entry, SYM_FILENAME_FILTER)) {
@@ -617,14 +927,17 @@ static void refresh_directory (CLibSource *source)
     }
     g_free (low_entry);
 
-    /* Create and add new symbol record */
-    symbol = g_new0 (CLibSymbol, 1);
-    symbol->source = source;
-    symbol->name = g_strdup(entry);
+    /* skip filenames that we already know about. */
+    if (source_has_symbol (source, entry) != NULL) continue;
+
+    /* skip subdirectories (for now) */
+    fullpath = g_build_filename (source->directory, entry, NULL);
+    isfile = g_file_test (fullpath, G_FILE_TEST_IS_REGULAR);
+    g_free (fullpath);
+    if (!isfile) continue;
 
-    /* Prepend because it's faster and it doesn't matter what order we
-     * add them. */
-    source->symbols = g_list_prepend (source->symbols, symbol);
+    /* Create and add new symbol record */
+    source_add_symbol (source, g_strdup (entry));
   }
 
   entry = NULL;
@@ -634,6 +947,95 @@ static void refresh_directory (CLibSource *source)
   source->symbols = g_list_sort (source->symbols,
 				 (GCompareFunc) compare_symbol_name);
 
+  if (use_index) {
+    write_directory_index (source, st.st_mtime);
+  }
+
+  return TRUE;
+}
+
+/*! \brief Thread pool callback for scanning a directory.
+ *  \par Function Description
+ *  Private function used only in s_clib.c.
+ */
+static void scan_directory_worker (gpointer data, gpointer user_data)
+{
+  DirectoryScan *scan = data;
+
+  scan_directory (scan->source, &scan->error);
+}
+
+/*! \brief Rescan a directory for symbols.
+ *  \par Function Description
+ *  Clears the symbol list of \a source and starts rescanning its
+ *  directory.  If threads are supported, the scan is carried out on a
+ *  worker thread, so several directories can be scanned at the same
+ *  time; wait_for_scans() must be called before the symbols of any
+ *  source are used.
+ *
+ *  Private function used only in s_clib.c.
+ */
+static void refresh_directory (CLibSource *source)
+{
+  DirectoryScan *scan;
+
+  g_return_if_fail (source != NULL);
+  g_return_if_fail (source->type == CLIB_DIR);
+
+  /* Clear the current symbol list */
+  source_clear_symbols (source);
+
+  scan = g_new0 (DirectoryScan, 1);
+  scan->source = source;
+  clib_pending_scans = g_list_prepend (clib_pending_scans, scan);
+
+  if (clib_scan_pool == NULL && g_thread_supported ()) {
+    clib_scan_pool = g_thread_pool_new (scan_directory_worker, NULL,
+                                        CLIB_SCAN_THREADS, FALSE, NULL);
+  }
+
+  if (clib_scan_pool != NULL) {
+    g_thread_pool_push (clib_scan_pool, scan, NULL);
+  } else {
+    scan_directory_worker (scan, NULL);
+  }
+}
+
+/*! \brief Wait for directory scans to finish.
+ *  \par Function Description
+ *  Waits until all directory scans started by refresh_directory() are
+ *  complete, and reports any errors.
+ *
+ *  Private function used only in s_clib.c.
+ */
+static void wait_for_scans ()
+{
+  GList *iter;
+
+  if (clib_pending_scans == NULL) return;
+
+  if (clib_scan_pool != NULL) {
+    g_thread_pool_free (clib_scan_pool, FALSE, TRUE);
+    clib_scan_pool = NULL;
+  }
+
+  clib_pending_scans = g_list_reverse (clib_pending_scans);
+
+  for (iter = clib_pending_scans; iter != NULL; iter = g_list_next (iter)) {
+    DirectoryScan *scan = (DirectoryScan *) iter->data;
+
+    if (scan->error != NULL) {
+      s_log_message (_("Failed to open directory [%s]: %s\n"),
+                     scan->source->directory, scan->error->message);
+      g_error_free (scan->error);
+    }
+
+    g_free (scan);
+  }
+
+  g_list_free (clib_pending_scans);
+  clib_pending_scans = NULL;
+
   s_clib_flush_search_cache();
   s_clib_flush_symbol_cache();
 }
@@ -650,16 +1052,13 @@ static void refresh_command (CLibSource *source)
   gchar *cmdout;
   TextBuffer *tb;
   const gchar *line;
-  CLibSymbol *symbol;
   gchar *name;
 
   g_return_if_fail (source != NULL);
   g_return_if_fail (source->type == CLIB_CMD);
 
   /* Clear the current symbol list */
-  g_list_foreach (source->symbols, (GFunc) free_symbol, NULL);
-  g_list_free (source->symbols);
-  source->symbols = NULL;
+  source_clear_symbols (source);
 
   /* Run the command to get the list of symbols */
   cmdout = run_source_command (source->list_cmd);
@@ -681,13 +1080,7 @@ static void refresh_command (CLibSource *source)
       continue;
     }
 
-    symbol = g_new0 (CLibSymbol, 1);
-    symbol->source = source;
-    symbol->name = name;
-
-    /* Prepend because it's faster and it doesn't matter what order we
-     * add them. */
-    source->symbols = g_list_prepend (source->symbols, symbol);
+    source_add_symbol (source, name);
   }
 
   s_textbuffer_free (tb);
@@ -712,16 +1105,13 @@ static void refresh_scm (CLibSource *source)
 {
   SCM symlist;
   SCM symname;
-  CLibSymbol *symbol;
   char *tmp;
 
   g_return_if_fail (source != NULL);
   g_return_if_fail (source->type == CLIB_SCM);
 
   /* Clear the current symbol list */
-  g_list_foreach (source->symbols, (GFunc) free_symbol, NULL);
-  g_list_free (source->symbols);
-  source->symbols = NULL;
+  source_clear_symbols (source);
 
   symlist = scm_call_0 (source->list_fn);
 
@@ -737,18 +1127,15 @@ static void refresh_scm (CLibSource *source)
       s_log_message (_("Non-string symbol name while scanning library [%s]\n"),
 		     source->name);
     } else {
-      symbol = g_new0 (CLibSymbol, 1);
-      symbol->source = source;
-
       /* Need to make sure that the correct free() function is called
        * on strings allocated by Guile. */
       tmp = scm_to_utf8_string (symname);
-      symbol->name = g_strdup(tmp);
-      free (tmp);
 
-      /* Prepend because it's faster and it doesn't matter what order we
-       * add them. */
-      source->symbols = g_list_prepend (source->symbols, symbol);
+      /* skip symbols already known about */
+      if (source_has_symbol (source, tmp) == NULL) {
+        source_add_symbol (source, g_strdup (tmp));
+      }
+      free (tmp);
     }
 
     symlist = SCM_CDR (symlist);
@@ -766,13 +1153,19 @@ static void refresh_scm (CLibSource *source)
  *  \par Function Description
  *  Resets the list of symbols available from each source, and
  *  repopulates it from scratch.  Useful e.g. for checking for new
- *  symbols.
+ *  symbols.  Directory sources are scanned in parallel, if threads are
+ *  supported, while command and Scheme sources are refreshed.
  */
 void s_clib_refresh ()
 {
   GList *sourcelist;
   CLibSource *source;
 
+  CLIB_LOCK ();
+
+  /* Don't clear any source which is still being scanned */
+  wait_for_scans ();
+
   for (sourcelist = clib_sources;
        sourcelist != NULL;
        sourcelist = g_list_next(sourcelist)) {
@@ -795,6 +1188,10 @@ void s_clib_refresh ()
         break;
       }
   }
+
+  wait_for_scans ();
+
+  CLIB_UNLOCK ();
 }
 
 /*! \brief Get a named component source.
@@ -809,19 +1206,23 @@ void s_clib_refresh ()
 const CLibSource *s_clib_get_source_by_name (const gchar *name)
 {
   GList *sourcelist;
-  CLibSource *source;
+  CLibSource *source = NULL;
+
+  CLIB_LOCK ();
 
   for (sourcelist = clib_sources;
        sourcelist != NULL;
        sourcelist = g_list_next(sourcelist)) {
 
-    source = (CLibSource *) sourcelist->data;
-    if (strcmp (source->name, name) == 0) {
-      return source;
+    if (strcmp (((CLibSource *) sourcelist->data)->name, name) == 0) {
+      source = (CLibSource *) sourcelist->data;
+      break;
     }
   }
 
-  return NULL;
+  CLIB_UNLOCK ();
+
+  return source;
 }
 
 /*! \brief Add a directory of symbol files to the library
@@ -846,6 +1247,8 @@ const CLibSource *s_clib_add_directory (const gchar *directory,
     return NULL;
   }
 
+  CLIB_LOCK ();
+
   if (name == NULL) {
     intname = g_path_get_basename (directory);
     realname = uniquify_source_name (intname);
@@ -864,6 +1267,8 @@ const CLibSource *s_clib_add_directory (const gchar *directory,
   /* Sources added later get scanned earlier */
   clib_sources = g_list_prepend (clib_sources, source);
 
+  CLIB_UNLOCK ();
+
   return source;
 }
 
@@ -894,6 +1299,8 @@ const CLibSource *s_clib_add_command (const gchar *list_cmd,
     return NULL;
   }
 
+  CLIB_LOCK ();
+
   realname = uniquify_source_name (name);
 
   if (list_cmd == NULL || get_cmd == NULL) {
@@ -914,6 +1321,8 @@ const CLibSource *s_clib_add_command (const gchar *list_cmd,
   /* Sources added later get sacnned earlier */
   clib_sources = g_list_prepend (clib_sources, source);
 
+  CLIB_UNLOCK ();
+
   return source;
 }
 
@@ -941,12 +1350,16 @@ const CLibSource *s_clib_add_scm (SCM listfunc, SCM getfunc, const gchar *name)
     return NULL;
   }
 
+  CLIB_LOCK ();
+
   realname = uniquify_source_name (name);
 
   if (scm_is_false (scm_procedure_p (listfunc))
       && scm_is_false (scm_procedure_p (getfunc))) {
     s_log_message (_("Cannot add Scheme-library [%s]: callbacks must be closures\n"),
 		   realname);
+    g_free (realname);
+    CLIB_UNLOCK ();
     return NULL;
   }
 
@@ -960,6 +1373,8 @@ const CLibSource *s_clib_add_scm (SCM listfunc, SCM getfunc, const gchar *name)
 
   clib_sources = g_list_prepend (clib_sources, source);
 
+  CLIB_UNLOCK ();
+
   return source;
 }
 
@@ -989,8 +1404,16 @@ const gchar *s_clib_source_get_name (const CLibSource *source)
  */
 GList *s_clib_source_get_symbols (const CLibSource *source)
 {
+  GList *symbols;
+
   if (source == NULL) return NULL;
-  return g_list_copy(source->symbols);
+
+  CLIB_LOCK ();
+  wait_for_scans ();
+  symbols = g_list_copy(source->symbols);
+  CLIB_UNLOCK ();
+
+  return symbols;
 }
 
 
@@ -1111,23 +1534,18 @@ static gchar *get_data_command (const CLibSymbol *symbol)
 
 /*! \brief Get symbol data from a Scheme-based component source.
  *  \par Function Description
- *  Get symbol data from a Scheme-based component source.  The return
- *  value should be free()'d when no longer needed.
+ *  Calls the get function of the source of \a data, which must be a
+ *  #CLibSymbol, in Guile mode.
  *
  *  Private function used only in s_clib.c.
- *
- *  \param symbol Symbol to get data for.
- *  \return Allocated buffer containing symbol data.
  */
-static gchar *get_data_scm (const CLibSymbol *symbol)
+static void *get_data_scm_guile (void *data)
 {
+  const CLibSymbol *symbol = data;
   SCM symdata;
   char *tmp;
   gchar *result;
 
-  g_return_val_if_fail ((symbol != NULL), NULL);
-  g_return_val_if_fail ((symbol->source->type == CLIB_SCM), NULL);
-
   symdata = scm_call_1 (symbol->source->get_fn,
 			scm_from_utf8_string (symbol->name));
 
@@ -1146,23 +1564,42 @@ static gchar *get_data_scm (const CLibSymbol *symbol)
   return result;
 }
 
-/*! \brief Get symbol data.
+/*! \brief Get symbol data from a Scheme-based component source.
  *  \par Function Description
- *  Get the unparsed gEDA-format data corresponding to a symbol from
- *  the symbol's data source.  The return value should be free()'d
- *  when no longer needed.
+ *  Get symbol data from a Scheme-based component source.  The return
+ *  value should be free()'d when no longer needed.
  *
- *  On failure, returns \b NULL (the error will be logged).
+ *  Private function used only in s_clib.c.
  *
  *  \param symbol Symbol to get data for.
  *  \return Allocated buffer containing symbol data.
  */
-gchar *s_clib_symbol_get_data (const CLibSymbol *symbol)
+static gchar *get_data_scm (const CLibSymbol *symbol)
+{
+  g_return_val_if_fail ((symbol != NULL), NULL);
+  g_return_val_if_fail ((symbol->source->type == CLIB_SCM), NULL);
+
+  /* Symbols may be loaded on threads which are not in Guile mode */
+  return scm_with_guile (get_data_scm_guile, (void *) symbol);
+}
+
+/*! \brief Get the symbol data cache entry of a symbol.
+ *  \par Function Description
+ *  Looks \a symbol up in the symbol data cache.  If it is not there
+ *  yet, the data is fetched from the symbol's source and a new cache
+ *  entry is created, evicting the least recently used entries if the
+ *  cache is full.
+ *
+ *  Private function used only in s_clib.c.
+ *
+ *  \param symbol Symbol to get the cache entry of.
+ *  \return The cache entry, or NULL if the data could not be fetched.
+ */
+static CacheEntry *symbol_cache_get (const CLibSymbol *symbol)
 {
   CacheEntry *cached;
   gchar *data;
   gpointer symptr;
-  gint n;
 
   g_return_val_if_fail ((symbol != NULL), NULL);
   g_return_val_if_fail ((symbol->source != NULL), NULL);
@@ -1173,10 +1610,15 @@ gchar *s_clib_symbol_get_data (const CLibSymbol *symbol)
   /* First, try the cache. */
   cached = g_hash_table_lookup (clib_symbol_cache, symptr);
   if (cached != NULL) {
-    cached->accessed = time(NULL);
-    return g_strdup(cached->data);
+    /* Move the entry to the front of the LRU list */
+    g_queue_unlink (&clib_symbol_lru, cached->lru_link);
+    g_queue_push_head_link (&clib_symbol_lru, cached->lru_link);
+    clib_symbol_cache_hits++;
+    return cached;
   }
 
+  clib_symbol_cache_misses++;
+
   /* If the symbol wasn't found in the cache, get it directly. */
   switch (symbol->source->type)
     {
@@ -1198,36 +1640,330 @@ gchar *s_clib_symbol_get_data (const CLibSymbol *symbol)
   if (data == NULL) return NULL;
 
   /* Cache the symbol data */
-  cached = g_new (CacheEntry, 1);
+  cached = g_new0 (CacheEntry, 1);
   cached->ptr = (CLibSymbol *) symptr;
-  cached->data = g_strdup (data);
-  cached->accessed = time (NULL);
+  cached->data = data;
+  cached->size = sizeof (CacheEntry) + strlen (data) + 1;
+  cached->serial = clib_symbol_cache_serial++;
+  cached->prototype_state = CACHE_PROTO_NONE;
+  cached->prototype = NULL;
+  g_queue_push_head (&clib_symbol_lru, cached);
+  cached->lru_link = g_queue_peek_head_link (&clib_symbol_lru);
+  clib_symbol_cache_size += cached->size;
   g_hash_table_insert (clib_symbol_cache, symptr, cached);
 
-  /* Clean out the cache if it's too full */
-  n = g_hash_table_size (clib_symbol_cache);
-  if (n > CLIB_MAX_SYMBOL_CACHE) {
-    for ( ; n > CLIB_MIN_SYMBOL_CACHE; n--) {
-      g_hash_table_foreach (clib_symbol_cache,
-                            (GHFunc) cache_find_oldest,
-                            &cached);
-      g_hash_table_remove (clib_symbol_cache, cached->ptr);
-    }
+  /* Clean out the cache if it's too full.  The new entry is at the
+   * front of the LRU list, so it is not evicted. */
+  cache_trim (clib_symbol_cache_budget);
+
+  return cached;
+}
+
+/*! \brief Get symbol data.
+ *  \par Function Description
+ *  Get the unparsed gEDA-format data corresponding to a symbol from
+ *  the symbol's data source.  The return value should be free()'d
+ *  when no longer needed.
+ *
+ *  On failure, returns \b NULL (the error will be logged).
+ *
+ *  \param symbol Symbol to get data for.
+ *  \return Allocated buffer containing symbol data.
+ */
+gchar *s_clib_symbol_get_data (const CLibSymbol *symbol)
+{
+  CacheEntry *cached;
+  gchar *data = NULL;
+
+  CLIB_LOCK ();
+
+  cached = symbol_cache_get (symbol);
+  if (cached != NULL) {
+    data = g_strdup (cached->data);
   }
 
+  CLIB_UNLOCK ();
+
   return data;
 }
 
+/*! \brief Get the parsed objects of a symbol.
+ *  \par Function Description
+ *  Get the objects parsed from the symbol data of \a symbol, at the
+ *  symbol's own origin and orientation.  The symbol data is only
+ *  parsed the first time the objects are requested, and the result is
+ *  kept along with the cached symbol data.  Placing a symbol many
+ *  times therefore only parses it once.
+ *
+ *  The symbol data is parsed without holding the component library
+ *  lock, so other threads can use the library meanwhile.  If two
+ *  threads parse the same symbol at once, the first result is kept.
+ *
+ *  The prototype returned must be released with
+ *  s_clib_prototype_unref(), and stays valid until then, even if the
+ *  cached symbol data is invalidated meanwhile.
+ *
+ *  \param [in]  toplevel  The TOPLEVEL object.
+ *  \param [in]  symbol    Symbol to get the objects of.
+ *  \return A new reference to the prototype of \a symbol, or NULL if
+ *          the symbol data could not be fetched or parsed.
+ */
+CLibPrototype *
+s_clib_symbol_get_prototype (TOPLEVEL *toplevel, const CLibSymbol *symbol)
+{
+  CacheEntry *cached;
+  CLibPrototype *prototype = NULL;
+  GError *err = NULL;
+  GedaArena *arena;
+  GList *objects;
+  gchar *data;
+  guint serial;
+
+  CLIB_LOCK ();
+
+  cached = symbol_cache_get (symbol);
+  if (cached == NULL || cached->prototype_state != CACHE_PROTO_NONE) {
+    if (cached != NULL && cached->prototype_state == CACHE_PROTO_VALID) {
+      prototype = cached->prototype;
+      g_atomic_int_inc (&prototype->refcount);
+    }
+    CLIB_UNLOCK ();
+    return prototype;
+  }
+
+  /* Parsing the symbol may place other symbols, which trims the cache,
+   * so the entry may be gone when the parse is done */
+  data = g_strdup (cached->data);
+  serial = cached->serial;
+
+  CLIB_UNLOCK ();
+
+  /* The prototype stays in the cache after the page being read is
+   * closed, so it must not keep the page's arena alive */
+  arena = geda_arena_set_current (NULL);
+  objects = o_cache_read_buffer (toplevel, NULL, data, -1, symbol->name, &err);
+  geda_arena_set_current (arena);
+  g_free (data);
+
+  if (err == NULL) {
+    prototype = g_new (CLibPrototype, 1);
+    prototype->refcount = 1;
+    prototype->objects = objects;
+  } else {
+    g_error_free (err);
+  }
+
+  CLIB_LOCK ();
+
+  /* Keep the result in the entry it was parsed from, unless it was
+   * evicted or another thread parsed the symbol first */
+  cached = g_hash_table_lookup (clib_symbol_cache, symbol);
+  if (cached != NULL && cached->serial == serial &&
+      cached->prototype_state == CACHE_PROTO_NONE) {
+    if (prototype == NULL) {
+      cached->prototype_state = CACHE_PROTO_FAILED;
+    } else {
+      gsize size = g_list_length (objects) * sizeof (OBJECT);
+
+      g_atomic_int_inc (&prototype->refcount);
+      cached->prototype = prototype;
+      cached->prototype_state = CACHE_PROTO_VALID;
+
+      /* Account for the parsed objects, roughly */
+      cached->size += size;
+      clib_symbol_cache_size += size;
+      cache_trim (clib_symbol_cache_budget);
+    }
+  }
+
+  CLIB_UNLOCK ();
+
+  return prototype;
+}
+
+/*! \brief Get the objects of a symbol prototype.
+ *  \par Function Description
+ *  \warning The objects returned belong to the prototype, and must be
+ *  treated as immutable: they should be copied, never modified,
+ *  attached to a page or free()'d.  They may be copied on several
+ *  threads at once with functions which do not modify the objects
+ *  copied, such as o_object_copy_unmarked().
+ *
+ *  \param [in] prototype  The prototype.
+ *  \return The objects parsed from the symbol data.
+ */
+const GList *
+s_clib_prototype_get_objects (const CLibPrototype *prototype)
+{
+  g_return_val_if_fail ((prototype != NULL), NULL);
+
+  return prototype->objects;
+}
+
+/*! \brief Release a symbol prototype.
+ *  \par Function Description
+ *  Releases a reference returned by s_clib_symbol_get_prototype().
+ *  The objects are freed along with the last reference, which may be
+ *  released on any thread.
+ *
+ *  \param [in] prototype  The prototype.
+ */
+void
+s_clib_prototype_unref (CLibPrototype *prototype)
+{
+  g_return_if_fail (prototype != NULL);
+
+  if (g_atomic_int_dec_and_test (&prototype->refcount)) {
+    /* Prototype objects are never on a page, have no connections and
+     * do not emit change notifications, so no TOPLEVEL is needed. */
+    geda_object_list_delete (NULL, prototype->objects);
+    g_free (prototype);
+  }
+}
+
+/*! \brief Free a list of symbols in the substring search index.
+ *  \par Function Description
+ *  Private function used only in s_clib.c.
+ */
+static void free_trigram_list (gpointer data)
+{
+  g_ptr_array_free ((GPtrArray *) data, TRUE);
+}
+
+/*! Pack the three bytes starting at \a s into a trigram index key */
+#define TRIGRAM_KEY(s) \
+  GUINT_TO_POINTER (((guint) (guchar) (s)[0] << 16) | \
+                    ((guint) (guchar) (s)[1] << 8) | \
+                    (guint) (guchar) (s)[2])
+
+/*! \brief Build the substring search index.
+ *  \par Function Description
+ *  Adds every symbol of every source to #clib_trigram_index under each
+ *  trigram of its lowercased name.  Symbols are visited in the order
+ *  s_clib_search() returns them, so each list is in that order, too.
+ *
+ *  Private function used only in s_clib.c.
+ */
+static void build_trigram_index ()
+{
+  GList *sourcelist;
+  GList *symlist;
+
+  clib_trigram_index = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+                                              NULL, free_trigram_list);
+
+  for (sourcelist = clib_sources;
+       sourcelist != NULL;
+       sourcelist = g_list_next (sourcelist)) {
+    CLibSource *source = (CLibSource *) sourcelist->data;
+
+    for (symlist = source->symbols;
+         symlist != NULL;
+         symlist = g_list_next (symlist)) {
+      CLibSymbol *symbol = (CLibSymbol *) symlist->data;
+      const gchar *s;
+
+      for (s = symbol->search_name; s[0] && s[1] && s[2]; s++) {
+        gpointer key = TRIGRAM_KEY (s);
+        GPtrArray *list = g_hash_table_lookup (clib_trigram_index, key);
+
+        if (list == NULL) {
+          list = g_ptr_array_new ();
+          g_hash_table_insert (clib_trigram_index, key, list);
+        }
+
+        /* A name may contain the same trigram more than once */
+        if (list->len == 0 ||
+            g_ptr_array_index (list, list->len - 1) != symbol) {
+          g_ptr_array_add (list, symbol);
+        }
+      }
+    }
+  }
+}
+
+/*! \brief Find all symbols with names containing a string.
+ *  \par Function Description
+ *  Carries out a #CLIB_SUBSTRING search for s_clib_search().  Only
+ *  the symbols which contain the least common trigram of \a pattern
+ *  are tested, unless \a pattern is too short to have any trigrams.
+ *
+ *  Private function used only in s_clib.c.
+ */
+static GList *search_substring (const gchar *pattern)
+{
+  gchar *lower = g_ascii_strdown (pattern, -1);
+  GList *result = NULL;
+  GList *sourcelist;
+  GList *symlist;
+  GPtrArray *candidates = NULL;
+  const gchar *s;
+  guint i;
+
+  if (strlen (lower) < 3) {
+    for (sourcelist = clib_sources;
+         sourcelist != NULL;
+         sourcelist = g_list_next (sourcelist)) {
+      CLibSource *source = (CLibSource *) sourcelist->data;
+
+      for (symlist = source->symbols;
+           symlist != NULL;
+           symlist = g_list_next (symlist)) {
+        CLibSymbol *symbol = (CLibSymbol *) symlist->data;
+
+        if (strstr (symbol->search_name, lower) != NULL) {
+          result = g_list_prepend (result, symbol);
+        }
+      }
+    }
+
+    g_free (lower);
+    return g_list_reverse (result);
+  }
+
+  if (clib_trigram_index == NULL) {
+    build_trigram_index ();
+  }
+
+  /* Find the shortest list of symbols sharing a trigram with the
+   * pattern.  If some trigram isn't in the index, nothing matches. */
+  for (s = lower; s[2]; s++) {
+    GPtrArray *list = g_hash_table_lookup (clib_trigram_index,
+                                           TRIGRAM_KEY (s));
+    if (list == NULL) {
+      g_free (lower);
+      return NULL;
+    }
+    if (candidates == NULL || list->len < candidates->len) {
+      candidates = list;
+    }
+  }
+
+  for (i = 0; i < candidates->len; i++) {
+    CLibSymbol *symbol = g_ptr_array_index (candidates, i);
+
+    if (strstr (symbol->search_name, lower) != NULL) {
+      result = g_list_prepend (result, symbol);
+    }
+  }
+
+  g_free (lower);
+  return g_list_reverse (result);
+}
+
 /*! \brief Find all symbols matching a pattern.
  *
  *  \par Function Description
  *  Searches the library, returning all symbols whose
  *  names match \a pattern.
  *
- *  Two search modes are available: \b CLIB_EXACT, where \a pattern is
- *  compared to the symbol name using strcmp(), and \b CLIB_GLOB,
+ *  Three search modes are available: \b CLIB_EXACT, where \a pattern
+ *  is compared to the symbol name using strcmp(), \b CLIB_GLOB,
  *  where \a pattern is assumed to be a glob pattern (see the GLib
- *  documentation for details of the glob syntax applicable).
+ *  documentation for details of the glob syntax applicable), and \b
+ *  CLIB_SUBSTRING, which finds the symbols whose names contain \a
+ *  pattern, ignoring ASCII case.  Substring searches use an index of
+ *  the symbol names, so they don't need to test every symbol.
  *
  *  \warning The #CLibSymbol instances in the \b GList returned belong
  *  to the component library, and should be considered constants; they
@@ -1241,6 +1977,23 @@ gchar *s_clib_symbol_get_data (const CLibSymbol *symbol)
  *  \return A \b GList of matching #CLibSymbol structures.
  */
 GList *s_clib_search (const gchar *pattern, const CLibSearchMode mode)
+{
+  GList *result;
+
+  CLIB_LOCK ();
+  result = search (pattern, mode);
+  CLIB_UNLOCK ();
+
+  return result;
+}
+
+/*! \brief Search for symbols matching a pattern.
+ *  \par Function Description
+ *  Carries out s_clib_search() while the component library is locked.
+ *
+ *  Private function used only in s_clib.c.
+ */
+static GList *search (const gchar *pattern, const CLibSearchMode mode)
 {
   GList *sourcelist;
   GList *symlist;
@@ -1253,6 +2006,8 @@ GList *s_clib_search (const gchar *pattern, const CLibSearchMode mode)
 
   if (pattern == NULL) return NULL;
 
+  wait_for_scans ();
+
   /* Use different cache keys depending on what sort of search is being done */
   switch (mode)
     {
@@ -1262,6 +2017,9 @@ GList *s_clib_search (const gchar *pattern, const CLibSearchMode mode)
     case CLIB_EXACT:
       keytype = 's';
       break;
+    case CLIB_SUBSTRING:
+      keytype = 'i';
+      break;
     default:
       g_critical ("s_clib_search: Bad search mode %i\n", mode);
       return NULL;
@@ -1275,6 +2033,12 @@ GList *s_clib_search (const gchar *pattern, const CLibSearchMode mode)
     return g_list_copy (result);
   }
 
+  if (mode == CLIB_SUBSTRING) {
+    result = search_substring (pattern);
+    g_hash_table_insert (clib_search_cache, key, g_list_copy (result));
+    return result;
+  }
+
   if (mode == CLIB_GLOB) {
     globpattern = g_pattern_spec_new(pattern);
   }
@@ -1285,25 +2049,24 @@ GList *s_clib_search (const gchar *pattern, const CLibSearchMode mode)
 
     source = (CLibSource *) sourcelist->data;
 
+    if (mode == CLIB_EXACT) {
+      /* Symbol names are unique within a source */
+      symbol = source_has_symbol (source, pattern);
+      if (symbol != NULL) {
+        result = g_list_prepend (result, symbol);
+      }
+      continue;
+    }
+
     for (symlist = source->symbols;
 	 symlist != NULL;
 	 symlist = g_list_next(symlist)) {
 
       symbol = (CLibSymbol *) symlist->data;
 
-      switch (mode)
-	{
-	case CLIB_EXACT:
-	  if (strcmp (pattern, symbol->name) == 0) {
-	    result = g_list_prepend (result, symbol);
-	  }
-	  break;
-	case CLIB_GLOB:
-	  if (g_pattern_match_string (globpattern, symbol->name)) {
-	    result = g_list_prepend (result, symbol);
-	  }
-	  break;
-	}
+      if (g_pattern_match_string (globpattern, symbol->name)) {
+        result = g_list_prepend (result, symbol);
+      }
     }
   }
 
@@ -1330,7 +2093,16 @@ GList *s_clib_search (const gchar *pattern, const CLibSearchMode mode)
  */
 void s_clib_flush_search_cache ()
 {
+  CLIB_LOCK ();
+
   g_hash_table_remove_all (clib_search_cache);  /* Introduced in glib 2.12 */
+
+  if (clib_trigram_index != NULL) {
+    g_hash_table_destroy (clib_trigram_index);
+    clib_trigram_index = NULL;
+  }
+
+  CLIB_UNLOCK ();
 }
 
 
@@ -1342,7 +2114,9 @@ void s_clib_flush_search_cache ()
  */
 void s_clib_flush_symbol_cache ()
 {
+  CLIB_LOCK ();
   g_hash_table_remove_all (clib_symbol_cache);  /* Introduced in glib 2.12 */
+  CLIB_UNLOCK ();
 }
 
 /*! \brief Invalidate all cached data about a symbol.
@@ -1354,7 +2128,58 @@ void s_clib_flush_symbol_cache ()
 void
 s_clib_symbol_invalidate_data (const CLibSymbol *symbol)
 {
+  CLIB_LOCK ();
   g_hash_table_remove (clib_symbol_cache, (gpointer) symbol);
+  CLIB_UNLOCK ();
+}
+
+/*! \brief Set the size of the symbol data cache.
+ * \par Function Description
+ * Sets the approximate number of bytes the symbol data cache may use
+ * for symbol data and parsed symbols.  If the cache currently uses
+ * more than \a size bytes, the least recently used symbols are
+ * evicted.
+ *
+ * \param size Maximum size of the cache in bytes.
+ */
+void
+s_clib_set_symbol_cache_size (gsize size)
+{
+  CLIB_LOCK ();
+
+  clib_symbol_cache_budget = size;
+
+  if (clib_symbol_cache != NULL) {
+    cache_trim (size);
+  }
+
+  CLIB_UNLOCK ();
+}
+
+/*! \brief Get statistics about the symbol data cache.
+ * \par Function Description
+ * Fills in \a stats with the number of symbol data requests answered
+ * from the cache, the number which had to fetch the data from a
+ * component source, and the number of entries evicted, since the
+ * program started, along with the current size of the cache.
+ *
+ * \param [out] stats The statistics.
+ */
+void
+s_clib_get_symbol_cache_stats (CLibCacheStats *stats)
+{
+  g_return_if_fail (stats != NULL);
+
+  CLIB_LOCK ();
+
+  stats->hits = clib_symbol_cache_hits;
+  stats->misses = clib_symbol_cache_misses;
+  stats->evictions = clib_symbol_cache_evictions;
+  stats->entries = g_queue_get_length (&clib_symbol_lru);
+  stats->size = clib_symbol_cache_size;
+  stats->budget = clib_symbol_cache_budget;
+
+  CLIB_UNLOCK ();
 }
 
 /*! \brief Get symbol structure for a given symbol name.
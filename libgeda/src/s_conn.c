@@ -42,7 +42,409 @@
  *  
  *  \image html s_conn_overview.png
  *  \image latex s_conn_overview.pdf "Connection overview" width=14cm
+ *
+ *  To find connections without comparing against every connectible
+ *  object on the page, each page keeps a #ConnIndex. It maps every
+ *  coordinate to the connectible objects having an endpoint there,
+ *  and files the horizontal and vertical segments and the endpoints
+ *  of the connectible objects by row and column, so that midpoint
+ *  connections can be found with a range query.
+ */
+
+/*! \brief A point in world coordinates, used as a hash key */
+typedef struct {
+  gint x;
+  gint y;
+} ConnPoint;
+
+/*! \brief A span of a row or column of the index
+ *
+ *  Segments are filed as the span between their ends, endpoints as a
+ *  span of zero length.
+ */
+typedef struct {
+  gint start;
+  gint end;
+  gint whichone;
+  OBJECT *object;
+} ConnSpan;
+
+/*! \brief The spans on a single row or column, sorted by start */
+typedef struct {
+  GSequence *spans;
+  gint max_length;
+} ConnLine;
+
+/*! \brief Where a connectible object is filed in the index */
+typedef struct {
+  /*! \brief The object's link in the page's connectible_list */
+  GList *link;
+  ConnPoint points[2];
+  gint count;
+  /*! \brief The spans of the points in #h_points and #v_points */
+  GSequenceIter *point_spans[2][2];
+  /*! \brief The span of the segment, or NULL if not filed */
+  GSequenceIter *segment_span;
+  gboolean horizontal;
+  gint segment_coord;
+} ConnIndexEntry;
+
+struct _ConnIndex
+{
+  /*! \brief ConnPoint -> GPtrArray of OBJECTs with an endpoint there */
+  GHashTable *endpoints;
+  /*! \brief y -> ConnLine of horizontal segments */
+  GHashTable *h_segments;
+  /*! \brief x -> ConnLine of vertical segments */
+  GHashTable *v_segments;
+  /*! \brief y -> ConnLine of endpoints, spanning x */
+  GHashTable *h_points;
+  /*! \brief x -> ConnLine of endpoints, spanning y */
+  GHashTable *v_points;
+  /*! \brief OBJECT -> ConnIndexEntry */
+  GHashTable *objects;
+  /*! \brief The last link of the page's connectible_list */
+  GList *connectible_tail;
+};
+
+static guint
+conn_point_hash (gconstpointer key)
+{
+  const ConnPoint *point = key;
+
+  return ((guint) point->x * 73856093U) ^ ((guint) point->y * 19349663U);
+}
+
+static gboolean
+conn_point_equal (gconstpointer a, gconstpointer b)
+{
+  const ConnPoint *point_a = a;
+  const ConnPoint *point_b = b;
+
+  return (point_a->x == point_b->x) && (point_a->y == point_b->y);
+}
+
+static void
+conn_point_free (gpointer point)
+{
+  g_slice_free (ConnPoint, point);
+}
+
+static void
+conn_span_free (gpointer span)
+{
+  g_slice_free (ConnSpan, span);
+}
+
+static gint
+conn_span_compare (gconstpointer a, gconstpointer b, gpointer user_data)
+{
+  const ConnSpan *span_a = a;
+  const ConnSpan *span_b = b;
+
+  return (span_a->start > span_b->start) - (span_a->start < span_b->start);
+}
+
+static void
+conn_line_free (gpointer line)
+{
+  g_sequence_free (((ConnLine*) line)->spans);
+  g_slice_free (ConnLine, line);
+}
+
+static void
+conn_index_entry_free (gpointer entry)
+{
+  g_slice_free (ConnIndexEntry, entry);
+}
+
+static void
+conn_ptr_array_free (gpointer array)
+{
+  g_ptr_array_free ((GPtrArray*) array, TRUE);
+}
+
+static GHashTable *
+conn_lines_new (void)
+{
+  return g_hash_table_new_full (g_direct_hash, g_direct_equal,
+                                NULL, conn_line_free);
+}
+
+/*! \brief Create a new connection index
+ *  \par Function Description
+ *  Creates an empty index of the endpoints and segments of connectible
+ *  objects.
+ *
+ *  \return The new index. Free it with s_conn_index_free().
+ */
+ConnIndex *s_conn_index_new (void)
+{
+  ConnIndex *index = g_new0 (ConnIndex, 1);
+
+  index->endpoints = g_hash_table_new_full (conn_point_hash,
+                                            conn_point_equal,
+                                            conn_point_free,
+                                            conn_ptr_array_free);
+  index->h_segments = conn_lines_new ();
+  index->v_segments = conn_lines_new ();
+  index->h_points = conn_lines_new ();
+  index->v_points = conn_lines_new ();
+  index->objects = g_hash_table_new_full (g_direct_hash,
+                                          g_direct_equal,
+                                          NULL,
+                                          conn_index_entry_free);
+  return index;
+}
+
+/*! \brief Free a connection index
+ *  \param index The index to free
+ */
+void s_conn_index_free (ConnIndex *index)
+{
+  if (index == NULL) {
+    return;
+  }
+
+  g_hash_table_destroy (index->endpoints);
+  g_hash_table_destroy (index->h_segments);
+  g_hash_table_destroy (index->v_segments);
+  g_hash_table_destroy (index->h_points);
+  g_hash_table_destroy (index->v_points);
+  g_hash_table_destroy (index->objects);
+  g_free (index);
+}
+
+/*! \brief Get the connectible objects with an endpoint at a point
+ *  \par Function Description
+ *  The returned array is owned by the index and is only valid until
+ *  the index is next modified.
+ *
+ *  \return A GPtrArray of OBJECTs, or NULL if there are none.
+ */
+static GPtrArray *
+conn_index_lookup (ConnIndex *index, int x, int y)
+{
+  ConnPoint point;
+
+  point.x = x;
+  point.y = y;
+
+  return g_hash_table_lookup (index->endpoints, &point);
+}
+
+/*! \brief File a span on a row or column
+ *  \return The position of the span, for removing it again.
+ */
+static GSequenceIter *
+conn_line_insert (GHashTable *lines, gint coord, gint start, gint end,
+                  gint whichone, OBJECT *object)
+{
+  ConnLine *line = g_hash_table_lookup (lines, GINT_TO_POINTER (coord));
+  ConnSpan *span;
+
+  if (line == NULL) {
+    line = g_slice_new (ConnLine);
+    line->spans = g_sequence_new (conn_span_free);
+    line->max_length = 0;
+    g_hash_table_insert (lines, GINT_TO_POINTER (coord), line);
+  }
+
+  span = g_slice_new (ConnSpan);
+  span->start = start;
+  span->end = end;
+  span->whichone = whichone;
+  span->object = object;
+
+  line->max_length = max (line->max_length, end - start);
+
+  return g_sequence_insert_sorted (line->spans, span, conn_span_compare, NULL);
+}
+
+/*! \brief Remove a span from a row or column
+ */
+static void
+conn_line_remove (GHashTable *lines, gint coord, GSequenceIter *iter)
+{
+  GSequence *spans = g_sequence_iter_get_sequence (iter);
+
+  g_sequence_remove (iter);
+
+  if (g_sequence_get_length (spans) == 0) {
+    g_hash_table_remove (lines, GINT_TO_POINTER (coord));
+  }
+}
+
+/*! \brief Find the spans on a row or column starting in a range
+ *  \par Function Description
+ *  Appends the spans on the row or column \a coord of \a lines which
+ *  start between \a low and \a high inclusive, and end at or after
+ *  \a min_end, to \a result.
+ */
+static void
+conn_line_query (GHashTable *lines, gint coord, gint low, gint high,
+                 gint min_end, GPtrArray *result)
+{
+  ConnLine *line = g_hash_table_lookup (lines, GINT_TO_POINTER (coord));
+  GSequenceIter *iter;
+  ConnSpan probe;
+
+  if (line == NULL) {
+    return;
+  }
+
+  /* No span on the line is longer than max_length */
+  low = max (low, min_end - line->max_length);
+  if (low > high) {
+    return;
+  }
+
+  /* The search returns the position after all spans starting before
+   * low */
+  probe.start = low - 1;
+  for (iter = g_sequence_search (line->spans, &probe, conn_span_compare, NULL);
+       !g_sequence_iter_is_end (iter);
+       iter = g_sequence_iter_next (iter)) {
+    ConnSpan *span = g_sequence_get (iter);
+
+    if (span->start > high)
+      break;
+
+    if (span->end >= min_end) {
+      g_ptr_array_add (result, span);
+    }
+  }
+}
+
+/*! \brief Find the segments passing strictly through a point
+ *  \par Function Description
+ *  Appends the ConnSpans of the horizontal and vertical segments which
+ *  have the point (\a x, \a y) between their ends to \a result.
  */
+static void
+conn_index_find_segments (ConnIndex *index, gint x, gint y,
+                          GPtrArray *result)
+{
+  conn_line_query (index->h_segments, y, G_MININT, x - 1, x + 1, result);
+  conn_line_query (index->v_segments, x, G_MININT, y - 1, y + 1, result);
+}
+
+/*! \brief Find the endpoints lying strictly inside a segment
+ *  \par Function Description
+ *  Appends the ConnSpans of the endpoints lying between the ends of
+ *  \a object to \a result. Nothing is found unless \a object is a
+ *  horizontal or vertical segment.
+ */
+static void
+conn_index_find_points (ConnIndex *index, OBJECT *object, GPtrArray *result)
+{
+  gint *x = object->line->x;
+  gint *y = object->line->y;
+
+  if (y[0] == y[1] && x[0] != x[1]) {
+    conn_line_query (index->h_points, y[0],
+                     min (x[0], x[1]) + 1, max (x[0], x[1]) - 1,
+                     G_MININT, result);
+  } else if (x[0] == x[1] && y[0] != y[1]) {
+    conn_line_query (index->v_points, x[0],
+                     min (y[0], y[1]) + 1, max (y[0], y[1]) - 1,
+                     G_MININT, result);
+  }
+}
+
+/*! \brief Remove an object from the rows, columns and points it is
+ *  filed under
+ */
+static void
+conn_index_unfile (ConnIndex *index, ConnIndexEntry *entry, OBJECT *object)
+{
+  gint i;
+
+  for (i = 0; i < entry->count; i++) {
+    GPtrArray *objects = g_hash_table_lookup (index->endpoints,
+                                              &entry->points[i]);
+    if (objects != NULL) {
+      g_ptr_array_remove (objects, object);
+      if (objects->len == 0) {
+        g_hash_table_remove (index->endpoints, &entry->points[i]);
+      }
+    }
+
+    conn_line_remove (index->h_points, entry->points[i].y,
+                      entry->point_spans[i][0]);
+    conn_line_remove (index->v_points, entry->points[i].x,
+                      entry->point_spans[i][1]);
+  }
+
+  if (entry->segment_span != NULL) {
+    conn_line_remove (entry->horizontal ? index->h_segments
+                                        : index->v_segments,
+                      entry->segment_coord, entry->segment_span);
+  }
+
+  entry->count = 0;
+  entry->segment_span = NULL;
+}
+
+/*! \brief File a line object under its current endpoints
+ *  \par Function Description
+ *  Pins are only filed under their active end, and are never filed as
+ *  segments, as nothing may connect to the middle of a pin.
+ */
+static void
+conn_index_file (ConnIndex *index, ConnIndexEntry *entry, OBJECT *object)
+{
+  gint *x = object->line->x;
+  gint *y = object->line->y;
+  gint i, j;
+
+  for (j = 0; j < 2; j++) {
+    if (object->type == OBJ_PIN && object->whichend != j)
+      continue;
+
+    /* Don't file zero length objects twice under the same point */
+    if (entry->count == 1 &&
+        entry->points[0].x == x[j] &&
+        entry->points[0].y == y[j])
+      continue;
+
+    entry->points[entry->count].x = x[j];
+    entry->points[entry->count].y = y[j];
+    entry->point_spans[entry->count][0] =
+      conn_line_insert (index->h_points, y[j], x[j], x[j], j, object);
+    entry->point_spans[entry->count][1] =
+      conn_line_insert (index->v_points, x[j], y[j], y[j], j, object);
+    entry->count++;
+  }
+
+  for (i = 0; i < entry->count; i++) {
+    GPtrArray *objects = g_hash_table_lookup (index->endpoints,
+                                              &entry->points[i]);
+    if (objects == NULL) {
+      ConnPoint *key = g_slice_new (ConnPoint);
+      *key = entry->points[i];
+      objects = g_ptr_array_new ();
+      g_hash_table_insert (index->endpoints, key, objects);
+    }
+    g_ptr_array_add (objects, object);
+  }
+
+  if (object->type != OBJ_PIN) {
+    if (y[0] == y[1] && x[0] != x[1]) {
+      entry->horizontal = TRUE;
+      entry->segment_coord = y[0];
+      entry->segment_span = conn_line_insert (index->h_segments, y[0],
+                                              min (x[0], x[1]),
+                                              max (x[0], x[1]), -1, object);
+    } else if (x[0] == x[1] && y[0] != y[1]) {
+      entry->horizontal = FALSE;
+      entry->segment_coord = x[0];
+      entry->segment_span = conn_line_insert (index->v_segments, x[0],
+                                              min (y[0], y[1]),
+                                              max (y[0], y[1]), -1, object);
+    }
+  }
+}
 
 
 /*! \brief create a new connection object
@@ -60,7 +462,7 @@ CONN *s_conn_return_new(OBJECT * other_object, int type, int x, int y,
   new_conn = (CONN *) g_malloc(sizeof(CONN));
 
 #if DEBUG
-  printf("** creating: %s %d %d\n", other_object->name, x, y);
+  printf("** creating: %c.%d %d %d\n", other_object->type, other_object->sid, x, y);
 #endif
 
   new_conn->other_object = other_object;
@@ -129,8 +531,8 @@ int s_conn_remove_other (TOPLEVEL *toplevel, OBJECT *other_object,
 
 #if DEBUG
 	    printf("Found other_object in remove_other\n");
-	    printf("Freeing other: %s %d %d\n", conn->other_object->name,
-		   conn->x, conn->y);
+	    printf("Freeing other: %c.%d %d %d\n", conn->other_object->type,
+		   conn->other_object->sid, conn->x, conn->y);
 #endif
 
 	    /* Do not write modify c_current like this, since this will cause */
@@ -264,6 +666,10 @@ OBJECT *s_conn_check_midpoint(OBJECT *o_current, int x, int y)
  *  This function adds all connections from and to the OBJECTS
  *  of the given GList.
  *
+ *  Each object is filed in the page's connection index just before its
+ *  connections are looked up, so every connection between two objects
+ *  of the list is only found once, when the second of them is added.
+ *
  *  \param page      The PAGE structure
  *  \param obj_list  GList of OBJECTs to add into the connection system
  */
@@ -324,6 +730,43 @@ static void add_connection (OBJECT *object, OBJECT *other_object,
   }
 }
 
+/*! \brief Checks if the symbols two objects belong to allow a connection
+ *
+ *  \par Function Description
+ *  An object inside a symbol can only be connected up to another
+ *  object if they are (a) both inside the same object, or (b)
+ *  the object inside a symbol is a pin.
+ *
+ *  \param toplevel      The TOPLEVEL structure
+ *  \param object        The OBJECT being updated
+ *  \param complex       The parent of \a object, or NULL
+ *  \param other_object  The OBJECT to test against
+ *  \return TRUE if the objects may be connected, FALSE if not
+ */
+static int check_parent_compat (TOPLEVEL *toplevel, OBJECT *object,
+                                OBJECT *complex, OBJECT *other_object)
+{
+  OBJECT *other_complex = o_get_parent (toplevel, other_object);
+
+  /* 1. Both objects are inside a symbol */
+  if (complex && other_complex) {
+    /* If inside different symbols, both must be pins to connect. */
+    if (complex != other_complex
+        && (object->type != OBJ_PIN || other_object->type != OBJ_PIN)) {
+      return FALSE;
+    }
+
+  /* 2. Updating object is inside a symbol, but other object is not. */
+  } else if (complex && !other_complex) {
+    if (object->type != OBJ_PIN) return FALSE;
+  /* 3. Updating object not inside symbol, but other object is. */
+  } else if (!complex && other_complex) {
+    if (other_object->type != OBJ_PIN) return FALSE;
+  }
+
+  return TRUE;
+}
+
 /*! \brief add a line OBJECT to the connection system
  *  \par Function Description
  *  This function searches for all geometrical connections of the OBJECT
@@ -335,11 +778,12 @@ static void add_connection (OBJECT *object, OBJECT *other_object,
  */
 static void s_conn_update_line_object (PAGE* page, OBJECT *object)
 {
-  GList *object_list;
+  GPtrArray *candidates;
+  GPtrArray *spans;
   OBJECT *other_object;
-  OBJECT *found;
+  guint i;
   int j, k;
-  OBJECT *complex, *other_complex;
+  OBJECT *complex;
   TOPLEVEL *toplevel;
 
   toplevel = page->toplevel;
@@ -347,50 +791,33 @@ static void s_conn_update_line_object (PAGE* page, OBJECT *object)
 
   complex = o_get_parent (toplevel, object);
 
-  /* loop over all connectible objects */
-  for (object_list = page->connectible_list;
-       object_list != NULL;
-       object_list = g_list_next (object_list)) {
-    other_object = object_list->data;
+  /* Check the end points of the object against the end points of the
+   * objects filed under the same coordinates */
+  for (j = 0; j < 2; j++) {
 
-    if (object == other_object)
+    /* If the object is a pin, only check the correct end */
+    if (object->type == OBJ_PIN && object->whichend != j)
       continue;
 
-    other_complex = o_get_parent (toplevel, other_object);
+    candidates = conn_index_lookup (page->conn_index,
+                                    object->line->x[j], object->line->y[j]);
+    if (candidates == NULL)
+      continue;
 
-    /* An object inside a symbol can only be connected up to another
-     * object if they are (a) both inside the same object, or (b)
-     * the object inside a symbol is a pin. */
+    for (i = 0; i < candidates->len; i++) {
+      other_object = g_ptr_array_index (candidates, i);
 
-    /* 1. Both objects are inside a symbol */
-    if (complex && other_complex) {
-      /* If inside different symbols, both must be pins to connect. */
-      if (complex != other_complex
-          && (object->type != OBJ_PIN || other_object->type != OBJ_PIN)) {
+      if (object == other_object)
         continue;
-      }
-
-    /* 2. Updating object is inside a symbol, but other object is not. */
-    } else if (complex && !other_complex) {
-      if (object->type != OBJ_PIN) continue;
-    /* 3. Updating object not inside symbol, but other object is. */
-    } else if (!complex && other_complex) {
-      if (other_object->type != OBJ_PIN) continue;
-    }
 
-    /* Here is where you check the end points */
-    /* Check both end points of the other object */
-    for (k = 0; k < 2; k++) {
-
-      /* If the other object is a pin, only check the correct end */
-      if (other_object->type == OBJ_PIN && other_object->whichend != k)
+      if (!check_parent_compat (toplevel, object, complex, other_object))
         continue;
 
-      /* Check both end points of the object */
-      for (j = 0; j < 2; j++) {
+      /* Check both end points of the other object */
+      for (k = 0; k < 2; k++) {
 
-        /* If the object is a pin, only check the correct end */
-        if (object->type == OBJ_PIN && object->whichend != j)
+        /* If the other object is a pin, only check the correct end */
+        if (other_object->type == OBJ_PIN && other_object->whichend != k)
           continue;
 
         /* Check for coincidence and compatibility between
@@ -413,22 +840,41 @@ static void s_conn_update_line_object (PAGE* page, OBJECT *object)
         }
       }
     }
+  }
+
+  spans = g_ptr_array_new ();
+
+  /* Check both end points of the object against midpoints of the
+   * segments passing through them */
+  for (k = 0; k < 2; k++) {
+
+    /* If the object is a pin, only check the correct end */
+    if (object->type == OBJ_PIN && object->whichend != k)
+      continue;
 
-    /* Check both end points of the object against midpoints of the other */
-    for (k = 0; k < 2; k++) {
+    g_ptr_array_set_size (spans, 0);
+    conn_index_find_segments (page->conn_index,
+                              object->line->x[k], object->line->y[k], spans);
 
-      /* If the object is a pin, only check the correct end */
-      if (object->type == OBJ_PIN && object->whichend != k)
+    for (i = 0; i < spans->len; i++) {
+      other_object = ((ConnSpan*) g_ptr_array_index (spans, i))->object;
+
+      if (object == other_object)
+        continue;
+
+      if (!check_parent_compat (toplevel, object, complex, other_object))
         continue;
 
-      /* check for midpoint of other object, k endpoint of current obj*/
-      found = s_conn_check_midpoint (other_object, object->line->x[k],
-                                                   object->line->y[k]);
+      /* The index only narrows down the candidates, so check the
+       * segment really passes through the end point */
+      if (s_conn_check_midpoint (other_object, object->line->x[k],
+                                 object->line->y[k]) == NULL)
+        continue;
 
       /* Pins are not allowed midpoint connections onto them. */
       /* Allow nets to connect to the middle of buses. */
       /* Allow compatible objects to connect. */
-      if (found && other_object->type != OBJ_PIN &&
+      if (other_object->type != OBJ_PIN &&
           ((object->type == OBJ_NET && other_object->type == OBJ_BUS) ||
             check_direct_compat (object, other_object))) {
 
@@ -441,37 +887,51 @@ static void s_conn_update_line_object (PAGE* page, OBJECT *object)
                         object->line->y[k], -1, k);
       }
     }
+  }
 
-    /* Check both end points of the other object against midpoints of the first */
-    for (k = 0; k < 2; k++) {
+  /* Check the end points lying in the middle of the object */
+  g_ptr_array_set_size (spans, 0);
+  if (object->type != OBJ_PIN) {
+    conn_index_find_points (page->conn_index, object, spans);
+  }
 
-      /* If the other object is a pin, only check the correct end */
-      if (other_object->type == OBJ_PIN && other_object->whichend != k)
-        continue;
+  for (i = 0; i < spans->len; i++) {
+    ConnSpan *span = g_ptr_array_index (spans, i);
+    other_object = span->object;
+    k = span->whichone;
 
-      /* do object's endpoints cross the middle of other_object? */
-      /* check for midpoint of other object, k endpoint of current obj*/
-      found = s_conn_check_midpoint (object, other_object->line->x[k],
-                                             other_object->line->y[k]);
+    if (object == other_object)
+      continue;
 
-      /* Pins are not allowed midpoint connections onto them. */
-      /* Allow nets to connect to the middle of buses. */
-      /* Allow compatible objects to connect. */
-      if (found && object->type != OBJ_PIN &&
-           ((object->type == OBJ_BUS && other_object->type == OBJ_NET) ||
-             check_direct_compat (object, other_object))) {
+    if (!check_parent_compat (toplevel, object, complex, other_object))
+      continue;
 
-        add_connection (object, other_object, CONN_MIDPOINT,
-                        other_object->line->x[k],
-                        other_object->line->y[k], -1, k);
+    /* The index only narrows down the candidates, so check the end
+     * point is still where it was filed and lies inside the object */
+    if (other_object->type == OBJ_PIN && other_object->whichend != k)
+      continue;
 
-        add_connection (other_object, object, CONN_MIDPOINT,
-                        other_object->line->x[k],
-                        other_object->line->y[k], k, -1);
-      }
+    if (s_conn_check_midpoint (object, other_object->line->x[k],
+                               other_object->line->y[k]) == NULL)
+      continue;
+
+    /* Allow nets to connect to the middle of buses. */
+    /* Allow compatible objects to connect. */
+    if ((object->type == OBJ_BUS && other_object->type == OBJ_NET) ||
+        check_direct_compat (object, other_object)) {
+
+      add_connection (object, other_object, CONN_MIDPOINT,
+                      other_object->line->x[k],
+                      other_object->line->y[k], -1, k);
+
+      add_connection (other_object, object, CONN_MIDPOINT,
+                      other_object->line->x[k],
+                      other_object->line->y[k], k, -1);
     }
   }
 
+  g_ptr_array_free (spans, TRUE);
+
 #if DEBUG
   s_conn_print(object->conn_list);
 #endif
@@ -516,6 +976,7 @@ void s_conn_print(GList * conn_list)
 {
   CONN *conn;
   GList *cl_current;
+  gchar *name;
 
   printf("\nStarting s_conn_print\n");
   cl_current = conn_list;
@@ -523,7 +984,9 @@ void s_conn_print(GList * conn_list)
 
     conn = (CONN *) cl_current->data;
     printf("-----------------------------------\n");
-    printf("other object: %s\n", conn->other_object->name);
+    name = geda_object_get_name (conn->other_object);
+    printf("other object: %s\n", name);
+    g_free (name);
     printf("type: %d\n", conn->type);
     printf("x: %d y: %d\n", conn->x, conn->y);
     printf("whichone: %d\n", conn->whichone);
@@ -651,19 +1114,75 @@ GList *s_conn_return_others(GList *input_list, OBJECT *object)
  */
 static void s_conn_add_line_object (PAGE *page, OBJECT *object)
 {
+  ConnIndexEntry *entry;
+
   g_return_if_fail (object != NULL);
   g_return_if_fail (object->line != NULL);
 
 #if DEBUG
-  printf ("name: %s\n", object->name);
+  printf ("sid: %d\n", object->sid);
 #endif
 
   if (page == NULL) {
     return;
   }
 
-  if (!g_list_find (page->connectible_list, object)) {
-    page->connectible_list = g_list_append (page->connectible_list, object);
+  entry = g_hash_table_lookup (page->conn_index->objects, object);
+
+  if (entry == NULL) {
+    entry = g_slice_new0 (ConnIndexEntry);
+
+    /* Keep the list in the order objects were added */
+    entry->link = g_list_alloc ();
+    entry->link->data = object;
+    entry->link->prev = page->conn_index->connectible_tail;
+    if (page->conn_index->connectible_tail == NULL) {
+      page->connectible_list = entry->link;
+    } else {
+      page->conn_index->connectible_tail->next = entry->link;
+    }
+    page->conn_index->connectible_tail = entry->link;
+
+    g_hash_table_insert (page->conn_index->objects, object, entry);
+  } else {
+    /* The object may have moved since it was last added, so always
+     * refile it under its current endpoints */
+    conn_index_unfile (page->conn_index, entry, object);
+  }
+
+  conn_index_file (page->conn_index, entry, object);
+}
+
+/*! \brief Refile a connectible object after its geometry changed
+ *  \par Function Description
+ *  Files \a object in the connection index of \a page under its
+ *  current endpoints, if it is filed there at all.  This keeps the
+ *  index in step with objects that are moved without being removed
+ *  from and added to the connection system again, so that objects
+ *  added later still find them.  Connections already made are not
+ *  changed.
+ *
+ *  \param page   The PAGE the object is on
+ *  \param object The OBJECT whose geometry changed
+ */
+void s_conn_refile_object (PAGE *page, OBJECT *object)
+{
+  ConnIndexEntry *entry;
+
+  if (page == NULL || page->conn_index == NULL) {
+    return;
+  }
+
+  switch (object->type) {
+    case OBJ_NET:
+    case OBJ_PIN:
+    case OBJ_BUS:
+      entry = g_hash_table_lookup (page->conn_index->objects, object);
+      if (entry != NULL) {
+        conn_index_unfile (page->conn_index, entry, object);
+        conn_index_file (page->conn_index, entry, object);
+      }
+      break;
   }
 }
 
@@ -702,6 +1221,7 @@ void s_conn_add_object (PAGE *page, OBJECT *object)
  */
 void s_conn_remove_object(PAGE* page, OBJECT *object)
 {
+  ConnIndexEntry *entry;
   GList *iter;
 
   if (page == NULL) {
@@ -717,5 +1237,15 @@ void s_conn_remove_object(PAGE* page, OBJECT *object)
     }
   }
 
-  page->connectible_list = g_list_remove (page->connectible_list, object);
+  entry = g_hash_table_lookup (page->conn_index->objects, object);
+
+  if (entry != NULL) {
+    conn_index_unfile (page->conn_index, entry, object);
+    if (entry->link == page->conn_index->connectible_tail) {
+      page->conn_index->connectible_tail = entry->link->prev;
+    }
+    page->connectible_list = g_list_delete_link (page->connectible_list,
+                                                 entry->link);
+    g_hash_table_remove (page->conn_index->objects, object);
+  }
 }
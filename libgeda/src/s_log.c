@@ -61,6 +61,26 @@ static void s_log_handler (const gchar *log_domain,
 
 static int logfile_fd = -1;
 
+/*! Messages may be logged on several threads at once, e.g. while
+ *  files are read on worker threads */
+G_LOCK_DEFINE_STATIC (logfile);
+
+/*! A message logged on another thread than the main one, waiting to
+ *  be passed to #x_log_update_func */
+typedef struct {
+  gchar *log_domain;
+  GLogLevelFlags log_level;
+  gchar *message;
+} PendingMessage;
+
+/*! The thread which initialized logging, on which #x_log_update_func
+ *  is called */
+static GThread *log_main_thread = NULL;
+
+/*! Messages waiting to be passed to #x_log_update_func, oldest first */
+static GQueue log_pending_messages = G_QUEUE_INIT;
+G_LOCK_DEFINE_STATIC (log_pending);
+
 static guint log_handler_id;
 
 /*! \brief Initialize libgeda logging feature.
@@ -145,6 +165,8 @@ void s_log_init (const gchar *prefix)
 
   if (logfile_fd != -1) {
 
+    log_main_thread = g_thread_self ();
+
     /* install the log handler */
     log_handler_id = g_log_set_handler (NULL,
                                         CATCH_LOG_LEVELS,
@@ -212,6 +234,8 @@ gchar *s_log_read (void)
     return NULL;
   }
 
+  G_LOCK (logfile);
+
   tmp = do_logging;
   do_logging = FALSE;
 
@@ -226,16 +250,84 @@ gchar *s_log_read (void)
 
   do_logging = tmp;
 
+  G_UNLOCK (logfile);
+
   return g_string_free (contents, FALSE);
 }
 
+/*! \brief Pass the messages logged on other threads on.
+ *  \par Function Description
+ *  Passes the messages queued by log_defer_update() to
+ *  #x_log_update_func, in the order they were logged.  This must be
+ *  called on the main thread; it is also an idle callback.
+ *
+ *  Private function used only in s_log.c.
+ *
+ *  \param [in] user_data  (unused).
+ *  \return FALSE, to remove the idle callback.
+ */
+static gboolean log_flush_updates (gpointer user_data)
+{
+  PendingMessage *pending;
+
+  while (TRUE) {
+    G_LOCK (log_pending);
+    pending = g_queue_pop_head (&log_pending_messages);
+    G_UNLOCK (log_pending);
+
+    if (pending == NULL) break;
+
+    if (x_log_update_func) {
+      (*x_log_update_func) (pending->log_domain, pending->log_level,
+                            pending->message);
+    }
+
+    g_free (pending->log_domain);
+    g_free (pending->message);
+    g_free (pending);
+  }
+
+  return FALSE;
+}
+
+/*! \brief Queue a message for the main thread.
+ *  \par Function Description
+ *  #x_log_update_func usually updates the user interface, which may
+ *  only be done on the main thread.  Messages logged on other threads,
+ *  e.g. while files are read on worker threads, are therefore queued,
+ *  and passed on from the main loop by log_flush_updates().
+ *
+ *  Private function used only in s_log.c.
+ */
+static void log_defer_update (const gchar *log_domain,
+                              GLogLevelFlags log_level,
+                              const gchar *message)
+{
+  PendingMessage *pending = g_new (PendingMessage, 1);
+  gboolean schedule;
+
+  pending->log_domain = g_strdup (log_domain);
+  pending->log_level = log_level;
+  pending->message = g_strdup (message);
+
+  G_LOCK (log_pending);
+  schedule = g_queue_is_empty (&log_pending_messages);
+  g_queue_push_tail (&log_pending_messages, pending);
+  G_UNLOCK (log_pending);
+
+  if (schedule) {
+    g_idle_add (log_flush_updates, NULL);
+  }
+}
+
 /*! \brief Write a message to the current log file.
  *  \par Function Description
  *  Writes <B>message</B> to the current log file whose file descriptor
  *  is <B>logfile_fd</B>.
  *
  *  It also sends <B>message</B> to the optional function <B>x_log_update</B>
- *  for further use.
+ *  for further use.  This is always done on the main thread, and
+ *  without holding the lock on the log file.
  *
  *  \param [in] log_domain  (unused).
  *  \param [in] log_level   (unused).
@@ -255,7 +347,9 @@ static void s_log_handler (const gchar *log_domain,
     return;
   }
   g_return_if_fail (logfile_fd != -1);
-  
+
+  G_LOCK (logfile);
+
   status = write (logfile_fd, message, strlen (message));
   if (status == -1) {
     fprintf(stderr, "Could not write message to log file\n");
@@ -266,8 +360,15 @@ static void s_log_handler (const gchar *log_domain,
     g_log_default_handler (log_domain, log_level, message, NULL);
   }
 
+  G_UNLOCK (logfile);
+
   if (x_log_update_func) {
-    (*x_log_update_func) (log_domain, log_level, message);
+    if (g_thread_self () == log_main_thread) {
+      /* Keep the messages in order */
+      log_flush_updates (NULL);
+      (*x_log_update_func) (log_domain, log_level, message);
+    } else {
+      log_defer_update (log_domain, log_level, message);
+    }
   }
-
 }
@@ -135,6 +135,41 @@ s_textbuffer_next (TextBuffer *tb, const gssize count)
   gchar *dest = tb->line;
   const gchar *buf_end = tb->buffer + tb->size;
 
+  if (count < 0) {
+    /* Find the end of the line and copy it in one go */
+    const gchar *line_end = src;
+
+    while (line_end < buf_end && *line_end != '\n' && *line_end != '\r') {
+      line_end++;
+    }
+
+    /* Expand line buffer, if necessary, leaving space for a newline
+     * and a null */
+    len = line_end - src + 2;
+    if (len > tb->linesize) {
+      tb->linesize = (len / TEXT_BUFFER_LINE_SIZE + 1) * TEXT_BUFFER_LINE_SIZE;
+      g_free (tb->line);
+      tb->line = g_malloc (tb->linesize);
+    }
+
+    dest = tb->line;
+    memcpy (dest, src, line_end - src);
+    dest += line_end - src;
+    src = line_end;
+
+    if (src < buf_end) {
+      *dest++ = '\n';
+      /* Absorb the '\n' of a "\r\n" pair */
+      if (*src == '\r' && src + 1 < buf_end && src[1] == '\n') src++;
+      src++;
+    }
+
+    *dest = 0;
+    tb->offset = src - tb->buffer;
+
+    return tb->line;
+  }
+
   while (1) {
     if (src >= buf_end) break;
     if (count >= 0 && dest - tb->line >= count) break;
@@ -158,7 +158,7 @@ SCM_DEFINE (set_complex_x, "%set-complex!", 6, 0, 0,
   obj->complex->mirror = scm_is_true (mirror_s);
   obj->selectable = scm_is_false (locked_s);
 
-  obj->w_bounds_valid_for = NULL; /* We need to do this explicitly... */
+  geda_object_invalidate_bounds (obj); /* We need to do this explicitly... */
 
   o_emit_change_notify (toplevel, obj);
 
@@ -276,8 +276,9 @@ SCM_DEFINE (complex_append_x, "%complex-append!", 2, 0, 0,
   parent->complex->prim_objs =
     g_list_append (parent->complex->prim_objs, child);
   child->parent = parent;
+  o_attrib_invalidate_index (parent);
 
-  parent->w_bounds_valid_for = NULL;
+  geda_object_invalidate_bounds (parent);
 
   PAGE* parent_page = o_get_page (toplevel, parent);
   /* We may need to update connections */
@@ -356,6 +357,7 @@ SCM_DEFINE (complex_remove_x, "%complex-remove!", 2, 0, 0,
   parent->complex->prim_objs =
     g_list_remove_all (parent->complex->prim_objs, child);
   child->parent = NULL;
+  o_attrib_invalidate_index (parent);
 
   /* We may need to update connections */
   s_conn_remove_object (child_page, child);
@@ -0,0 +1,174 @@
+#include <glib.h>
+#include <string.h>
+#include <libgeda.h>
+
+static const gchar *schematic_data =
+  "v 20130925 2\n"
+  "C 1000 1000 1 0 0 EMBEDDEDattrib_test.sym\n"
+  "[\n"
+  "P 0 0 0 100 1 0 1\n"
+  "{\n"
+  "T 0 50 5 8 0 1 0 0 1\n"
+  "pinnumber=1\n"
+  "}\n"
+  "B 0 0 100 300 3 0 0 0 -1 -1 0 -1 -1 -1 -1 -1\n"
+  "T 0 300 8 10 0 0 0 0 1\n"
+  "device=RESISTOR\n"
+  "T 0 400 8 10 0 0 0 0 1\n"
+  "footprint=A\n"
+  "T 0 500 8 10 0 0 0 0 1\n"
+  "footprint=B\n"
+  "T 0 600 8 10 0 0 0 0 1\n"
+  "not an attribute\n"
+  "]\n"
+  "{\n"
+  "T 1000 1100 5 10 1 1 0 0 1\n"
+  "refdes=R1\n"
+  "T 1000 1200 5 10 1 1 0 0 1\n"
+  "footprint=C\n"
+  "}\n";
+
+/* Check the value of an attribute, and free it */
+static void
+assert_value (gchar *value, const gchar *expected)
+{
+  g_assert_cmpstr (value, ==, expected);
+  g_free (value);
+}
+
+/* Find the text object starting with a prefix in a list */
+static OBJECT*
+find_text (const GList *objects, const gchar *prefix)
+{
+  const GList *iter;
+
+  for (iter = objects; iter != NULL; iter = g_list_next (iter)) {
+    OBJECT *object = iter->data;
+
+    if (object->type == OBJ_TEXT &&
+        g_str_has_prefix (object->text->string, prefix)) {
+      return object;
+    }
+  }
+
+  return NULL;
+}
+
+void
+check_search ()
+{
+  TOPLEVEL *toplevel = s_toplevel_new ();
+  GError *err = NULL;
+  GList *objects;
+  OBJECT *complex;
+  OBJECT *pin;
+
+  objects = o_read_buffer (toplevel, NULL, (char *) schematic_data, -1,
+                           "test", &err);
+  g_assert_no_error (err);
+
+  complex = objects->data;
+  g_assert_cmpint (complex->type, ==, OBJ_COMPLEX);
+
+  /* Attached attributes come before inherited ones */
+  assert_value (o_attrib_search_object_attribs_by_name (complex, "footprint", 0), "C");
+  assert_value (o_attrib_search_object_attribs_by_name (complex, "footprint", 1), "A");
+  assert_value (o_attrib_search_object_attribs_by_name (complex, "footprint", 2), "B");
+  assert_value (o_attrib_search_object_attribs_by_name (complex, "footprint", 3), NULL);
+  assert_value (o_attrib_search_object_attribs_by_name (complex, "device", 0), "RESISTOR");
+  assert_value (o_attrib_search_object_attribs_by_name (complex, "missing", 0), NULL);
+
+  assert_value (o_attrib_search_attached_attribs_by_name (complex, "footprint", 0), "C");
+  assert_value (o_attrib_search_attached_attribs_by_name (complex, "footprint", 1), NULL);
+  assert_value (o_attrib_search_attached_attribs_by_name (complex, "device", 0), NULL);
+
+  assert_value (o_attrib_search_inherited_attribs_by_name (complex, "footprint", 0), "A");
+  assert_value (o_attrib_search_inherited_attribs_by_name (complex, "footprint", 1), "B");
+  assert_value (o_attrib_search_inherited_attribs_by_name (complex, "refdes", 0), NULL);
+
+  /* Attributes attached to a pin inside are not inherited */
+  assert_value (o_attrib_search_object_attribs_by_name (complex, "pinnumber", 0), NULL);
+
+  pin = complex->complex->prim_objs->data;
+  g_assert_cmpint (pin->type, ==, OBJ_PIN);
+  assert_value (o_attrib_search_object_attribs_by_name (pin, "pinnumber", 0), "1");
+
+  geda_object_list_delete (toplevel, objects);
+  s_toplevel_delete (toplevel);
+}
+
+void
+check_changes ()
+{
+  TOPLEVEL *toplevel = s_toplevel_new ();
+  GError *err = NULL;
+  GList *objects;
+  OBJECT *complex;
+  OBJECT *pin;
+  OBJECT *attrib;
+
+  objects = o_read_buffer (toplevel, NULL, (char *) schematic_data, -1,
+                           "test", &err);
+  g_assert_no_error (err);
+
+  complex = objects->data;
+  pin = complex->complex->prim_objs->data;
+
+  assert_value (o_attrib_search_object_attribs_by_name (complex, "refdes", 0), "R1");
+  assert_value (o_attrib_search_object_attribs_by_name (pin, "pinnumber", 0), "1");
+
+  /* Changing the text of an attribute */
+  attrib = find_text (complex->attribs, "refdes=");
+  o_text_set_string (toplevel, attrib, "refdes=R2");
+  assert_value (o_attrib_search_object_attribs_by_name (complex, "refdes", 0), "R2");
+
+  o_text_set_string (toplevel, attrib, "refdes = R3");
+  assert_value (o_attrib_search_object_attribs_by_name (complex, "refdes", 0), NULL);
+
+  /* Detaching an attribute */
+  attrib = find_text (complex->attribs, "footprint=");
+  o_attrib_remove (toplevel, &complex->attribs, attrib);
+  assert_value (o_attrib_search_attached_attribs_by_name (complex, "footprint", 0), NULL);
+  assert_value (o_attrib_search_object_attribs_by_name (complex, "footprint", 0), "A");
+
+  /* Attaching it again */
+  o_attrib_attach (toplevel, attrib, complex, FALSE);
+  assert_value (o_attrib_search_object_attribs_by_name (complex, "footprint", 0), "C");
+
+  /* Attaching an inherited attribute to a pin inside */
+  attrib = find_text (complex->complex->prim_objs, "device=");
+  o_attrib_attach (toplevel, attrib, pin, FALSE);
+  assert_value (o_attrib_search_object_attribs_by_name (complex, "device", 0), NULL);
+  assert_value (o_attrib_search_object_attribs_by_name (pin, "device", 0), "RESISTOR");
+
+  /* Detaching all attributes of the pin makes it inherited again */
+  o_attrib_detach_all (toplevel, pin);
+  assert_value (o_attrib_search_object_attribs_by_name (pin, "pinnumber", 0), NULL);
+  assert_value (o_attrib_search_object_attribs_by_name (complex, "device", 0), "RESISTOR");
+  assert_value (o_attrib_search_object_attribs_by_name (complex, "pinnumber", 0), "1");
+
+  geda_object_list_delete (toplevel, objects);
+  s_toplevel_delete (toplevel);
+}
+
+static void
+main_prog (void *closure, int argc, char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  libgeda_init ();
+
+  g_test_add_func ("/geda/libgeda/attrib/search",
+                   check_search);
+  g_test_add_func ("/geda/libgeda/attrib/changes",
+                   check_changes);
+
+  exit (g_test_run ());
+}
+
+int
+main (int argc, char *argv[])
+{
+  scm_boot_guile (argc, argv, main_prog, NULL);
+  return 0;
+}
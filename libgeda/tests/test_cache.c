@@ -0,0 +1,182 @@
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <string.h>
+#include <libgeda.h>
+
+#include "test_helpers.h"
+
+static const gchar *symbol_data =
+  "v 20130925 2\n"
+  "P 0 0 300 0 1 0 0\n"
+  "{\n"
+  "T 200 50 5 8 1 1 0 0 1\n"
+  "pinnumber=1\n"
+  "}\n"
+  "B 300 -100 400 200 3 0 0 0 -1 -1 0 -1 -1 -1 -1 -1\n"
+  "T 300 200 8 10 0 0 0 0 1\n"
+  "device=TEST\n";
+
+static const gchar *schematic_data =
+  "v 20130925 2\n"
+  "N 100 200 500 200 4\n"
+  "U 0 0 0 1000 10 -1\n"
+  "P 0 0 300 0 1 0 0\n"
+  "L 0 0 100 100 3 10 0 2 50 25\n"
+  "B 0 0 1000 500 3 0 0 0 -1 -1 2 10 45 100 -1 -1\n"
+  "V 500 500 200 3 0 0 0 -1 -1 0 -1 -1 -1 -1 -1\n"
+  "A 0 0 300 0 90 3 0 0 0 -1 -1\n"
+  "H 3 0 0 0 -1 -1 1 -1 -1 -1 -1 -1 3\n"
+  "M 0,0\n"
+  "L 100,100\n"
+  "z\n"
+  "T 100 100 5 10 1 1 0 0 2\n"
+  "first line\n"
+  "second line\n"
+  "C 1000 1000 1 90 0 EMBEDDEDresistor.sym\n"
+  "[\n"
+  "P 0 0 0 100 1 0 1\n"
+  "{\n"
+  "T 0 50 5 8 0 1 0 0 1\n"
+  "pinnumber=1\n"
+  "}\n"
+  "B 0 0 100 300 3 0 0 0 -1 -1 0 -1 -1 -1 -1 -1\n"
+  "]\n"
+  "{\n"
+  "T 1000 1100 5 10 1 1 0 0 1\n"
+  "refdes=R1\n"
+  "}\n"
+  "C 2000 2000 1 0 1 cache_test.sym\n"
+  "{\n"
+  "T 2000 2100 5 10 1 1 0 0 1\n"
+  "refdes=U1\n"
+  "}\n";
+
+/* The name of the cache file for a file containing data */
+static gchar*
+cache_filename (const gchar *data)
+{
+  gchar *checksum = g_compute_checksum_for_string (G_CHECKSUM_MD5, data, -1);
+  gchar *basename = g_strconcat (checksum, ".bin", NULL);
+  gchar *filename = g_build_filename (eda_get_user_cache_dir (), "objects",
+                                      basename, NULL);
+
+  g_free (basename);
+  g_free (checksum);
+  return filename;
+}
+
+/* Read a file and save the objects again */
+static gchar*
+read_file (TOPLEVEL *toplevel, const gchar *filename)
+{
+  GError *err = NULL;
+  GList *objects;
+  gchar *result;
+
+  objects = o_read (toplevel, NULL, (gchar*) filename, &err);
+  g_assert_no_error (err);
+  g_assert (objects != NULL);
+
+  result = geda_object_list_to_buffer (objects);
+  geda_object_list_delete (toplevel, objects);
+
+  return result;
+}
+
+void
+check_object_cache ()
+{
+  TOPLEVEL *toplevel = s_toplevel_new ();
+  gchar *directory = test_make_tmp_dir ("test_cache_XXXXXX");
+  gchar *symbol = g_build_filename (directory, "cache_test.sym", NULL);
+  gchar *schematic = g_build_filename (directory, "test.sch", NULL);
+  gchar *other = g_build_filename (directory, "other.sch", NULL);
+  gchar *other_data = g_strconcat (schematic_data, "N 0 0 0 100 4\n", NULL);
+  gchar *cache = cache_filename (schematic_data);
+  gchar *other_cache = cache_filename (other_data);
+  gchar *contents;
+  gchar *expected;
+  gchar *result;
+  gsize length;
+
+  i_vars_libgeda_set (toplevel);
+
+  g_assert (g_file_set_contents (symbol, symbol_data, -1, NULL));
+  g_assert (g_file_set_contents (schematic, schematic_data, -1, NULL));
+  g_assert (g_file_set_contents (other, other_data, -1, NULL));
+  s_clib_add_directory (directory, NULL);
+
+  /* The first read parses the text and writes the cache file */
+  g_assert (!g_file_test (cache, G_FILE_TEST_EXISTS));
+  expected = read_file (toplevel, schematic);
+  g_assert (g_file_test (cache, G_FILE_TEST_EXISTS));
+
+  /* The second read gives the same objects from the cache file */
+  result = read_file (toplevel, schematic);
+  g_assert_cmpstr (result, ==, expected);
+  g_free (result);
+
+  /* The cache file is used instead of parsing the text */
+  result = read_file (toplevel, other);
+  g_assert (g_file_get_contents (other_cache, &contents, &length, NULL));
+  g_assert (g_file_set_contents (cache, contents, length, NULL));
+  g_free (contents);
+  g_free (result);
+
+  result = read_file (toplevel, schematic);
+  g_assert_cmpstr (result, !=, expected);
+  g_free (result);
+
+  /* A damaged cache file is ignored and written again */
+  g_assert (g_file_set_contents (cache, "gEDA object cache\n", -1, NULL));
+  result = read_file (toplevel, schematic);
+  g_assert_cmpstr (result, ==, expected);
+  g_free (result);
+
+  result = read_file (toplevel, schematic);
+  g_assert_cmpstr (result, ==, expected);
+  g_free (result);
+
+  g_unlink (cache);
+  g_unlink (other_cache);
+  g_unlink (symbol);
+  g_unlink (schematic);
+  g_unlink (other);
+  g_rmdir (directory);
+
+  g_free (expected);
+  g_free (other_cache);
+  g_free (cache);
+  g_free (other_data);
+  g_free (other);
+  g_free (schematic);
+  g_free (symbol);
+  g_free (directory);
+  s_toplevel_delete (toplevel);
+}
+
+static void
+main_prog (void *closure, int argc, char *argv[])
+{
+  gchar *cache_dir = test_make_tmp_dir ("test_cache_cache_XXXXXX");
+
+  g_test_init (&argc, &argv, NULL);
+
+  /* Keep cache files out of the user's cache directory */
+  g_setenv ("XDG_CACHE_HOME", cache_dir, TRUE);
+
+  libgeda_init ();
+  scm_c_eval_string ("(object-cache \"enabled\")");
+
+  g_test_add_func ("/geda/libgeda/cache/object_cache",
+                   check_object_cache);
+
+  exit (g_test_run ());
+}
+
+int
+main (int argc, char *argv[])
+{
+  scm_boot_guile (argc, argv, main_prog, NULL);
+  return 0;
+}
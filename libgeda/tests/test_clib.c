@@ -0,0 +1,379 @@
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <string.h>
+#include <utime.h>
+#include <libgeda.h>
+
+#include "test_helpers.h"
+
+#define N_SYMBOLS 50
+
+/* The contents of each symbol file */
+static gchar*
+symbol_contents (gint index)
+{
+  GString *data = g_string_new ("v 20130925 2\n");
+  gint line;
+
+  for (line = 0; line < 20; line++) {
+    g_string_append_printf (data, "L %d 0 %d 100 3 0 0 0 -1 -1\n",
+                            100 * line, 100 * line);
+  }
+
+  return g_string_free (data, FALSE);
+}
+
+static gchar*
+make_symbol_directory ()
+{
+  return test_make_symbol_directory ("test_clib_XXXXXX", N_SYMBOLS,
+                                     symbol_contents);
+}
+
+static void
+remove_symbol_directory (gchar *directory)
+{
+  test_remove_symbol_directory (directory, N_SYMBOLS);
+}
+
+void
+check_symbol_cache ()
+{
+  gchar *directory = make_symbol_directory ();
+  const CLibSource *source;
+  CLibCacheStats before;
+  CLibCacheStats after;
+  GList *symbols;
+  GList *iter;
+  gint pass;
+
+  source = s_clib_add_directory (directory, "test");
+  symbols = s_clib_source_get_symbols (source);
+  g_assert_cmpint (g_list_length (symbols), ==, N_SYMBOLS);
+
+  s_clib_set_symbol_cache_size (16 * 1024);
+  s_clib_get_symbol_cache_stats (&before);
+
+  for (pass = 0; pass < 2; pass++) {
+    for (iter = symbols; iter != NULL; iter = g_list_next (iter)) {
+      CLibSymbol *symbol = (CLibSymbol*) iter->data;
+      gchar *filename = s_clib_symbol_get_filename (symbol);
+      gchar *expected;
+      gchar *data;
+
+      g_assert (g_file_get_contents (filename, &expected, NULL, NULL));
+
+      /* The second request for a symbol is answered from the cache */
+      data = s_clib_symbol_get_data (symbol);
+      g_assert_cmpstr (data, ==, expected);
+      g_free (data);
+      data = s_clib_symbol_get_data (symbol);
+      g_assert_cmpstr (data, ==, expected);
+      g_free (data);
+
+      g_free (expected);
+      g_free (filename);
+    }
+  }
+
+  s_clib_get_symbol_cache_stats (&after);
+
+  g_assert_cmpint (after.hits - before.hits, ==, 2 * N_SYMBOLS);
+  g_assert_cmpint (after.misses - before.misses, ==, 2 * N_SYMBOLS);
+  g_assert_cmpint (after.evictions, >, before.evictions);
+  g_assert_cmpint (after.size, <=, after.budget);
+  g_assert_cmpint (after.entries, <, N_SYMBOLS);
+
+  /* Shrinking the cache evicts all but the most recently used symbol */
+  s_clib_set_symbol_cache_size (1);
+  s_clib_get_symbol_cache_stats (&after);
+  g_assert_cmpint (after.entries, ==, 1);
+
+  s_clib_flush_symbol_cache ();
+  s_clib_get_symbol_cache_stats (&after);
+  g_assert_cmpint (after.entries, ==, 0);
+  g_assert_cmpint (after.size, ==, 0);
+
+  g_list_free (symbols);
+  remove_symbol_directory (directory);
+}
+
+#define N_INNER 10
+
+void
+check_nested_symbols ()
+{
+  TOPLEVEL *toplevel = s_toplevel_new ();
+  gchar *directory = test_make_tmp_dir ("test_clib_XXXXXX");
+  GString *outer = g_string_new ("v 20130925 2\n");
+  const CLibSymbol *symbol;
+  CLibCacheStats stats;
+  gchar *filename;
+  gint count;
+  gint pass;
+
+  i_vars_libgeda_set (toplevel);
+
+  /* A symbol placing several other symbols */
+  for (count = 0; count < N_INNER; count++) {
+    gchar *basename = g_strdup_printf ("nested_inner%d.sym", count);
+
+    filename = g_build_filename (directory, basename, NULL);
+    g_assert (g_file_set_contents (filename,
+                                   "v 20130925 2\n"
+                                   "L 0 0 100 100 3 0 0 0 -1 -1\n"
+                                   "L 0 100 100 0 3 0 0 0 -1 -1\n",
+                                   -1, NULL));
+    g_string_append_printf (outer, "C %d 0 1 0 0 %s\n", 1000 * count, basename);
+
+    g_free (filename);
+    g_free (basename);
+  }
+  g_string_append (outer, "L 0 0 100 100 3 0 0 0 -1 -1\n");
+
+  filename = g_build_filename (directory, "nested_outer.sym", NULL);
+  g_assert (g_file_set_contents (filename, outer->str, -1, NULL));
+  g_free (filename);
+
+  s_clib_add_directory (directory, NULL);
+  symbol = s_clib_get_symbol_by_name ("nested_outer.sym");
+  g_assert (symbol != NULL);
+
+  /* Placing the inner symbols evicts everything else from a cache this
+   * small, but not the symbol being parsed */
+  s_clib_get_symbol_cache_stats (&stats);
+  s_clib_set_symbol_cache_size (1);
+
+  for (pass = 0; pass < 2; pass++) {
+    OBJECT *object = o_complex_new (toplevel, OBJ_COMPLEX, DEFAULT_COLOR,
+                                    0, 0, 0, 0, symbol, NULL, TRUE);
+    GList *iter;
+
+    g_assert_cmpint (g_list_length (object->complex->prim_objs), ==, N_INNER + 1);
+
+    for (iter = object->complex->prim_objs, count = 0;
+         count < N_INNER;
+         iter = g_list_next (iter), count++) {
+      OBJECT *inner = (OBJECT*) iter->data;
+
+      g_assert_cmpint (inner->type, ==, OBJ_COMPLEX);
+      g_assert_cmpint (g_list_length (inner->complex->prim_objs), ==, 2);
+    }
+
+    s_delete_object (toplevel, object);
+  }
+
+  s_clib_set_symbol_cache_size (stats.budget);
+
+  for (count = 0; count < N_INNER; count++) {
+    gchar *basename = g_strdup_printf ("nested_inner%d.sym", count);
+
+    filename = g_build_filename (directory, basename, NULL);
+    g_unlink (filename);
+    g_free (filename);
+    g_free (basename);
+  }
+  filename = g_build_filename (directory, "nested_outer.sym", NULL);
+  g_unlink (filename);
+  g_free (filename);
+  g_rmdir (directory);
+
+  g_string_free (outer, TRUE);
+  g_free (directory);
+  s_toplevel_delete (toplevel);
+}
+
+/* Set the modification time of a directory to some time in the past */
+static void
+set_directory_mtime (const gchar *directory, time_t mtime)
+{
+  struct utimbuf times;
+
+  times.actime = mtime;
+  times.modtime = mtime;
+
+  g_assert (g_utime (directory, &times) == 0);
+}
+
+void
+check_directory_index ()
+{
+  gchar *directory = make_symbol_directory ();
+  gchar *extra = g_build_filename (directory, "extra.sym", NULL);
+  time_t mtime = time (NULL) - 3600;
+  const CLibSource *source;
+  GList *symbols;
+
+  set_directory_mtime (directory, mtime);
+
+  /* The first scan writes the index */
+  source = s_clib_add_directory (directory, NULL);
+  symbols = s_clib_source_get_symbols (source);
+  g_assert_cmpint (g_list_length (symbols), ==, N_SYMBOLS);
+  g_list_free (symbols);
+
+  /* A change which leaves the directory time alone is not noticed,
+   * which shows that the index is used */
+  g_assert (g_file_set_contents (extra, "v 20130925 2\n", -1, NULL));
+  set_directory_mtime (directory, mtime);
+
+  s_clib_refresh ();
+  symbols = s_clib_source_get_symbols (source);
+  g_assert_cmpint (g_list_length (symbols), ==, N_SYMBOLS);
+  g_assert_cmpstr (s_clib_symbol_get_name (symbols->data), ==,
+                   "symbol0.sym");
+  g_list_free (symbols);
+
+  /* Once the directory changes, it is scanned again */
+  set_directory_mtime (directory, mtime + 1);
+
+  s_clib_refresh ();
+  symbols = s_clib_source_get_symbols (source);
+  g_assert_cmpint (g_list_length (symbols), ==, N_SYMBOLS + 1);
+  g_list_free (symbols);
+
+  g_unlink (extra);
+  g_free (extra);
+  remove_symbol_directory (directory);
+}
+
+void
+check_directory_scan ()
+{
+  gchar *directories[4];
+  const CLibSource *sources[4];
+  GList *symbols;
+  GList *iter;
+  gint i;
+
+  /* These may be scanned concurrently */
+  for (i = 0; i < 4; i++) {
+    directories[i] = make_symbol_directory ();
+    sources[i] = s_clib_add_directory (directories[i], NULL);
+  }
+
+  for (i = 0; i < 4; i++) {
+    symbols = s_clib_source_get_symbols (sources[i]);
+    g_assert_cmpint (g_list_length (symbols), ==, N_SYMBOLS);
+    g_list_free (symbols);
+  }
+
+  /* Sources added later are searched first */
+  symbols = s_clib_search ("symbol7.sym", CLIB_EXACT);
+  g_assert_cmpint (g_list_length (symbols), ==, 4);
+  for (iter = symbols, i = 3; iter != NULL; iter = g_list_next (iter), i--) {
+    g_assert (s_clib_symbol_get_source (iter->data) == sources[i]);
+  }
+  g_list_free (symbols);
+
+  symbols = s_clib_search ("symbol7", CLIB_EXACT);
+  g_assert (symbols == NULL);
+
+  s_clib_refresh ();
+
+  symbols = s_clib_search ("symbol1*.sym", CLIB_GLOB);
+  g_assert_cmpint (g_list_length (symbols), ==, 4 * 11);
+  g_list_free (symbols);
+
+  for (i = 0; i < 4; i++) {
+    remove_symbol_directory (directories[i]);
+  }
+}
+
+/* Find the symbols containing a string by testing every symbol */
+static GList*
+search_substring_slow (const gchar *text)
+{
+  gchar *lower = g_ascii_strdown (text, -1);
+  GList *sources = s_clib_get_sources (FALSE);
+  GList *result = NULL;
+  GList *iter1;
+  GList *iter2;
+
+  for (iter1 = sources; iter1 != NULL; iter1 = g_list_next (iter1)) {
+    GList *symbols = s_clib_source_get_symbols (iter1->data);
+
+    for (iter2 = symbols; iter2 != NULL; iter2 = g_list_next (iter2)) {
+      gchar *name = g_ascii_strdown (s_clib_symbol_get_name (iter2->data), -1);
+
+      if (strstr (name, lower) != NULL) {
+        result = g_list_append (result, iter2->data);
+      }
+      g_free (name);
+    }
+    g_list_free (symbols);
+  }
+
+  g_list_free (sources);
+  g_free (lower);
+  return result;
+}
+
+void
+check_substring_search ()
+{
+  const gchar *patterns[] = { "mbol1", "SYM", "l4", "7.s", "Bol33.", "y",
+                              "symbol", "zzz", "sym.", NULL };
+  gchar *directories[2];
+  gint i;
+
+  for (i = 0; i < 2; i++) {
+    directories[i] = make_symbol_directory ();
+    s_clib_add_directory (directories[i], NULL);
+  }
+
+  for (i = 0; patterns[i] != NULL; i++) {
+    GList *expected = search_substring_slow (patterns[i]);
+    GList *result = s_clib_search (patterns[i], CLIB_SUBSTRING);
+    GList *iter1;
+    GList *iter2;
+
+    g_assert_cmpint (g_list_length (result), ==, g_list_length (expected));
+
+    for (iter1 = expected, iter2 = result;
+         iter1 != NULL && iter2 != NULL;
+         iter1 = g_list_next (iter1), iter2 = g_list_next (iter2)) {
+      g_assert (iter1->data == iter2->data);
+    }
+
+    g_list_free (expected);
+    g_list_free (result);
+  }
+
+  for (i = 0; i < 2; i++) {
+    remove_symbol_directory (directories[i]);
+  }
+}
+
+static void
+main_prog (void *closure, int argc, char *argv[])
+{
+  gchar *cache_dir = test_make_tmp_dir ("test_clib_cache_XXXXXX");
+
+  g_test_init (&argc, &argv, NULL);
+
+  /* Keep index files out of the user's cache directory */
+  g_setenv ("XDG_CACHE_HOME", cache_dir, TRUE);
+
+  libgeda_init ();
+
+  g_test_add_func ("/geda/libgeda/clib/symbol_cache",
+                   check_symbol_cache);
+  g_test_add_func ("/geda/libgeda/clib/nested_symbols",
+                   check_nested_symbols);
+  g_test_add_func ("/geda/libgeda/clib/directory_index",
+                   check_directory_index);
+  g_test_add_func ("/geda/libgeda/clib/directory_scan",
+                   check_directory_scan);
+  g_test_add_func ("/geda/libgeda/clib/substring_search",
+                   check_substring_search);
+
+  exit (g_test_run ());
+}
+
+int
+main (int argc, char *argv[])
+{
+  scm_boot_guile (argc, argv, main_prog, NULL);
+  return 0;
+}
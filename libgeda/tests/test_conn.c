@@ -0,0 +1,352 @@
+#include <glib.h>
+#include <libgeda.h>
+
+/* Check if a point lies strictly between the ends of an orthogonal net */
+static gboolean
+is_midpoint (OBJECT *object, gint x, gint y)
+{
+  gint x0 = object->line->x[0];
+  gint y0 = object->line->y[0];
+  gint x1 = object->line->x[1];
+  gint y1 = object->line->y[1];
+
+  if (x0 == x1 && x0 == x && y > MIN (y0, y1) && y < MAX (y0, y1)) {
+    return TRUE;
+  }
+
+  return (y0 == y1 && y0 == y && x > MIN (x0, x1) && x < MAX (x0, x1));
+}
+
+/* Find the connections of an object by testing every other net */
+static GArray*
+connections_slow (GList *nets, OBJECT *object)
+{
+  GArray *expected = g_array_new (FALSE, FALSE, sizeof (CONN));
+  GList *iter;
+  gint i, j, k;
+
+  for (iter = nets; iter != NULL; iter = g_list_next (iter)) {
+    OBJECT *other = (OBJECT*) iter->data;
+    CONN found[8];
+    gint n_found = 0;
+
+    if (other == object) {
+      continue;
+    }
+
+    for (j = 0; j < 2; j++) {
+      for (k = 0; k < 2; k++) {
+        if (object->line->x[j] == other->line->x[k] &&
+            object->line->y[j] == other->line->y[k]) {
+          found[n_found].type = CONN_ENDPOINT;
+          found[n_found].x = other->line->x[k];
+          found[n_found].y = other->line->y[k];
+          n_found++;
+        }
+      }
+    }
+
+    for (k = 0; k < 2; k++) {
+      if (is_midpoint (other, object->line->x[k], object->line->y[k])) {
+        found[n_found].type = CONN_MIDPOINT;
+        found[n_found].x = object->line->x[k];
+        found[n_found].y = object->line->y[k];
+        n_found++;
+      }
+      if (is_midpoint (object, other->line->x[k], other->line->y[k])) {
+        found[n_found].type = CONN_MIDPOINT;
+        found[n_found].x = other->line->x[k];
+        found[n_found].y = other->line->y[k];
+        n_found++;
+      }
+    }
+
+    for (j = 0; j < n_found; j++) {
+      gboolean unique = TRUE;
+
+      found[j].other_object = other;
+
+      for (i = 0; i < expected->len; i++) {
+        CONN *conn = &g_array_index (expected, CONN, i);
+        if (conn->other_object == other && conn->type == found[j].type &&
+            conn->x == found[j].x && conn->y == found[j].y) {
+          unique = FALSE;
+        }
+      }
+
+      if (unique) {
+        g_array_append_val (expected, found[j]);
+      }
+    }
+  }
+
+  return expected;
+}
+
+/* Check the connections of an object against those of a full scan */
+static void
+check_object_connections (GList *nets, OBJECT *object)
+{
+  GArray *expected = connections_slow (nets, object);
+  GList *c_iter;
+
+  g_assert_cmpint (g_list_length (object->conn_list), ==, expected->len);
+
+  for (c_iter = object->conn_list; c_iter != NULL; c_iter = g_list_next (c_iter)) {
+    CONN *conn = (CONN*) c_iter->data;
+    gboolean found = FALSE;
+    gint i;
+
+    for (i = 0; i < expected->len; i++) {
+      CONN *e = &g_array_index (expected, CONN, i);
+      if (conn->other_object == e->other_object && conn->type == e->type &&
+          conn->x == e->x && conn->y == e->y) {
+        found = TRUE;
+      }
+    }
+
+    g_assert (found);
+  }
+
+  g_array_free (expected, TRUE);
+}
+
+static void
+check_connections (GList *nets)
+{
+  GList *iter;
+
+  for (iter = nets; iter != NULL; iter = g_list_next (iter)) {
+    check_object_connections (nets, (OBJECT*) iter->data);
+  }
+}
+
+static OBJECT*
+random_net (TOPLEVEL *toplevel)
+{
+  gint x0 = 100 * g_test_rand_int_range (0, 20);
+  gint y0 = 100 * g_test_rand_int_range (0, 20);
+  gint length = 100 * g_test_rand_int_range (0, 6);
+
+  if (g_test_rand_bit ()) {
+    return geda_net_object_new (toplevel, OBJ_NET, NET_COLOR,
+                                x0, y0, x0 + length, y0);
+  } else {
+    return geda_net_object_new (toplevel, OBJ_NET, NET_COLOR,
+                                x0, y0, x0, y0 + length);
+  }
+}
+
+void
+check_net_connections ()
+{
+  gint count;
+  TOPLEVEL *toplevel = s_toplevel_new ();
+  PAGE *page;
+  GList *nets = NULL;
+  GList *iter;
+
+  i_vars_libgeda_set (toplevel);
+  page = s_page_new (toplevel, "test.sch");
+
+  for (count = 0; count < 300; count++) {
+    OBJECT *object = random_net (toplevel);
+
+    s_page_append (toplevel, page, object);
+    nets = g_list_prepend (nets, object);
+  }
+
+  check_connections (nets);
+
+  /* move nets around the way gschem does */
+  for (iter = nets, count = 0; iter != NULL; iter = g_list_next (iter), count++) {
+    if (count % 3 == 0) {
+      OBJECT *object = (OBJECT*) iter->data;
+
+      s_conn_remove_object_connections (toplevel, object);
+      geda_object_translate (object,
+                             100 * g_test_rand_int_range (-3, 3),
+                             100 * g_test_rand_int_range (-3, 3));
+      s_conn_update_object (page, object);
+    }
+  }
+
+  check_connections (nets);
+
+  /* remove some of the nets */
+  for (iter = nets, count = 0; iter != NULL; count++) {
+    GList *next = g_list_next (iter);
+
+    if (count % 5 == 0) {
+      OBJECT *object = (OBJECT*) iter->data;
+
+      s_page_remove (toplevel, page, object);
+      s_delete_object (toplevel, object);
+      nets = g_list_delete_link (nets, iter);
+    }
+
+    iter = next;
+  }
+
+  check_connections (nets);
+
+  g_list_free (nets);
+  s_toplevel_delete (toplevel);
+}
+
+void
+check_moved_connections ()
+{
+  gint count;
+  TOPLEVEL *toplevel = s_toplevel_new ();
+  PAGE *page;
+  GList *nets = NULL;
+  GList *added = NULL;
+  GList *iter;
+
+  i_vars_libgeda_set (toplevel);
+  page = s_page_new (toplevel, "test.sch");
+
+  for (count = 0; count < 200; count++) {
+    OBJECT *object = random_net (toplevel);
+
+    s_page_append (toplevel, page, object);
+    nets = g_list_prepend (nets, object);
+  }
+
+  /* move nets around the way the Scheme API does, without updating
+   * the connections */
+  for (iter = nets, count = 0; iter != NULL; iter = g_list_next (iter), count++) {
+    if (count % 2 == 0) {
+      OBJECT *object = (OBJECT*) iter->data;
+
+      o_emit_pre_change_notify (toplevel, object);
+      geda_object_translate (object,
+                             100 * g_test_rand_int_range (-3, 3),
+                             100 * g_test_rand_int_range (-3, 3));
+      o_emit_change_notify (toplevel, object);
+    }
+  }
+
+  /* nets added later connect to the moved nets where they are now */
+  for (count = 0; count < 200; count++) {
+    OBJECT *object = random_net (toplevel);
+
+    s_page_append (toplevel, page, object);
+    nets = g_list_prepend (nets, object);
+    added = g_list_prepend (added, object);
+  }
+
+  for (iter = added; iter != NULL; iter = g_list_next (iter)) {
+    check_object_connections (nets, (OBJECT*) iter->data);
+  }
+
+  g_list_free (added);
+  g_list_free (nets);
+  s_toplevel_delete (toplevel);
+}
+
+void
+check_stale_midpoints ()
+{
+  TOPLEVEL *toplevel = s_toplevel_new ();
+  PAGE *page;
+  OBJECT *horizontal;
+  OBJECT *vertical;
+  OBJECT *object;
+
+  i_vars_libgeda_set (toplevel);
+  page = s_page_new (toplevel, "test.sch");
+
+  horizontal = geda_net_object_new (toplevel, OBJ_NET, NET_COLOR,
+                                    0, 0, 400, 0);
+  vertical = geda_net_object_new (toplevel, OBJ_NET, NET_COLOR,
+                                  1000, 0, 1000, 400);
+  s_page_append (toplevel, page, horizontal);
+  s_page_append (toplevel, page, vertical);
+
+  /* change the geometry behind the connection index's back */
+  horizontal->line->y[0] = horizontal->line->y[1] = 1000;
+  vertical->line->x[0] = vertical->line->x[1] = 2000;
+
+  /* a net ending where the middle of the horizontal net was */
+  object = geda_net_object_new (toplevel, OBJ_NET, NET_COLOR,
+                                200, 0, 200, -300);
+  s_page_append (toplevel, page, object);
+  g_assert (object->conn_list == NULL);
+
+  /* a net passing where the end of the vertical net was */
+  object = geda_net_object_new (toplevel, OBJ_NET, NET_COLOR,
+                                800, 0, 1200, 0);
+  s_page_append (toplevel, page, object);
+  g_assert (object->conn_list == NULL);
+
+  s_toplevel_delete (toplevel);
+}
+
+/* The connectible objects are listed in the order they were added */
+static void
+check_connectible_order (PAGE *page)
+{
+  const GList *objects = s_page_objects (page);
+  GList *iter;
+
+  for (iter = page->connectible_list; iter != NULL; iter = g_list_next (iter)) {
+    g_assert (objects != NULL);
+    g_assert (iter->data == objects->data);
+    objects = g_list_next (objects);
+  }
+  g_assert (objects == NULL);
+}
+
+void
+check_bulk_connections ()
+{
+  gint count;
+  TOPLEVEL *toplevel = s_toplevel_new ();
+  PAGE *page;
+  OBJECT *object;
+  GList *nets = NULL;
+
+  i_vars_libgeda_set (toplevel);
+  page = s_page_new (toplevel, "test.sch");
+
+  for (count = 0; count < 100; count++) {
+    s_page_append (toplevel, page, random_net (toplevel));
+  }
+
+  for (count = 0; count < 300; count++) {
+    nets = g_list_prepend (nets, random_net (toplevel));
+  }
+
+  s_page_append_list (toplevel, page, nets);
+
+  check_connections ((GList*) s_page_objects (page));
+  check_connectible_order (page);
+
+  /* Removing the last object leaves the others in order */
+  object = g_list_last ((GList*) s_page_objects (page))->data;
+  s_page_remove (toplevel, page, object);
+  s_delete_object (toplevel, object);
+  s_page_append (toplevel, page, random_net (toplevel));
+  check_connectible_order (page);
+
+  s_toplevel_delete (toplevel);
+}
+
+int
+main (int argc, char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/geda/libgeda/conn/net_connections",
+                   check_net_connections);
+  g_test_add_func ("/geda/libgeda/conn/moved_connections",
+                   check_moved_connections);
+  g_test_add_func ("/geda/libgeda/conn/stale_midpoints",
+                   check_stale_midpoints);
+  g_test_add_func ("/geda/libgeda/conn/bulk_connections",
+                   check_bulk_connections);
+
+  return g_test_run ();
+}
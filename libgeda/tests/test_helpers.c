@@ -0,0 +1,75 @@
+/* Helpers shared by the libgeda tests */
+
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <unistd.h>
+
+#include "test_helpers.h"
+
+/* Create a new directory in the temporary directory, named after tmpl
+ * with its trailing XXXXXX replaced.  g_dir_make_tmp() and g_mkdtemp()
+ * are newer than the GLib version required by configure. */
+gchar*
+test_make_tmp_dir (const gchar *tmpl)
+{
+  gchar *directory;
+
+#if GLIB_CHECK_VERSION(2,26,0)
+  directory = g_build_filename (g_get_tmp_dir (), tmpl, NULL);
+  g_assert (g_mkdtemp (directory) != NULL);
+#else
+  gint fd = g_file_open_tmp (tmpl, &directory, NULL);
+
+  /* Reserve a unique name with a file, then put the directory there */
+  g_assert (fd != -1);
+  close (fd);
+  g_unlink (directory);
+  g_assert (g_mkdir (directory, 0700) == 0);
+#endif
+
+  return directory;
+}
+
+/* Create a directory containing n_symbols symbol files called
+ * symbolN.sym, each with the contents returned for N */
+gchar*
+test_make_symbol_directory (const gchar *tmpl, gint n_symbols,
+                            TestSymbolFunc contents)
+{
+  gchar *directory = test_make_tmp_dir (tmpl);
+  gint count;
+
+  for (count = 0; count < n_symbols; count++) {
+    gchar *basename = g_strdup_printf ("symbol%d.sym", count);
+    gchar *filename = g_build_filename (directory, basename, NULL);
+    gchar *data = contents (count);
+
+    g_assert (g_file_set_contents (filename, data, -1, NULL));
+
+    g_free (data);
+    g_free (filename);
+    g_free (basename);
+  }
+
+  return directory;
+}
+
+/* Remove and free a directory made by test_make_symbol_directory() */
+void
+test_remove_symbol_directory (gchar *directory, gint n_symbols)
+{
+  gint count;
+
+  for (count = 0; count < n_symbols; count++) {
+    gchar *basename = g_strdup_printf ("symbol%d.sym", count);
+    gchar *filename = g_build_filename (directory, basename, NULL);
+
+    g_unlink (filename);
+
+    g_free (filename);
+    g_free (basename);
+  }
+
+  g_rmdir (directory);
+  g_free (directory);
+}
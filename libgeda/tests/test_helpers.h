@@ -0,0 +1,16 @@
+/* Helpers shared by the libgeda tests */
+
+#ifndef TEST_HELPERS_H
+#define TEST_HELPERS_H
+
+#include <glib.h>
+
+/* Returns the contents of the symbol file with the given index */
+typedef gchar *(*TestSymbolFunc) (gint index);
+
+gchar *test_make_tmp_dir (const gchar *tmpl);
+gchar *test_make_symbol_directory (const gchar *tmpl, gint n_symbols,
+                                   TestSymbolFunc contents);
+void test_remove_symbol_directory (gchar *directory, gint n_symbols);
+
+#endif /* TEST_HELPERS_H */
@@ -93,6 +93,12 @@ check_accessors ()
     g_assert_cmpint (y1, ==, geda_net_object_get_y1 (object0));
     g_assert_cmpint (color, ==, geda_object_get_color (object0));
 
+    gchar *name = geda_object_get_name (object0);
+    gchar *expected = g_strdup_printf ("net.%d", object0->sid);
+    g_assert_cmpstr (name, ==, expected);
+    g_free (expected);
+    g_free (name);
+
     s_delete_object (toplevel, object0);
   }
 
@@ -0,0 +1,229 @@
+#include <glib.h>
+#include <libgeda.h>
+
+/* Find the objects in a region by testing every object on the page */
+static GList*
+objects_in_region_slow (TOPLEVEL *toplevel, PAGE *page, BOX *rect)
+{
+  const GList *iter;
+  GList *list = NULL;
+
+  for (iter = s_page_objects (page); iter != NULL; iter = g_list_next (iter)) {
+    OBJECT *object = (OBJECT*) iter->data;
+    gint left, top, right, bottom;
+
+    if (geda_object_calculate_visible_bounds (toplevel, object,
+                                              &left, &top, &right, &bottom) &&
+        right  >= rect->lower_x &&
+        left   <= rect->upper_x &&
+        top    <= rect->upper_y &&
+        bottom >= rect->lower_y) {
+      list = g_list_append (list, object);
+    }
+  }
+
+  return list;
+}
+
+static void
+check_region_queries (TOPLEVEL *toplevel, PAGE *page)
+{
+  gint count;
+
+  for (count = 0; count < 200; count++) {
+    BOX rect;
+    GList *expected;
+    GList *result;
+    GList *iter1;
+    GList *iter2;
+    gint x = g_test_rand_int_range (-10000, 110000);
+    gint y = g_test_rand_int_range (-10000, 90000);
+
+    rect.lower_x = x;
+    rect.lower_y = y;
+    rect.upper_x = x + g_test_rand_int_range (0, 20000);
+    rect.upper_y = y + g_test_rand_int_range (0, 20000);
+
+    expected = objects_in_region_slow (toplevel, page, &rect);
+    result = s_page_objects_in_region (toplevel, page,
+                                       rect.lower_x, rect.lower_y,
+                                       rect.upper_x, rect.upper_y);
+
+    g_assert_cmpint (g_list_length (result), ==, g_list_length (expected));
+
+    /* the result is in page order */
+    for (iter1 = expected, iter2 = result;
+         iter1 != NULL && iter2 != NULL;
+         iter1 = g_list_next (iter1), iter2 = g_list_next (iter2)) {
+      g_assert (iter1->data == iter2->data);
+    }
+
+    g_list_free (expected);
+    g_list_free (result);
+  }
+}
+
+void
+check_objects_in_region ()
+{
+  gint count;
+  TOPLEVEL *toplevel = s_toplevel_new ();
+  PAGE *page;
+  GList *objects = NULL;
+  GList *iter;
+
+  i_vars_libgeda_set (toplevel);
+  page = s_page_new (toplevel, "test.sch");
+
+  for (count = 0; count < 2000; count++) {
+    gint x0 = g_test_rand_int_range (0, 100000);
+    gint y0 = g_test_rand_int_range (0, 80000);
+    gint x1 = x0 + g_test_rand_int_range (-2000, 2000);
+    gint y1 = y0 + g_test_rand_int_range (-2000, 2000);
+    OBJECT *object;
+
+    if (count % 100 == 0) {
+      /* a few objects spanning large parts of the page */
+      object = geda_box_object_new (toplevel, OBJ_BOX, GRAPHIC_COLOR,
+                                    x0 / 4, y0 / 4, x0, y0);
+    } else if (count % 2 == 0) {
+      object = geda_box_object_new (toplevel, OBJ_BOX, GRAPHIC_COLOR,
+                                    x0, y0, x1, y1);
+    } else {
+      object = geda_line_object_new (toplevel, GRAPHIC_COLOR,
+                                     x0, y0, x1, y1);
+    }
+
+    s_page_append (toplevel, page, object);
+    objects = g_list_prepend (objects, object);
+  }
+
+  check_region_queries (toplevel, page);
+
+  /* move objects around after they have been indexed */
+  for (iter = objects, count = 0; iter != NULL; iter = g_list_next (iter), count++) {
+    if (count % 3 == 0) {
+      geda_object_translate ((OBJECT*) iter->data,
+                             g_test_rand_int_range (-20000, 20000),
+                             g_test_rand_int_range (-20000, 20000));
+    }
+  }
+
+  check_region_queries (toplevel, page);
+
+  /* remove some of the objects */
+  for (iter = objects, count = 0; iter != NULL; iter = g_list_next (iter), count++) {
+    if (count % 5 == 0) {
+      s_page_remove (toplevel, page, (OBJECT*) iter->data);
+      s_delete_object (toplevel, (OBJECT*) iter->data);
+    }
+  }
+
+  check_region_queries (toplevel, page);
+
+  g_list_free (objects);
+  s_toplevel_delete (toplevel);
+}
+
+static void
+check_object_links (PAGE *page, GList *expected)
+{
+  const GList *iter;
+
+  g_assert_cmpint (g_list_length ((GList*) s_page_objects (page)), ==,
+                   g_list_length (expected));
+
+  for (iter = s_page_objects (page); iter != NULL;
+       iter = g_list_next (iter), expected = g_list_next (expected)) {
+    g_assert (iter->data == expected->data);
+    g_assert (s_page_object_link (page, (OBJECT*) iter->data) == iter);
+  }
+}
+
+static OBJECT*
+new_box (TOPLEVEL *toplevel)
+{
+  gint x = g_test_rand_int_range (0, 100000);
+  gint y = g_test_rand_int_range (0, 80000);
+
+  return geda_box_object_new (toplevel, OBJ_BOX, GRAPHIC_COLOR,
+                              x, y, x + 100, y + 100);
+}
+
+void
+check_object_list ()
+{
+  gint count;
+  TOPLEVEL *toplevel = s_toplevel_new ();
+  PAGE *page;
+  GList *expected = NULL;
+  GList *list = NULL;
+  GList *iter;
+
+  i_vars_libgeda_set (toplevel);
+  page = s_page_new (toplevel, "test.sch");
+
+  for (count = 0; count < 500; count++) {
+    OBJECT *object = new_box (toplevel);
+    s_page_append (toplevel, page, object);
+    expected = g_list_append (expected, object);
+  }
+
+  for (count = 0; count < 500; count++) {
+    list = g_list_prepend (list, new_box (toplevel));
+  }
+  expected = g_list_concat (expected, g_list_copy (list));
+  s_page_append_list (toplevel, page, list);
+
+  check_object_links (page, expected);
+
+  /* remove objects, including the first and the last one */
+  for (iter = expected, count = 0; iter != NULL; count++) {
+    GList *next = g_list_next (iter);
+
+    if (count % 3 == 0 || next == NULL) {
+      s_page_remove (toplevel, page, (OBJECT*) iter->data);
+      s_delete_object (toplevel, (OBJECT*) iter->data);
+      expected = g_list_delete_link (expected, iter);
+    }
+
+    iter = next;
+  }
+
+  check_object_links (page, expected);
+
+  /* replace objects in place */
+  for (iter = expected, count = 0; iter != NULL; iter = g_list_next (iter), count++) {
+    if (count % 7 == 0 || g_list_next (iter) == NULL) {
+      OBJECT *object = new_box (toplevel);
+      s_page_replace (toplevel, page, (OBJECT*) iter->data, object);
+      s_delete_object (toplevel, (OBJECT*) iter->data);
+      iter->data = object;
+    }
+  }
+
+  /* appending after the last object was replaced */
+  for (count = 0; count < 10; count++) {
+    OBJECT *object = new_box (toplevel);
+    s_page_append (toplevel, page, object);
+    expected = g_list_append (expected, object);
+  }
+
+  check_object_links (page, expected);
+
+  g_list_free (expected);
+  s_toplevel_delete (toplevel);
+}
+
+int
+main (int argc, char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/geda/libgeda/page/objects_in_region",
+                   check_objects_in_region);
+  g_test_add_func ("/geda/libgeda/page/object_list",
+                   check_object_list);
+
+  return g_test_run ();
+}
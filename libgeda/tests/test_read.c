@@ -0,0 +1,587 @@
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <libgeda.h>
+#include <version.h>
+
+#include "test_helpers.h"
+
+static OBJECT*
+random_object (TOPLEVEL *toplevel)
+{
+  gint x = g_test_rand_int_range (-100000, 100000);
+  gint y = g_test_rand_int_range (-100000, 100000);
+  gint color = g_test_rand_int_range (0, MAX_COLORS);
+  OBJECT *object = NULL;
+  gchar *string;
+
+  switch (g_test_rand_int_range (0, 9)) {
+    case 0:
+      object = geda_net_object_new (toplevel, OBJ_NET, color,
+                                    x, y, x + 100, y);
+      break;
+    case 1:
+      object = geda_pin_object_new (toplevel, color, x, y, x, y + 300,
+                                    PIN_TYPE_NET, 0);
+      break;
+    case 2:
+      object = geda_line_object_new (toplevel, color, x, y,
+                                     -x, g_test_rand_int_range (-5, 5));
+      break;
+    case 3:
+      object = geda_box_object_new (toplevel, OBJ_BOX, color,
+                                    x, y, x + 1000, y - 500);
+      break;
+    case 4:
+      object = geda_circle_object_new (toplevel, color, x, y,
+                                       g_test_rand_int_range (1, 1000));
+      break;
+    case 5:
+      object = geda_arc_object_new (toplevel, color, x, y,
+                                    g_test_rand_int_range (1, 1000),
+                                    g_test_rand_int_range (0, 360),
+                                    g_test_rand_int_range (-360, 360));
+      break;
+    case 6:
+      object = geda_bus_object_new (toplevel, color, x, y, x, y - 700,
+                                    g_test_rand_int_range (-1, 2));
+      break;
+    case 7:
+      string = g_strdup_printf ("refdes=U%d", g_test_rand_int_range (0, 1000));
+      object = geda_text_object_new (toplevel, color, x, y, LOWER_LEFT, 90,
+                                     string, 10, VISIBLE, SHOW_NAME_VALUE);
+      g_free (string);
+      break;
+    case 8:
+      object = geda_text_object_new (toplevel, color, x, y, UPPER_RIGHT, 0,
+                                     "first line\nsecond line", 12,
+                                     INVISIBLE, SHOW_VALUE);
+      break;
+  }
+
+  return object;
+}
+
+static gchar*
+random_schematic (TOPLEVEL *toplevel, gint count)
+{
+  GList *objects = NULL;
+  gchar *buffer;
+  gint i;
+
+  for (i = 0; i < count; i++) {
+    objects = g_list_prepend (objects, random_object (toplevel));
+  }
+
+  buffer = geda_object_list_to_buffer (objects);
+  geda_object_list_delete (toplevel, objects);
+
+  return buffer;
+}
+
+/* Parse a buffer and save the objects again */
+static gchar*
+round_trip (TOPLEVEL *toplevel, const gchar *buffer)
+{
+  gchar *copy = g_strdup (buffer);
+  GError *err = NULL;
+  GList *objects;
+  gchar *result;
+
+  objects = o_read_buffer (toplevel, NULL, copy, -1, "test", &err);
+  g_assert_no_error (err);
+  g_assert (objects != NULL);
+
+  result = geda_object_list_to_buffer (objects);
+  geda_object_list_delete (toplevel, objects);
+  g_free (copy);
+
+  return result;
+}
+
+void
+check_read_buffer ()
+{
+  TOPLEVEL *toplevel = s_toplevel_new ();
+  gchar *buffer;
+  gchar *result;
+  gchar **lines;
+  gchar *crlf;
+
+  i_vars_libgeda_set (toplevel);
+
+  buffer = random_schematic (toplevel, 1000);
+
+  result = round_trip (toplevel, buffer);
+  g_assert_cmpstr (result, ==, buffer);
+  g_free (result);
+
+  /* DOS line endings are read the same way */
+  lines = g_strsplit (buffer, "\n", -1);
+  crlf = g_strjoinv ("\r\n", lines);
+  g_strfreev (lines);
+
+  result = round_trip (toplevel, crlf);
+  g_assert_cmpstr (result, ==, buffer);
+  g_free (result);
+  g_free (crlf);
+
+  g_free (buffer);
+  s_toplevel_delete (toplevel);
+}
+
+void
+check_read_file ()
+{
+  TOPLEVEL *toplevel = s_toplevel_new ();
+  gchar *filename;
+  gchar *buffer;
+  gchar *result;
+  GError *err = NULL;
+  GList *objects;
+  gint fd;
+
+  i_vars_libgeda_set (toplevel);
+
+  fd = g_file_open_tmp ("test_read_XXXXXX.sch", &filename, NULL);
+  g_assert (fd >= 0);
+  close (fd);
+
+  buffer = random_schematic (toplevel, 1000);
+  g_assert (g_file_set_contents (filename, buffer, -1, NULL));
+
+  objects = o_read (toplevel, NULL, filename, &err);
+  g_assert_no_error (err);
+
+  result = geda_object_list_to_buffer (objects);
+  g_assert_cmpstr (result, ==, buffer);
+  geda_object_list_delete (toplevel, objects);
+  g_free (result);
+
+  /* An empty file can't be mapped, but is still read */
+  g_assert (g_file_set_contents (filename, "", -1, NULL));
+  objects = o_read (toplevel, NULL, filename, &err);
+  g_assert_no_error (err);
+  g_assert (objects == NULL);
+
+  g_unlink (filename);
+  g_free (filename);
+  g_free (buffer);
+  s_toplevel_delete (toplevel);
+}
+
+/* Objects of every type in the current file format, as written by the
+ * object list writer before o_save() was changed to stream its output.
+ * It is preceded by the file format header. */
+static const gchar golden_objects[] =
+  "C 1000 1000 1 0 0 EMBEDDEDgolden.sym\n"
+  "[\n"
+  "P 1000 1000 1000 1300 1 0 0\n"
+  "{\n"
+  "T 1050 1100 5 8 0 1 0 0 1\n"
+  "pinnumber=1\n"
+  "}\n"
+  "B 900 1300 200 400 3 0 0 0 -1 -1 0 -1 -1 -1 -1 -1\n"
+  "]\n"
+  "{\n"
+  "T 1200 1400 8 10 1 1 0 0 1\n"
+  "refdes=U1\n"
+  "}\n"
+  "N 1000 1000 3000 1000 4\n"
+  "{\n"
+  "T 1500 1050 5 10 1 1 0 0 1\n"
+  "netname=golden\n"
+  "}\n"
+  "U 3000 500 3000 1500 10 -1\n"
+  "L 100 200 1100 -300 3 10 0 2 100 50\n"
+  "V 2000 2000 300 3 0 0 0 -1 -1 3 10 45 100 -1 -1\n"
+  "A 2500 2500 400 30 120 3 0 1 0 -1 -1\n"
+  "H 3 10 0 0 -1 -1 0 -1 -1 -1 -1 -1 4\n"
+  "M 100,100\n"
+  "L 500,100\n"
+  "C 600,200 600,300 500,400\n"
+  "z\n"
+  "T 500 600 5 12 0 1 90 3 2\n"
+  "first line\n"
+  "second line\n";
+
+void
+check_save_file ()
+{
+  TOPLEVEL *toplevel = s_toplevel_new ();
+  GString *expected;
+  GList *objects;
+  gchar *filename;
+  gchar *contents;
+  gchar *copy;
+  GError *err = NULL;
+  gint fd;
+  gint i;
+
+  i_vars_libgeda_set (toplevel);
+
+  fd = g_file_open_tmp ("test_save_XXXXXX.sch", &filename, NULL);
+  g_assert (fd >= 0);
+  close (fd);
+
+  /* Enough objects for the output to be written in several pieces */
+  expected = g_string_new (NULL);
+  g_string_printf (expected, "v %s %u\n", PACKAGE_DATE_VERSION,
+                   FILEFORMAT_VERSION);
+  for (i = 0; i < 200; i++) {
+    g_string_append (expected, golden_objects);
+  }
+
+  copy = g_strdup (expected->str);
+  objects = o_read_buffer (toplevel, NULL, copy, -1, "golden", &err);
+  g_assert_no_error (err);
+  g_free (copy);
+
+  g_assert (o_save (toplevel, objects, filename, &err));
+  g_assert_no_error (err);
+
+  g_assert (g_file_get_contents (filename, &contents, NULL, NULL));
+  g_assert_cmpstr (contents, ==, expected->str);
+  g_free (contents);
+
+  g_unlink (filename);
+  g_free (filename);
+  g_string_free (expected, TRUE);
+  geda_object_list_delete (toplevel, objects);
+  s_toplevel_delete (toplevel);
+}
+
+void
+check_open_pages ()
+{
+  TOPLEVEL *toplevel = s_toplevel_new ();
+  gchar *directory = test_make_tmp_dir ("test_open_XXXXXX");
+  gchar *filenames[6];
+  gchar *buffers[6];
+  GList *pages = NULL;
+  GList *objects;
+  GList *iter;
+  PAGE *failed_page;
+  PAGE *other;
+  GError *err = NULL;
+  gchar *result;
+  gint i;
+
+  i_vars_libgeda_set (toplevel);
+
+  for (i = 0; i < 6; i++) {
+    gchar *basename = g_strdup_printf ("page%d.sch", i);
+
+    filenames[i] = g_build_filename (directory, basename, NULL);
+    buffers[i] = random_schematic (toplevel, 100 * (i + 1));
+    g_assert (g_file_set_contents (filenames[i], buffers[i], -1, NULL));
+    pages = g_list_append (pages, s_page_new (toplevel, filenames[i]));
+
+    g_free (basename);
+  }
+
+  /* Each page gets the objects of its own file */
+  g_assert (f_open_pages (toplevel, pages, F_OPEN_RESTORE_CWD,
+                          &failed_page, &err));
+  g_assert_no_error (err);
+  g_assert (failed_page == NULL);
+
+  for (iter = pages, i = 0; iter != NULL; iter = g_list_next (iter), i++) {
+    result = geda_object_list_to_buffer (s_page_objects (iter->data));
+
+    g_assert_cmpstr (result, ==, buffers[i]);
+    g_free (result);
+  }
+
+  /* Objects moved to another page outlive the page they were read into */
+  other = s_page_new (toplevel, "other.sch");
+  objects = g_list_copy ((GList*) s_page_objects (pages->data));
+  for (iter = objects; iter != NULL; iter = g_list_next (iter)) {
+    s_page_remove (toplevel, pages->data, iter->data);
+  }
+  s_page_append_list (toplevel, other, objects);
+
+  for (iter = pages; iter != NULL; iter = g_list_next (iter)) {
+    s_page_delete (toplevel, iter->data);
+  }
+  g_list_free (pages);
+  pages = NULL;
+
+  result = geda_object_list_to_buffer (s_page_objects (other));
+  g_assert_cmpstr (result, ==, buffers[0]);
+  g_free (result);
+  s_page_delete (toplevel, other);
+
+  /* A missing file is reported, and the other files are still read */
+  g_unlink (filenames[2]);
+  g_unlink (filenames[4]);
+
+  for (i = 0; i < 6; i++) {
+    pages = g_list_append (pages, s_page_new (toplevel, filenames[i]));
+  }
+
+  g_assert (!f_open_pages (toplevel, pages, F_OPEN_RESTORE_CWD,
+                           &failed_page, &err));
+  g_assert (err != NULL);
+  g_assert (failed_page == g_list_nth_data (pages, 2));
+  g_clear_error (&err);
+
+  for (iter = pages, i = 0; iter != NULL; iter = g_list_next (iter), i++) {
+    result = geda_object_list_to_buffer (s_page_objects (iter->data));
+
+    if (i == 2 || i == 4) {
+      g_assert (s_page_objects (iter->data) == NULL);
+    } else {
+      g_assert_cmpstr (result, ==, buffers[i]);
+    }
+    g_free (result);
+  }
+  g_list_free (pages);
+
+  for (i = 0; i < 6; i++) {
+    g_unlink (filenames[i]);
+    g_free (filenames[i]);
+    g_free (buffers[i]);
+  }
+  g_rmdir (directory);
+  g_free (directory);
+  s_toplevel_delete (toplevel);
+}
+
+/* A 1x1 PNG image */
+static const gchar picture_png_base64[] =
+  "iVBORw0KGgoAAAANSUhEUgAAAAEAAAABCAYAAAAfFcSJAAAADUlEQVR4nGP4z8DwHwAFAAH/"
+  "iZk9HQAAAABJRU5ErkJggg==";
+
+void
+check_open_pages_directories ()
+{
+  TOPLEVEL *toplevel = s_toplevel_new ();
+  const gchar *schematic =
+    "v 20130925 2\n"
+    "G 0 0 100 100 0 0 0\n"
+    "picture.png\n";
+  gchar *directories[2];
+  gchar *filenames[2];
+  gchar *picture;
+  guchar *data;
+  gsize length;
+  GList *pages = NULL;
+  GList *iter;
+  GError *err = NULL;
+  size_t size;
+  gint i;
+
+  i_vars_libgeda_set (toplevel);
+
+  /* Both files refer to a picture next to them, which only exists in
+   * the directory of the first one */
+  for (i = 0; i < 2; i++) {
+    directories[i] = test_make_tmp_dir ("test_open_XXXXXX");
+    filenames[i] = g_build_filename (directories[i], "page.sch", NULL);
+    g_assert (g_file_set_contents (filenames[i], schematic, -1, NULL));
+    pages = g_list_append (pages, s_page_new (toplevel, filenames[i]));
+  }
+
+  picture = g_build_filename (directories[0], "picture.png", NULL);
+  data = g_base64_decode (picture_png_base64, &length);
+  g_assert (g_file_set_contents (picture, (gchar*) data, length, NULL));
+  g_free (data);
+
+  /* Each file is read relative to its own directory */
+  g_assert (f_open_pages (toplevel, pages, F_OPEN_RESTORE_CWD, NULL, &err));
+  g_assert_no_error (err);
+
+  for (iter = pages, i = 0; iter != NULL; iter = g_list_next (iter), i++) {
+    const GList *objects = s_page_objects (iter->data);
+
+    g_assert (objects != NULL);
+    g_assert ((o_picture_get_data (toplevel, objects->data, &size) != NULL)
+              == (i == 0));
+
+    s_page_delete (toplevel, iter->data);
+  }
+  g_list_free (pages);
+
+  g_unlink (picture);
+  g_free (picture);
+
+  for (i = 0; i < 2; i++) {
+    g_unlink (filenames[i]);
+    g_rmdir (directories[i]);
+    g_free (filenames[i]);
+    g_free (directories[i]);
+  }
+  s_toplevel_delete (toplevel);
+}
+
+void
+check_read_errors ()
+{
+  const gchar *bad[] = {
+    "v 20130925 2\nN 100 200 300\n",
+    "v 20130925 2\nN 100 200 300 x00 4\n",
+    "v 20130925 2\nL 100 200 300 400 3 0 0 0 -1\n",
+    "v 20130925 2\nC 100 200\n",
+    "v 20130925 2\nC 100 200 1 0 0\n",
+    NULL,
+  };
+  TOPLEVEL *toplevel = s_toplevel_new ();
+  gint i;
+
+  i_vars_libgeda_set (toplevel);
+
+  for (i = 0; bad[i] != NULL; i++) {
+    gchar *copy = g_strdup (bad[i]);
+    GError *err = NULL;
+
+    g_assert (o_read_buffer (toplevel, NULL, copy, -1, "test", &err) == NULL);
+    g_assert (err != NULL);
+
+    g_clear_error (&err);
+    g_free (copy);
+  }
+
+  s_toplevel_delete (toplevel);
+}
+
+/* Defined in libgeda, but not part of its public API */
+int o_read_scan_line (const char *line, const char **end, char *type,
+                      int count, ...);
+
+/* The fields of each type of object line in the current file format,
+ * with the format the readers used to pass to sscanf() for them */
+static const struct {
+  char type;
+  gint count;
+  const gchar *format;
+} line_formats[] = {
+  { OBJ_ARC, 11, "%c %d %d %d %d %d %d %d %d %d %d %d\n" },
+  { OBJ_BOX, 16, "%c %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n" },
+  { OBJ_BUS, 6, "%c %d %d %d %d %d %d\n" },
+  { OBJ_CIRCLE, 15, "%c %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n" },
+  { OBJ_LINE, 10, "%c %d %d %d %d %d %d %d %d %d %d\n" },
+  { OBJ_NET, 5, "%c %d %d %d %d %d\n" },
+  { OBJ_PIN, 7, "%c %d %d %d %d %d %d %d\n" },
+  { OBJ_TEXT, 9, "%c %d %d %d %d %d %d %d %d %d\n" },
+  { 0, 0, NULL },
+};
+
+static gint
+find_line_format (const gchar *line)
+{
+  gint i;
+
+  for (i = 0; line_formats[i].type != 0; i++) {
+    if (line[0] == line_formats[i].type) return i;
+  }
+
+  return -1;
+}
+
+/* Extract the fields of every object line of a buffer, either with
+ * sscanf() as the readers used to, or with o_read_scan_line().  Both
+ * ways walk the same lines and store the same fields; the sum of the
+ * fields is returned so the results can be compared. */
+static gint64
+scan_lines (const gchar *buffer, gboolean use_sscanf)
+{
+  TextBuffer *tb = s_textbuffer_new (buffer, -1);
+  const gchar *line;
+  gint values[16];
+  gint64 total = 0;
+  char type;
+  gint n;
+  gint i;
+
+  while ((line = s_textbuffer_next_line (tb)) != NULL) {
+    i = find_line_format (line);
+    if (i < 0) continue;
+
+    if (use_sscanf) {
+      n = sscanf (line, line_formats[i].format,
+                  &type, &values[0], &values[1], &values[2], &values[3],
+                  &values[4], &values[5], &values[6], &values[7],
+                  &values[8], &values[9], &values[10], &values[11],
+                  &values[12], &values[13], &values[14], &values[15]);
+    } else {
+      n = o_read_scan_line (line, NULL, &type, line_formats[i].count,
+                            &values[0], &values[1], &values[2], &values[3],
+                            &values[4], &values[5], &values[6], &values[7],
+                            &values[8], &values[9], &values[10], &values[11],
+                            &values[12], &values[13], &values[14], &values[15]);
+    }
+    g_assert_cmpint (n, ==, line_formats[i].count + 1);
+
+    while (--n > 0) {
+      total += values[n - 1];
+    }
+  }
+
+  s_textbuffer_free (tb);
+  return total;
+}
+
+void
+check_read_performance ()
+{
+  TOPLEVEL *toplevel = s_toplevel_new ();
+  GTimer *timer = g_timer_new ();
+  gchar *buffer;
+  gdouble size;
+  gdouble elapsed;
+  gint64 expected;
+  gint64 result;
+
+  i_vars_libgeda_set (toplevel);
+
+  buffer = random_schematic (toplevel, 200000);
+  size = strlen (buffer) / (1024.0 * 1024.0);
+
+  /* The way the object readers used to extract the fields */
+  g_timer_start (timer);
+  expected = scan_lines (buffer, TRUE);
+  elapsed = g_timer_elapsed (timer, NULL);
+  g_test_message ("sscanf(): %.3f s, %.1f MB/s", elapsed, size / elapsed);
+
+  g_timer_start (timer);
+  result = scan_lines (buffer, FALSE);
+  elapsed = g_timer_elapsed (timer, NULL);
+  g_test_minimized_result (elapsed, "o_read_scan_line(): %.3f s, %.1f MB/s",
+                           elapsed, size / elapsed);
+
+  g_assert_cmpint (result, ==, expected);
+
+  g_free (buffer);
+  g_timer_destroy (timer);
+  s_toplevel_delete (toplevel);
+}
+
+int
+main (int argc, char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/geda/libgeda/read/read_buffer",
+                   check_read_buffer);
+  g_test_add_func ("/geda/libgeda/read/read_file",
+                   check_read_file);
+  g_test_add_func ("/geda/libgeda/read/save_file",
+                   check_save_file);
+  g_test_add_func ("/geda/libgeda/read/open_pages",
+                   check_open_pages);
+  g_test_add_func ("/geda/libgeda/read/open_pages_directories",
+                   check_open_pages_directories);
+  g_test_add_func ("/geda/libgeda/read/read_errors",
+                   check_read_errors);
+
+  /* Run with "-m perf" */
+  if (g_test_perf ()) {
+    g_test_add_func ("/geda/libgeda/read/performance",
+                     check_read_performance);
+  }
+
+  return g_test_run ();
+}
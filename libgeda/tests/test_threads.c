@@ -0,0 +1,209 @@
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <string.h>
+#include <libgeda.h>
+
+#include "test_helpers.h"
+
+#define N_SYMBOLS 8
+#define N_THREADS 8
+#define N_READS 20
+
+/* The result of one worker thread */
+typedef struct {
+  TOPLEVEL *toplevel;
+  const gchar *schematic;
+  gchar *results[N_READS];
+  GList *objects;
+} ReadJob;
+
+/* The contents of each symbol file, which places the one before it */
+static gchar*
+symbol_contents (gint index)
+{
+  GString *data = g_string_new ("v 20130925 2\n");
+  gint line;
+
+  for (line = 0; line <= index; line++) {
+    g_string_append_printf (data,
+                            "P %d 0 %d 300 1 0 0\n"
+                            "{\n"
+                            "T %d 100 5 8 0 1 0 0 1\n"
+                            "pinnumber=%d\n"
+                            "}\n",
+                            100 * line, 100 * line, 100 * line, line + 1);
+  }
+  g_string_append_printf (data, "T 0 400 8 10 0 0 0 0 1\n"
+                          "device=DEVICE%d\n", index);
+
+  /* Symbols placing other symbols are copied with their contents */
+  if (index > 0) {
+    g_string_append_printf (data, "C 0 500 1 0 0 symbol%d.sym\n",
+                            index - 1);
+  }
+
+  return g_string_free (data, FALSE);
+}
+
+/* A schematic placing each symbol many times */
+static gchar*
+make_schematic ()
+{
+  GString *data = g_string_new ("v 20130925 2\n");
+  gint count;
+
+  for (count = 0; count < 400; count++) {
+    g_string_append_printf (data,
+                            "C %d %d 1 %d %d symbol%d.sym\n"
+                            "{\n"
+                            "T %d %d 5 10 1 1 0 0 1\n"
+                            "refdes=U%d\n"
+                            "}\n"
+                            "N %d %d %d %d 4\n",
+                            100 * count, 200 * count, 90 * (count % 4),
+                            count % 2, count % N_SYMBOLS,
+                            100 * count, 200 * count + 100, count,
+                            100 * count, 0, 100 * count, 1000);
+  }
+
+  return g_string_free (data, FALSE);
+}
+
+/* Parse a buffer and save the objects again */
+static gchar*
+read_schematic (TOPLEVEL *toplevel, const gchar *schematic, GList **objects)
+{
+  gchar *copy = g_strdup (schematic);
+  GError *err = NULL;
+  GList *list;
+  gchar *result;
+
+  list = o_read_buffer (toplevel, NULL, copy, -1, "test", &err);
+  g_assert_no_error (err);
+  g_assert (list != NULL);
+  g_free (copy);
+
+  result = geda_object_list_to_buffer (list);
+
+  if (objects != NULL) {
+    *objects = g_list_concat (*objects, list);
+  } else {
+    geda_object_list_delete (toplevel, list);
+  }
+
+  return result;
+}
+
+static void
+read_worker (gpointer data, gpointer user_data)
+{
+  ReadJob *job = data;
+  gint i;
+
+  for (i = 0; i < N_READS; i++) {
+    /* Keep the objects of the last read, to check their sids */
+    job->results[i] = read_schematic (job->toplevel, job->schematic,
+                                      (i == N_READS - 1) ? &job->objects
+                                                         : NULL);
+  }
+}
+
+/* Add the sids of a list of objects and their contents to a set */
+static void
+collect_sids (GHashTable *sids, const GList *objects)
+{
+  const GList *iter;
+
+  for (iter = objects; iter != NULL; iter = g_list_next (iter)) {
+    OBJECT *object = (OBJECT*) iter->data;
+
+    g_assert (g_hash_table_lookup (sids, GINT_TO_POINTER (object->sid)) == NULL);
+    g_hash_table_insert (sids, GINT_TO_POINTER (object->sid), object);
+
+    if (object->type == OBJ_COMPLEX) {
+      collect_sids (sids, object->complex->prim_objs);
+    }
+  }
+}
+
+void
+check_concurrent_reads ()
+{
+  TOPLEVEL *toplevel = s_toplevel_new ();
+  gchar *directory =
+    test_make_symbol_directory ("test_threads_XXXXXX", N_SYMBOLS,
+                                symbol_contents);
+  gchar *schematic = make_schematic ();
+  GHashTable *sids = g_hash_table_new (g_direct_hash, g_direct_equal);
+  ReadJob jobs[N_THREADS];
+  GThreadPool *pool;
+  gchar *expected;
+  gint i;
+  gint j;
+
+  i_vars_libgeda_set (toplevel);
+  s_clib_add_directory (directory, NULL);
+
+  expected = read_schematic (toplevel, schematic, NULL);
+
+  /* A small cache makes the threads evict each other's symbols */
+  s_clib_set_symbol_cache_size (2 * 1024);
+  s_clib_flush_symbol_cache ();
+
+  pool = g_thread_pool_new (read_worker, NULL, N_THREADS, FALSE, NULL);
+  g_assert (pool != NULL);
+
+  for (i = 0; i < N_THREADS; i++) {
+    memset (&jobs[i], 0, sizeof (ReadJob));
+    jobs[i].toplevel = toplevel;
+    jobs[i].schematic = schematic;
+    g_thread_pool_push (pool, &jobs[i], NULL);
+  }
+
+  g_thread_pool_free (pool, FALSE, TRUE);
+
+  for (i = 0; i < N_THREADS; i++) {
+    for (j = 0; j < N_READS; j++) {
+      g_assert_cmpstr (jobs[i].results[j], ==, expected);
+      g_free (jobs[i].results[j]);
+    }
+
+    /* Every object got its own sid */
+    collect_sids (sids, jobs[i].objects);
+    geda_object_list_delete (toplevel, jobs[i].objects);
+  }
+
+  g_hash_table_destroy (sids);
+  g_free (expected);
+  g_free (schematic);
+  test_remove_symbol_directory (directory, N_SYMBOLS);
+  s_toplevel_delete (toplevel);
+}
+
+static void
+main_prog (void *closure, int argc, char *argv[])
+{
+  gchar *cache_dir = test_make_tmp_dir ("test_threads_cache_XXXXXX");
+
+  g_test_init (&argc, &argv, NULL);
+
+  /* Keep index files out of the user's cache directory */
+  g_setenv ("XDG_CACHE_HOME", cache_dir, TRUE);
+
+  libgeda_init ();
+
+  /* Without threads, there is nothing to test */
+  if (g_thread_supported ()) {
+    g_test_add_func ("/geda/libgeda/threads/concurrent_reads",
+                     check_concurrent_reads);
+  }
+
+  exit (g_test_run ());
+}
+
+int
+main (int argc, char *argv[])
+{
+  scm_boot_guile (argc, argv, main_prog, NULL);
+  return 0;
+}